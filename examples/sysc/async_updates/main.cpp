@@ -0,0 +1,289 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Stress test of async_request_update() from host threads.
+
+              A number of producer host threads post requests to counter
+              channels, round robin, each post calling
+              async_request_update() on the channel.  The simulation is
+              suspended until updates arrive, and a method counts the
+              requests received by the channels, stopping the simulation
+              once all of them have been received.  Pending updates of a
+              channel are coalesced, so that the number of update() calls
+              depends on the timing of the host threads; it is printed
+              with the wall time if arguments are given.
+
+              Usage: async_updates [requests [producers [channels]]]
+
+              Without host thread support, the requests are posted from
+              the simulation thread.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <atomic>
+# include <chrono>
+# include <thread>
+# define ASYNC_UPDATES_THREADS
+#elif defined(__GNUC__) && !defined(_WIN32) && !defined(WIN32)
+# include <pthread.h>
+# define ASYNC_UPDATES_THREADS
+#endif
+
+using namespace sc_core;
+
+static int requests = 10000; // per producer
+static int producers = 4;
+static int channels = 8;
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+    static const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start ).count();
+#else
+    return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+// a counter incremented by the host threads
+
+class shared_counter
+{
+public:
+    shared_counter() : m_value( 0 ) {}
+
+#if SC_CPLUSPLUS >= 201103L
+    void increment() { ++m_value; }
+    unsigned long get() const { return m_value.load(); }
+private:
+    std::atomic<unsigned long> m_value;
+#elif defined(ASYNC_UPDATES_THREADS)
+    void increment() { __sync_fetch_and_add( &m_value, 1ul ); }
+    unsigned long get() const { return __sync_fetch_and_add( &m_value, 0ul ); }
+private:
+    mutable unsigned long m_value;
+#else
+    void increment() { ++m_value; }
+    unsigned long get() const { return m_value; }
+private:
+    unsigned long m_value;
+#endif
+};
+
+// counts the requests posted to it, safe to post to from any host thread
+
+class counter_channel : public sc_prim_channel
+{
+public:
+    explicit counter_channel( const char* name_ )
+      : sc_prim_channel( name_ ), m_posted(), m_received( 0 ), m_updates( 0 )
+      , m_event( ( std::string( name_ ) + "_event" ).c_str() )
+    {
+        // keep the simulation alive while waiting for requests
+        async_attach_suspending();
+    }
+
+    void post()
+    {
+        m_posted.increment();
+        async_request_update();
+    }
+
+    unsigned long received() const { return m_received; }
+    unsigned long updates() const { return m_updates; }
+    const sc_event& default_event() const { return m_event; }
+
+private:
+    virtual void update()
+    {
+        ++m_updates;
+        unsigned long posted = m_posted.get();
+        if( posted != m_received ) {
+            m_received = posted;
+            m_event.notify( SC_ZERO_TIME );
+        }
+    }
+
+private:
+    shared_counter m_posted;
+    unsigned long  m_received;
+    unsigned long  m_updates;
+    sc_event       m_event;
+};
+
+SC_MODULE(sink)
+{
+    std::vector<counter_channel*> chans;
+    unsigned long                 expected;
+
+    SC_HAS_PROCESS(sink);
+    explicit sink( sc_module_name )
+      : chans(), expected( static_cast<unsigned long>( requests ) * producers )
+    {
+        for( int i = 0; i < channels; ++i )
+            chans.push_back( new counter_channel(
+                sc_gen_unique_name( "counter" ) ) );
+
+        SC_METHOD(count);
+        for( int i = 0; i < channels; ++i )
+            sensitive << chans[i]->default_event();
+        dont_initialize();
+    }
+
+    ~sink()
+    {
+        for( int i = 0; i < channels; ++i )
+            delete chans[i];
+    }
+
+    unsigned long received() const
+    {
+        unsigned long result = 0;
+        for( int i = 0; i < channels; ++i )
+            result += chans[i]->received();
+        return result;
+    }
+
+    unsigned long updates() const
+    {
+        unsigned long result = 0;
+        for( int i = 0; i < channels; ++i )
+            result += chans[i]->updates();
+        return result;
+    }
+
+    void count()
+    {
+        if( received() == expected )
+            sc_stop();
+    }
+
+    // producer p posts its requests to the channels, starting at channel p
+    void produce( int p )
+    {
+        for( int i = 0; i < requests; ++i )
+            chans[ ( p + i ) % channels ]->post();
+    }
+
+#if SC_CPLUSPLUS >= 201103L
+    void start_of_simulation()
+    {
+        for( int p = 0; p < producers; ++p )
+            threads.push_back( std::thread( [this, p] { produce( p ); } ) );
+    }
+
+    void join()
+    {
+        for( std::size_t p = 0; p < threads.size(); ++p )
+            threads[p].join();
+    }
+
+    std::vector<std::thread> threads;
+#elif defined(ASYNC_UPDATES_THREADS)
+    struct producer_arg
+    {
+        sink* top;
+        int   p;
+    };
+
+    static void* run_producer( void* arg )
+    {
+        producer_arg* a = static_cast<producer_arg*>( arg );
+        a->top->produce( a->p );
+        return 0;
+    }
+
+    void start_of_simulation()
+    {
+        args.resize( producers );
+        threads.resize( producers );
+        for( int p = 0; p < producers; ++p ) {
+            args[p].top = this;
+            args[p].p = p;
+            pthread_create( &threads[p], 0, &run_producer, &args[p] );
+        }
+    }
+
+    void join()
+    {
+        for( std::size_t p = 0; p < threads.size(); ++p )
+            pthread_join( threads[p], 0 );
+    }
+
+    std::vector<producer_arg> args;
+    std::vector<pthread_t>    threads;
+#else
+    void start_of_simulation()
+    {
+        // no threading support, post directly
+        for( int p = 0; p < producers; ++p )
+            produce( p );
+    }
+
+    void join() {}
+#endif
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    if( argc > 1 )
+        requests = std::atoi( argv[1] );
+    if( argc > 2 )
+        producers = std::atoi( argv[2] );
+    if( argc > 3 )
+        channels = std::atoi( argv[3] );
+
+    sink top( "top" );
+
+    double t_start = elapsed_seconds();
+    sc_start();
+    double t_end = elapsed_seconds();
+    top.join();
+
+    std::cout << "producers  : " << producers << "\n"
+              << "channels   : " << channels << "\n"
+              << "requests   : " << top.expected << "\n"
+              << "received   : " << top.received() << "\n"
+              << "time       : " << sc_time_stamp() << std::endl;
+    for( int i = 0; i < channels; ++i ) {
+        std::cout << top.chans[i]->name() << " : "
+                  << top.chans[i]->received() << "\n";
+    }
+
+    if( argc > 1 ) {
+        std::cout << "updates    : " << top.updates() << "\n"
+                  << "simulation : " << t_end - t_start << " s\n"
+                  << "rate       : " << top.expected / ( t_end - t_start )
+                  << " requests/s" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Wide fixed-width arithmetic datapath.
+
+              A multiply-accumulate and a mix of logic and shift operations
+              on sc_biguint<128>, sc_bigint<256> and sc_biguint<384>
+              values.  All operands and temporaries fit into the digits
+              kept inside the objects, so the datapath runs without heap
+              allocations.  With an argument, the given number of cycles
+              is simulated and the cpu time is printed.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+using namespace sc_core;
+using namespace sc_dt;
+
+SC_MODULE(datapath)
+{
+    sc_in<bool> clk;
+
+    int               cycles;
+    int               count;
+    sc_biguint<128>   a;
+    sc_bigint<256>    b;
+    sc_biguint<384>   acc;
+    sc_bigint<256>    mix;
+
+    SC_CTOR(datapath)
+      : cycles(20000), count(0)
+      , a( "0x0123456789abcdef0fedcba987654321" )
+      , b( "0x5a5a5a5a5a5a5a5a3c3c3c3c3c3c3c3c" )
+      , acc( 0 ), mix( 1 )
+    {
+        b = -b;
+
+        SC_METHOD(step);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void step()
+    {
+        // multiply-accumulate, truncated to 384 bits
+        acc = acc * 3 + a * b + ( acc >> 17 );
+
+        // logic and shifts on 256 bits
+        mix = ( mix << 5 ) ^ ( mix >> 3 ) ^ b;
+        mix = mix + ( a & sc_biguint<128>( acc.range( 127, 0 ) ) );
+
+        // new operands
+        a = a * 0x9e3779b9u + 0x7f4a7c15u;
+        b = -( b + sc_bigint<256>( a ) ) / 3;
+
+        if( ++count == cycles )
+            sc_stop();
+    }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    sc_clock clk( "clk", 10, SC_NS );
+    datapath dp( "dp" );
+    dp.clk( clk );
+    if( argc > 1 )
+        dp.cycles = std::atoi( argv[1] );
+
+    std::clock_t start = std::clock();
+    sc_start();
+    double seconds = static_cast<double>( std::clock() - start ) / CLOCKS_PER_SEC;
+
+    std::cout << "cycles     : " << dp.count << "\n"
+              << "acc[63:0]  : " << dp.acc.range( 63, 0 ).to_string( SC_HEX ) << "\n"
+              << "mix[63:0]  : " << dp.mix.range( 63, 0 ).to_string( SC_HEX ) << "\n"
+              << "time       : " << sc_time_stamp() << std::endl;
+
+    if( argc > 1 )
+        std::cout << "cpu time   : " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Throughput of sc_biguint<W> arithmetic.
+
+              Adds, multiplies, divides and shifts pseudo-random values
+              of 64 to 4096 bits and prints a checksum of the results for
+              each width.  With an argument, each operation is repeated
+              the given number of times and the throughput in million
+              operations per cpu second is printed as well (a division
+              computes the quotient and the remainder).  Compare a
+              library built with and without --enable-64bit-limbs.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+using namespace sc_dt;
+
+static const int NVALUES = 16;
+
+static unsigned lcg_state = 12345u;
+
+static unsigned lcg_next()
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state;
+}
+
+template< int W >
+static void random_fill( sc_biguint<W>& v )
+{
+    v = 0;
+    for( int i = 0; i < W; i += 16 )
+        v = ( v << 16 ) | ( lcg_next() >> 16 );
+}
+
+class stopwatch
+{
+public:
+    stopwatch() : m_start( std::clock() ) {}
+    double mops( int n ) const
+    {
+        double s = static_cast<double>( std::clock() - m_start ) / CLOCKS_PER_SEC;
+        return s > 0 ? n / s * 1e-6 : 0;
+    }
+private:
+    std::clock_t m_start;
+};
+
+template< int W >
+static void run( int iterations, bool timed )
+{
+    sc_biguint<W> a[NVALUES];
+    sc_biguint<W> b[NVALUES];
+    for( int i = 0; i < NVALUES; ++i ) {
+        random_fill( a[i] );
+        random_fill( b[i] );
+        b[i] >>= i;             // divisors of different lengths
+        if( b[i] == 0 )
+            b[i] = 1;
+    }
+
+    unsigned      checksum = 0;
+    sc_biguint<W> sum;
+    sc_biguint<2*W> prod;
+    sc_biguint<W> quot;
+    sc_biguint<W> shift;
+    double        mops[4];
+
+    stopwatch t_add;
+    for( int i = 0; i < iterations; ++i ) {
+        sum = a[i % NVALUES] + b[( i + 1 ) % NVALUES];
+        checksum ^= sum.range( 31, 0 ).to_uint();
+    }
+    mops[0] = t_add.mops( iterations );
+
+    stopwatch t_mul;
+    for( int i = 0; i < iterations; ++i ) {
+        prod = a[i % NVALUES] * b[( i + 3 ) % NVALUES];
+        checksum ^= prod.range( W + 31, W ).to_uint();
+    }
+    mops[1] = t_mul.mops( iterations );
+
+    stopwatch t_div;
+    for( int i = 0; i < iterations; ++i ) {
+        prod = a[i % NVALUES];
+        prod = ( prod << W ) | a[( i + 5 ) % NVALUES];
+        quot = prod / b[( i + 7 ) % NVALUES];
+        checksum ^= quot.range( 31, 0 ).to_uint();
+        quot = prod % b[( i + 7 ) % NVALUES];
+        checksum ^= quot.range( 31, 0 ).to_uint();
+    }
+    mops[2] = t_div.mops( iterations );
+
+    stopwatch t_shift;
+    for( int i = 0; i < iterations; ++i ) {
+        shift = ( a[i % NVALUES] << ( i % 61 ) ) ^ ( b[i % NVALUES] >> 7 );
+        checksum ^= shift.range( W - 1, W - 32 ).to_uint();
+    }
+    mops[3] = t_shift.mops( iterations );
+
+    std::cout << std::setw( 5 ) << W << "  " << std::hex << std::setfill( '0' )
+              << std::setw( 8 ) << checksum
+              << std::dec << std::setfill( ' ' );
+    if( timed ) {
+        std::cout << std::fixed << std::setprecision( 3 );
+        for( int i = 0; i < 4; ++i )
+            std::cout << std::setw( 10 ) << mops[i];
+    }
+    std::cout << std::endl;
+}
+
+int sc_main( int argc, char* argv[] )
+{
+    int iterations = 200;
+    bool timed = argc > 1;
+    if( timed )
+        iterations = std::atoi( argv[1] );
+
+    std::cout << "width  checksum";
+    if( timed )
+        std::cout << "  add/Mops  mul/Mops  div/Mops  shl/Mops";
+    std::cout << std::endl;
+
+    run<64>( iterations, timed );
+    run<128>( iterations, timed );
+    run<256>( iterations, timed );
+    run<512>( iterations, timed );
+    run<1024>( iterations, timed );
+    run<2048>( iterations, timed );
+    run<4096>( iterations, timed );
+    return 0;
+}
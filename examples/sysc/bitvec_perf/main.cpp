@@ -0,0 +1,174 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Throughput of sc_lv<W> and sc_bv<W> operations.
+
+              Applies the bitwise operators, shifts and reductions to
+              pseudo-random vectors of 64 to 8192 bits (logic vectors
+              with some X and Z bits) and prints a checksum of the
+              results for each type and width.  With an argument, each
+              operation is repeated the given number of times and the
+              throughput in million operations per cpu second is printed
+              as well.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+using namespace sc_dt;
+
+static const int NVALUES = 8;
+static const int NOPS    = 7;
+
+static unsigned lcg_state = 12345u;
+
+static unsigned lcg_next()
+{
+    lcg_state = lcg_state * 1664525u + 1013904223u;
+    return lcg_state ^ ( lcg_state >> 15 );
+}
+
+// kind 0: all ones, 1: all ones and one X, 2: all zeros and one Z,
+// otherwise random (with X and Z bits in logic vectors)
+
+template< class T >
+static void fill( T& v, int kind, bool logic )
+{
+    int len = v.length();
+    for( int i = 0; i < v.size(); ++i ) {
+        sc_digit dw = kind == 0 || kind == 1 ? ~SC_DIGIT_ZERO
+                    : kind == 2 ? SC_DIGIT_ZERO : lcg_next();
+        v.set_word( i, dw );
+    }
+    v.clean_tail();
+    if( !logic )
+        return;
+    if( kind == 1 )
+        v[( lcg_next() >> 8 ) % len] = SC_LOGIC_X;
+    if( kind == 2 )
+        v[( lcg_next() >> 8 ) % len] = SC_LOGIC_Z;
+    if( kind >= 3 ) {
+        for( int i = 0; i < len; i += 1 + ( lcg_next() >> 8 ) % 64 )
+            v[i] = ( lcg_next() & 1 ) ? SC_LOGIC_X : SC_LOGIC_Z;
+    }
+}
+
+template< class X >
+static unsigned fold( const sc_proxy<X>& p )
+{
+    const X& x = p.back_cast();
+    unsigned h = 0;
+    for( int i = 0; i < x.size(); ++i )
+        h = ( h * 31u ) ^ x.get_word( i ) ^ ( x.get_cword( i ) << 7 );
+    return h;
+}
+
+class stopwatch
+{
+public:
+    stopwatch() : m_start( std::clock() ) {}
+    double mops( int n ) const
+    {
+        double s = static_cast<double>( std::clock() - m_start ) / CLOCKS_PER_SEC;
+        return s > 0 ? n / s * 1e-6 : 0;
+    }
+private:
+    std::clock_t m_start;
+};
+
+template< class T >
+static void run( const char* name, bool logic, int iterations, bool timed )
+{
+    T a[NVALUES];
+    T b[NVALUES];
+    for( int i = 0; i < NVALUES; ++i ) {
+        fill( a[i], i % 4 + ( i >= 4 ? 3 : 0 ), logic );
+        fill( b[i], 3, logic );
+    }
+
+    int      len = a[0].length();
+    unsigned checksum = 0;
+    T        c;
+    double   mops[NOPS];
+    int      op = 0;
+
+#   define BITVEC_PERF_OP( stmt )                                             \
+    {                                                                         \
+        stopwatch t;                                                          \
+        for( int i = 0; i < iterations; ++i ) {                               \
+            const T& x = a[i % NVALUES];                                      \
+            const T& y = b[( i + 1 ) % NVALUES];                              \
+            stmt;                                                             \
+        }                                                                     \
+        mops[op++] = t.mops( iterations );                                    \
+    }
+
+    BITVEC_PERF_OP( c = x & y; checksum ^= fold( c ) )
+    BITVEC_PERF_OP( c = x | y; checksum ^= fold( c ) )
+    BITVEC_PERF_OP( c = x ^ y; checksum ^= fold( c ) )
+    BITVEC_PERF_OP( c = ~x; checksum ^= fold( c ) )
+    BITVEC_PERF_OP( c = x; c <<= 1 + i % ( len - 1 ); checksum ^= fold( c ) )
+    BITVEC_PERF_OP( c = x; c >>= 1 + i % ( len - 1 ); checksum ^= fold( c ) )
+    BITVEC_PERF_OP( checksum = checksum * 5u + x.and_reduce()
+                                 + 4u * y.or_reduce() + 16u * x.xor_reduce() )
+
+#   undef BITVEC_PERF_OP
+
+    std::cout << name << std::setw( 5 ) << len << "  " << std::hex
+              << std::setfill( '0' ) << std::setw( 8 ) << checksum
+              << std::dec << std::setfill( ' ' );
+    if( timed ) {
+        std::cout << std::fixed << std::setprecision( 2 );
+        for( int i = 0; i < NOPS; ++i )
+            std::cout << std::setw( 8 ) << mops[i];
+    }
+    std::cout << std::endl;
+}
+
+int sc_main( int argc, char* argv[] )
+{
+    int iterations = 200;
+    bool timed = argc > 1;
+    if( timed )
+        iterations = std::atoi( argv[1] );
+
+    std::cout << "type width  checksum";
+    if( timed )
+        std::cout << "     and      or     xor     not     shl     shr  reduce"
+                     "  (Mops)";
+    std::cout << std::endl;
+
+    run< sc_lv<64> >( "lv ", true, iterations, timed );
+    run< sc_lv<256> >( "lv ", true, iterations, timed );
+    run< sc_lv<1024> >( "lv ", true, iterations, timed );
+    run< sc_lv<4096> >( "lv ", true, iterations, timed );
+    run< sc_lv<8192> >( "lv ", true, iterations, timed );
+    run< sc_bv<64> >( "bv ", false, iterations, timed );
+    run< sc_bv<256> >( "bv ", false, iterations, timed );
+    run< sc_bv<1024> >( "bv ", false, iterations, timed );
+    run< sc_bv<4096> >( "bv ", false, iterations, timed );
+    run< sc_bv<8192> >( "bv ", false, iterations, timed );
+    return 0;
+}
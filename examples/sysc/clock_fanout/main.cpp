@@ -0,0 +1,140 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Many clocked methods statically sensitive to one clock edge.
+
+              Each cell has an SC_METHOD sensitive to the positive edge
+              of a common clock.  Some cells are suspended, disabled, or
+              wait for a dynamic trigger for a few cycles in between, so
+              that the queueing of statically triggered methods is checked
+              for processes in every state.  The number of activations
+              and a checksum of the cell states are printed.  With
+              arguments, the given numbers of cells and clock cycles are
+              simulated and the cost of an activation is printed as well.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+using namespace sc_core;
+
+static unsigned activations = 0;
+
+SC_MODULE(cell)
+{
+    sc_in<bool>       clk;
+    sc_process_handle process;
+    unsigned          state;
+    int               skip;
+
+    SC_CTOR(cell) : clk( "clk" ), state( 0 ), skip( 0 )
+    {
+        SC_METHOD(step);
+        sensitive << clk.pos();
+        dont_initialize();
+        process = sc_get_current_process_handle();
+    }
+
+    void step()
+    {
+        ++activations;
+        state = state * 33u + static_cast<unsigned>( sc_delta_count() );
+        if( skip > 0 )
+            next_trigger( skip-- * sc_time( 10, SC_NS ) );
+    }
+};
+
+SC_MODULE(controller)
+{
+    std::vector<cell*> cells;
+
+    SC_CTOR(controller)
+    {
+        SC_THREAD(run);
+    }
+
+    void run()
+    {
+        wait( 25, SC_NS );
+        for( std::size_t i = 0; i < cells.size(); i += 7 )
+            cells[i]->process.suspend();
+        for( std::size_t i = 3; i < cells.size(); i += 7 )
+            cells[i]->process.disable();
+        for( std::size_t i = 5; i < cells.size(); i += 7 )
+            cells[i]->skip = 2;
+
+        wait( 40, SC_NS );
+        for( std::size_t i = 0; i < cells.size(); i += 7 )
+            cells[i]->process.resume();
+        for( std::size_t i = 3; i < cells.size(); i += 7 )
+            cells[i]->process.enable();
+    }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int n = 1000;
+    int cycles = 100;
+    if( argc > 1 )
+        n = std::atoi( argv[1] );
+    if( argc > 2 )
+        cycles = std::atoi( argv[2] );
+
+    sc_clock           clk( "clk", 10, SC_NS );
+    controller         ctrl( "ctrl" );
+    std::vector<cell*> cells;
+    for( int i = 0; i < n; ++i ) {
+        char name[32];
+        std::sprintf( name, "cell_%d", i );
+        cells.push_back( new cell( name ) );
+        cells.back()->clk( clk );
+    }
+    ctrl.cells = cells;
+
+    sc_start( SC_ZERO_TIME );
+    std::clock_t start = std::clock();
+    sc_start( cycles * sc_time( 10, SC_NS ) );
+    double seconds = static_cast<double>( std::clock() - start ) / CLOCKS_PER_SEC;
+
+    unsigned checksum = 0;
+    for( int i = 0; i < n; ++i )
+        checksum = checksum * 7u + cells[i]->state;
+
+    std::cout << "cells       : " << n << "\n"
+              << "activations : " << activations << "\n"
+              << "checksum    : " << checksum << std::endl;
+
+    if( argc > 1 ) {
+        std::cout << "time        : " << seconds << " s\n"
+                  << "activation  : "
+                  << ( activations ? seconds / activations * 1e9 : 0 )
+                  << " ns" << std::endl;
+    }
+
+    for( int i = 0; i < n; ++i )
+        delete cells[i];
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Coroutine thread processes (SC_COTHREAD).
+
+              A token is passed around a ring of processes, each waiting
+              for its token event and forwarding it after a delay.  A
+              clocked process exercises waiting on the static sensitivity,
+              wait(n) and timeouts, before it terminates.
+
+              With a C++20 compiler, all processes are coroutine threads,
+              which run without a stack of their own.  Otherwise, the same
+              code is compiled as SC_THREADs.  Compare the run-time and
+              memory usage of both variants for a large number of
+              processes, e.g.
+
+                ./co_thread 100000
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+using namespace sc_core;
+
+#ifdef SC_COTHREAD
+# define PROCESS       SC_COTHREAD
+# define PROCESS_BODY  sc_co_thread
+# define WAIT          co_await sc_co_wait
+# define RETURN        co_return
+#else
+# define PROCESS       SC_THREAD
+# define PROCESS_BODY  void
+# define WAIT          wait
+# define RETURN        return
+#endif
+
+static const int rounds = 10;
+
+SC_MODULE(ring_node)
+{
+    sc_event   token;
+    ring_node* next;
+    bool       first;
+    int        hops;
+
+    SC_CTOR(ring_node) : token("token"), next(0), first(false), hops(0)
+    {
+        PROCESS(run);
+    }
+
+    PROCESS_BODY run()
+    {
+        if( first )
+            token.notify( SC_ZERO_TIME );
+        for( int r = 0; r < rounds; ++r ) {
+            WAIT( token );
+            ++hops;
+            WAIT( 1, SC_NS );
+            next->token.notify();
+        }
+        RETURN;
+    }
+};
+
+SC_MODULE(ticker)
+{
+    sc_in<bool>       clk;
+    sc_event          never;
+    sc_process_handle handle;
+    int               ticks;
+    sc_time           timeout_at;
+
+    SC_CTOR(ticker) : clk("clk"), never("never"), ticks(0)
+    {
+        PROCESS(run);
+        sensitive << clk.pos();
+        dont_initialize();
+        handle = sc_get_last_created_process_handle();
+    }
+
+    PROCESS_BODY run()
+    {
+        for( int i = 0; i < 10; ++i ) {
+            ++ticks;
+            WAIT();
+        }
+        for( int i = 0; i < 5; ++i ) {
+            ++ticks;
+            WAIT( 3 );
+        }
+        WAIT( 25, SC_NS, never );
+        timeout_at = sc_time_stamp();
+        RETURN;
+    }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int  num_nodes = ( argc > 1 ) ? std::atoi( argv[1] ) : 1000;
+    bool timed     = ( argc > 1 );
+
+    sc_clock                 clk( "clk", 10, SC_NS );
+    ticker                   tick( "tick" );
+    sc_vector<ring_node>     nodes( "node", num_nodes );
+
+    tick.clk( clk );
+    for( int i = 0; i < num_nodes; ++i )
+        nodes[i].next = &nodes[ ( i + 1 ) % num_nodes ];
+    nodes[0].first = true;
+
+    std::clock_t start = std::clock();
+    sc_start( num_nodes * rounds + 10, SC_NS );
+    double seconds = static_cast<double>( std::clock() - start ) / CLOCKS_PER_SEC;
+
+    int hops = 0;
+    for( int i = 0; i < num_nodes; ++i )
+        hops += nodes[i].hops;
+
+    std::cout << "nodes      : " << num_nodes << "\n"
+              << "hops       : " << hops << "\n"
+              << "ticks      : " << tick.ticks << "\n"
+              << "timeout at : " << tick.timeout_at << "\n"
+              << "terminated : " << std::boolalpha
+                                 << tick.handle.terminated() << "\n"
+              << "time       : " << sc_time_stamp() << std::endl;
+
+    if( timed )
+        std::cout << "cpu time   : " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,155 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Elaboration of a large object hierarchy.
+
+              Builds a hierarchy of clusters of blocks of leaf modules,
+              each leaf containing a signal and a named event, finds
+              every leaf by its hierarchical name and runs the
+              elaboration to completion.  With an argument, the given
+              number of leaves is built and the cpu times of the phases
+              are printed as well.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+using namespace sc_core;
+
+static const int FANOUT = 32;
+
+SC_MODULE(leaf)
+{
+    sc_signal<bool> sig;
+    sc_event        ev;
+
+    SC_CTOR(leaf) : sig( "sig" ), ev( "ev" ) {}
+};
+
+SC_MODULE(block)
+{
+    std::vector<leaf*> leaves;
+
+    block( sc_module_name, int n )
+    {
+        for( int i = 0; i < n; ++i ) {
+            char name[32];
+            std::sprintf( name, "leaf_%d", i );
+            leaves.push_back( new leaf( name ) );
+        }
+    }
+
+    ~block()
+    {
+        for( std::size_t i = 0; i < leaves.size(); ++i )
+            delete leaves[i];
+    }
+};
+
+SC_MODULE(cluster)
+{
+    std::vector<block*> blocks;
+
+    cluster( sc_module_name, int n )
+    {
+        for( int i = 0; n > 0; ++i, n -= FANOUT ) {
+            char name[32];
+            std::sprintf( name, "block_%d", i );
+            blocks.push_back( new block( name, n < FANOUT ? n : FANOUT ) );
+        }
+    }
+
+    ~cluster()
+    {
+        for( std::size_t i = 0; i < blocks.size(); ++i )
+            delete blocks[i];
+    }
+};
+
+class stopwatch
+{
+public:
+    stopwatch() : m_start( std::clock() ) {}
+    double seconds() const
+        { return static_cast<double>( std::clock() - m_start ) / CLOCKS_PER_SEC; }
+private:
+    std::clock_t m_start;
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int leaves = 1000;
+    if( argc > 1 )
+        leaves = std::atoi( argv[1] );
+
+    std::vector<cluster*> clusters;
+    std::vector<std::string> names;
+    std::vector<std::string> event_names;
+
+    stopwatch t_build;
+    for( int i = 0, n = leaves; n > 0; ++i, n -= FANOUT * FANOUT ) {
+        char name[32];
+        std::sprintf( name, "cluster_%d", i );
+        clusters.push_back( new cluster( name, n < FANOUT * FANOUT
+                                               ? n : FANOUT * FANOUT ) );
+    }
+    double s_build = t_build.seconds();
+
+    for( std::size_t c = 0; c < clusters.size(); ++c )
+        for( std::size_t b = 0; b < clusters[c]->blocks.size(); ++b )
+            for( std::size_t l = 0; l < clusters[c]->blocks[b]->leaves.size(); ++l ) {
+                leaf* l_p = clusters[c]->blocks[b]->leaves[l];
+                names.push_back( l_p->name() );
+                event_names.push_back( l_p->ev.name() );
+            }
+
+    stopwatch t_find;
+    int found = 0;
+    for( std::size_t i = 0; i < names.size(); ++i ) {
+        found += ( sc_find_object( names[i].c_str() ) != 0 );
+        found += ( sc_find_event( event_names[i].c_str() ) != 0 );
+    }
+    double s_find = t_find.seconds();
+
+    stopwatch t_elab;
+    sc_start( SC_ZERO_TIME );
+    double s_elab = t_elab.seconds();
+
+    std::cout << "leaves     : " << names.size() << "\n"
+              << "found      : " << found << "\n"
+              << "top level  : " << sc_get_top_level_objects().size()
+              << std::endl;
+
+    if( argc > 1 ) {
+        std::cout << "build      : " << s_build << " s\n"
+                  << "find       : " << s_find << " s\n"
+                  << "elaborate  : " << s_elab << " s" << std::endl;
+    }
+
+    for( std::size_t i = 0; i < clusters.size(); ++i )
+        delete clusters[i];
+    return 0;
+}
@@ -0,0 +1,288 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Sub-models simulated in parallel as islands.
+
+              A cpu issues requests, which a noc forwards to a peripheral
+              and whose responses it forwards back to the cpu.  Each of
+              them is an island with its own simulation context, linked
+              to the others by sc_island_link channels with a latency of
+              20 ns (cpu - noc) and 30 ns (noc - peripheral).  Handling a
+              request takes some work on the host, the amount of which
+              is given by the second argument.
+
+              The islands are simulated in parallel on separate host
+              threads if the SystemC library is built with parallel
+              simulation support.  The printed results do not depend on
+              it.  With arguments, the given number of requests is issued
+              and the wall time of the simulation is printed as well.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+using namespace sc_core;
+
+typedef sc_island_link<unsigned> link_type;
+
+static int requests = 200;
+static int work = 1000; // iterations per request and island
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+    static const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start ).count();
+#else
+    return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+static unsigned compute( unsigned h )
+{
+    for( int i = 0; i < work; ++i ) {
+        h ^= h << 13;
+        h ^= h >> 17;
+        h ^= h << 5;
+    }
+    return h;
+}
+
+// folds a value and the time of its arrival into a checksum
+
+static unsigned fold( unsigned checksum, unsigned value )
+{
+    return checksum * 31u + value
+         + static_cast<unsigned>( sc_time_stamp().value() );
+}
+
+SC_MODULE(cpu)
+{
+    link_type& req;
+    link_type& rsp;
+    int        received;
+    unsigned   checksum;
+
+    SC_HAS_PROCESS(cpu);
+    cpu( sc_module_name, link_type& req_, link_type& rsp_ )
+      : req( req_ ), rsp( rsp_ ), received( 0 ), checksum( 0 )
+    {
+        SC_THREAD(issue);
+        SC_METHOD(complete);
+        sensitive << rsp.data_written_event();
+        dont_initialize();
+    }
+
+    void issue()
+    {
+        for( int i = 0; i < requests; ++i ) {
+            req.write( compute( i + 1 ) );
+            wait( 7 + i % 5, SC_NS );
+        }
+    }
+
+    void complete()
+    {
+        unsigned value;
+        while( rsp.nb_read( value ) ) {
+            ++received;
+            checksum = fold( checksum, value );
+        }
+    }
+};
+
+SC_MODULE(noc)
+{
+    link_type& cpu_req;
+    link_type& cpu_rsp;
+    link_type& periph_req;
+    link_type& periph_rsp;
+    unsigned   checksum;
+
+    SC_HAS_PROCESS(noc);
+    noc( sc_module_name, link_type& cpu_req_, link_type& cpu_rsp_,
+         link_type& periph_req_, link_type& periph_rsp_ )
+      : cpu_req( cpu_req_ ), cpu_rsp( cpu_rsp_ )
+      , periph_req( periph_req_ ), periph_rsp( periph_rsp_ ), checksum( 0 )
+    {
+        SC_METHOD(forward_request);
+        sensitive << cpu_req.data_written_event();
+        dont_initialize();
+        SC_METHOD(forward_response);
+        sensitive << periph_rsp.data_written_event();
+        dont_initialize();
+    }
+
+    void forward_request()
+    {
+        unsigned value;
+        while( cpu_req.nb_read( value ) ) {
+            checksum = fold( checksum, value );
+            periph_req.write( compute( value ) );
+        }
+    }
+
+    void forward_response()
+    {
+        unsigned value;
+        while( periph_rsp.nb_read( value ) ) {
+            checksum = fold( checksum, value );
+            cpu_rsp.write( value );
+        }
+    }
+};
+
+// serves one request at a time, taking 3 ns per request
+
+SC_MODULE(periph)
+{
+    link_type& req;
+    link_type& rsp;
+    unsigned   checksum;
+
+    SC_HAS_PROCESS(periph);
+    periph( sc_module_name, link_type& req_, link_type& rsp_ )
+      : req( req_ ), rsp( rsp_ ), checksum( 0 )
+    {
+        SC_THREAD(serve);
+    }
+
+    void serve()
+    {
+        for( ;; ) {
+            wait( req.data_written_event() );
+            unsigned value;
+            while( req.nb_read( value ) ) {
+                checksum = fold( checksum, value );
+                wait( 3, SC_NS );
+                rsp.write( compute( value ) );
+            }
+        }
+    }
+};
+
+struct cpu_island : sc_island
+{
+    link_type* req;
+    link_type* rsp;
+    cpu*       top;
+
+    cpu_island() : sc_island( "cpu" ), req( 0 ), rsp( 0 ), top( 0 ) {}
+
+    virtual void elaborate()
+        { top = new cpu( "cpu", *req, *rsp ); }
+
+    virtual void destroy()
+        { delete top; }
+};
+
+struct noc_island : sc_island
+{
+    link_type* cpu_req;
+    link_type* cpu_rsp;
+    link_type* periph_req;
+    link_type* periph_rsp;
+    noc*       top;
+
+    noc_island()
+      : sc_island( "noc" ), cpu_req( 0 ), cpu_rsp( 0 )
+      , periph_req( 0 ), periph_rsp( 0 ), top( 0 )
+    {}
+
+    virtual void elaborate()
+    {
+        top = new noc( "noc", *cpu_req, *cpu_rsp, *periph_req, *periph_rsp );
+    }
+
+    virtual void destroy()
+        { delete top; }
+};
+
+struct periph_island : sc_island
+{
+    link_type* req;
+    link_type* rsp;
+    periph*    top;
+
+    periph_island() : sc_island( "periph" ), req( 0 ), rsp( 0 ), top( 0 ) {}
+
+    virtual void elaborate()
+        { top = new periph( "periph", *req, *rsp ); }
+
+    virtual void destroy()
+        { delete top; }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    if( argc > 1 )
+        requests = std::atoi( argv[1] );
+    if( argc > 2 )
+        work = std::atoi( argv[2] );
+
+    cpu_island    cpu_i;
+    noc_island    noc_i;
+    periph_island periph_i;
+
+    link_type cpu_noc( cpu_i, noc_i, sc_time( 20, SC_NS ) );
+    link_type noc_cpu( noc_i, cpu_i, sc_time( 20, SC_NS ) );
+    link_type noc_periph( noc_i, periph_i, sc_time( 30, SC_NS ) );
+    link_type periph_noc( periph_i, noc_i, sc_time( 30, SC_NS ) );
+
+    cpu_i.req = &cpu_noc;
+    cpu_i.rsp = &noc_cpu;
+    noc_i.cpu_req = &cpu_noc;
+    noc_i.cpu_rsp = &noc_cpu;
+    noc_i.periph_req = &noc_periph;
+    noc_i.periph_rsp = &periph_noc;
+    periph_i.req = &noc_periph;
+    periph_i.rsp = &periph_noc;
+
+    sc_island_scheduler scheduler;
+    scheduler.add( cpu_i );
+    scheduler.add( noc_i );
+    scheduler.add( periph_i );
+
+    double t_start = elapsed_seconds();
+    scheduler.start( requests * sc_time( 20, SC_NS ) );
+    double t_end = elapsed_seconds();
+
+    std::cout << "lookahead  : " << scheduler.lookahead() << "\n"
+              << "time       : " << scheduler.time_stamp() << "\n"
+              << "received   : " << cpu_i.top->received << "\n"
+              << "cpu        : " << cpu_i.top->checksum << "\n"
+              << "noc        : " << noc_i.top->checksum << "\n"
+              << "periph     : " << periph_i.top->checksum << std::endl;
+
+    if( argc > 1 )
+        std::cout << "simulation : " << t_end - t_start << " s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,164 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Kernel profile of a small design.
+
+              A counter driven by a clock, a thread waiting with timeouts
+              and a method triggered by delta notifications are simulated
+              until the thread calls sc_stop().  In a library built with
+              kernel profiling support, run with
+
+                SC_KERNEL_PROFILE=TEXT SC_KERNEL_PROFILE_FILE=profile.txt
+
+              or with SC_KERNEL_PROFILE=JSON.  The profile written at the
+              end of the simulation is printed with its wall times masked
+              and the processes in order of their names, as both vary
+              from run to run.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace sc_core;
+
+SC_MODULE(top)
+{
+    sc_in<bool>      clk;
+    sc_signal<int>   count;
+    sc_event         echo_event;
+    int              echoes;
+
+    SC_CTOR(top)
+      : clk("clk"), count("count"), echo_event("echo_event"), echoes(0)
+    {
+        SC_METHOD(counter);
+        sensitive << clk.pos();
+        dont_initialize();
+
+        SC_METHOD(echo);
+        sensitive << echo_event;
+        dont_initialize();
+
+        SC_THREAD(watcher);
+    }
+
+    void counter()
+    {
+        count.write( count.read() + 1 );
+        echo_event.notify( SC_ZERO_TIME );
+    }
+
+    void echo()
+        { ++echoes; }
+
+    void watcher()
+    {
+        while( count.read() < 10 )
+            wait( 25, SC_NS );
+        sc_stop();
+    }
+};
+
+// replace the number following the given key by "t"
+
+static void mask( std::string& line, const std::string& key )
+{
+    std::string::size_type pos = line.find( key );
+    if( pos == std::string::npos )
+        return;
+    pos += key.size();
+    std::string::size_type end = line.find_first_not_of( "0123456789", pos );
+    line.replace( pos, end - pos, "t" );
+}
+
+// print the profile, the processes sorted by name
+
+static void print_profile( const char* file_name )
+{
+    std::ifstream            in( file_name );
+    std::string              line;
+    std::vector<std::string> processes;
+    bool                     in_processes = false;
+    bool                     json = false;
+    while( std::getline( in, line ) ) {
+        mask( line, "activation time : " );
+        mask( line, "update phase time       : " );
+        mask( line, "\"update_ns\": " );
+        mask( line, "\"ns\": " );
+
+        bool process = false;
+        if( line.find( "\"kind\"" ) != std::string::npos ) {
+            // JSON: separators depend on the position in the array
+            if( *line.rbegin() == ',' )
+                line.erase( line.size() - 1 );
+            process = true;
+            json = true;
+        } else if( in_processes && !line.empty() ) {
+            // text: wall time, activations, kind, name
+            std::string::size_type pos = line.find_first_not_of( ' ' );
+            std::string::size_type end = line.find( ' ', pos );
+            line.replace( pos, end - pos, std::string( end - pos - 1, ' ' ) + "t" );
+            process = true;
+        }
+        if( line.find( "activations  " ) != std::string::npos ) {
+            in_processes = true;
+            std::cout << line << "\n";
+            continue;
+        }
+
+        if( process ) {
+            processes.push_back( line );
+            continue;
+        }
+        in_processes = false;
+        std::sort( processes.begin(), processes.end() );
+        for( std::size_t i = 0; i < processes.size(); ++i )
+            std::cout << processes[i]
+                      << ( json && i + 1 < processes.size() ? ",\n" : "\n" );
+        processes.clear();
+        std::cout << line << "\n";
+    }
+    std::cout.flush();
+}
+
+int sc_main( int, char*[] )
+{
+    sc_clock clk( "clk", 10, SC_NS );
+    top      t( "top" );
+    t.clk( clk );
+
+    sc_start();
+
+    std::cout << "time   : " << sc_time_stamp() << "\n"
+              << "count  : " << t.count.read() << "\n"
+              << "echoes : " << t.echoes << std::endl;
+
+    const char* file_name = std::getenv( "SC_KERNEL_PROFILE_FILE" );
+    if( file_name )
+        print_profile( file_name );
+    return 0;
+}
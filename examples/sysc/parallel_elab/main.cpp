@@ -0,0 +1,242 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Parallel elaboration callbacks and port binding.
+
+              Builds clusters of blocks of leaf modules.  The input port of
+              each leaf is bound to the input port of its block, which is
+              bound to the input port of its cluster, which is bound to a
+              common signal.  The leaves are marked as thread-safe for
+              elaboration: before_end_of_elaboration() computes a table
+              from the module name, the amount of work being given by the
+              second argument, and end_of_elaboration() checks the
+              binding and folds the table into a checksum.
+
+              The printed results do not depend on whether the elaboration
+              is performed in parallel, which is selected by the
+              SC_PARALLEL_ELABORATION=ENABLE environment variable together
+              with SC_PARALLEL_WORKERS, and requires a SystemC library
+              built with parallel simulation support.  With an argument,
+              the given number of leaves is built and the wall time of the
+              elaboration phases is printed as well.  Run the example with
+              e.g.
+
+                SC_PARALLEL_WORKERS=8 SC_PARALLEL_ELABORATION=ENABLE \\
+                  ./parallel_elab 100000 2000
+
+              to compare the elaboration time with a sequential one.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+using namespace sc_core;
+
+static const int FANOUT = 32;
+static const int TABLE_SIZE = 16;
+
+static int work = 100; // iterations of before_end_of_elaboration
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+    static const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start ).count();
+#else
+    return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+SC_MODULE(leaf)
+{
+    sc_in<int>  in;
+    sc_out<int> out;
+
+    unsigned table[TABLE_SIZE];
+    unsigned checksum;
+
+    SC_CTOR(leaf) : in( "in" ), out( "out" ), checksum( 0 )
+    {
+        SC_METHOD(step);
+        sensitive << in;
+        dont_initialize();
+
+        elaboration_thread_safe( true );
+    }
+
+    void before_end_of_elaboration()
+    {
+        unsigned h = 2166136261u;
+        for( const char* p = name(); *p; ++p )
+            h = ( h ^ static_cast<unsigned char>( *p ) ) * 16777619u;
+        for( int i = 0; i < TABLE_SIZE; ++i )
+            table[i] = 0;
+        for( int i = 0; i < work; ++i ) {
+            h ^= h << 13;
+            h ^= h >> 17;
+            h ^= h << 5;
+            table[i % TABLE_SIZE] += h;
+        }
+    }
+
+    void end_of_elaboration()
+    {
+        checksum = ( in.size() == 1 && out.size() == 1 ) ? 1 : 0;
+        for( int i = 0; i < TABLE_SIZE; ++i )
+            checksum = checksum * 31 + table[i];
+    }
+
+    void step()
+        { out.write( in.read() + 1 ); }
+};
+
+SC_MODULE(block)
+{
+    sc_in<int>                  in;
+    sc_vector<leaf>             leaves;
+    sc_vector< sc_signal<int> > outs;
+
+    block( sc_module_name, int n )
+      : in( "in" ), leaves( "leaf", n ), outs( "out", n )
+    {
+        for( int i = 0; i < n; ++i ) {
+            leaves[i].in( in );
+            leaves[i].out( outs[i] );
+        }
+    }
+};
+
+SC_MODULE(cluster)
+{
+    sc_in<int>          in;
+    std::vector<block*> blocks;
+
+    cluster( sc_module_name, int n ) : in( "in" )
+    {
+        for( int i = 0; n > 0; ++i, n -= FANOUT ) {
+            char name[32];
+            std::sprintf( name, "block_%d", i );
+            blocks.push_back( new block( name, n < FANOUT ? n : FANOUT ) );
+            blocks.back()->in( in );
+        }
+    }
+
+    ~cluster()
+    {
+        for( std::size_t i = 0; i < blocks.size(); ++i )
+            delete blocks[i];
+    }
+};
+
+// Records the end of the elaboration phases.  Being created last, its
+// before_end_of_elaboration() is called after those of the leaves, the
+// end_of_elaboration() of its port is called first after the port binding
+// has been completed, and its end_of_elaboration() is called last.
+
+struct probe_port : sc_in<int>
+{
+    explicit probe_port( const char* nm ) : sc_in<int>( nm ), bound( 0 ) {}
+
+    virtual void end_of_elaboration()
+        { bound = elapsed_seconds(); }
+
+    double bound;
+};
+
+SC_MODULE(probe)
+{
+    probe_port in;
+    double     constructed;
+    double     elaborated;
+
+    SC_CTOR(probe) : in( "in" ), constructed( 0 ), elaborated( 0 ) {}
+
+    void before_end_of_elaboration()
+        { constructed = elapsed_seconds(); }
+
+    void end_of_elaboration()
+        { elaborated = elapsed_seconds(); }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int leaves = 1000;
+    if( argc > 1 )
+        leaves = std::atoi( argv[1] );
+    if( argc > 2 )
+        work = std::atoi( argv[2] );
+
+    double t_start = elapsed_seconds();
+
+    sc_signal<int>        src( "src" );
+    std::vector<cluster*> clusters;
+    for( int i = 0, n = leaves; n > 0; ++i, n -= FANOUT * FANOUT ) {
+        char name[32];
+        std::sprintf( name, "cluster_%d", i );
+        clusters.push_back( new cluster( name, n < FANOUT * FANOUT
+                                               ? n : FANOUT * FANOUT ) );
+        clusters.back()->in( src );
+    }
+    probe p( "probe" );
+    p.in( src );
+
+    double t_built = elapsed_seconds();
+    sc_start( SC_ZERO_TIME );
+    double t_started = elapsed_seconds();
+
+    unsigned checksum = 0;
+    int      count = 0;
+    for( std::size_t c = 0; c < clusters.size(); ++c ) {
+        for( std::size_t b = 0; b < clusters[c]->blocks.size(); ++b ) {
+            block* b_p = clusters[c]->blocks[b];
+            for( std::size_t l = 0; l < b_p->leaves.size(); ++l ) {
+                checksum = checksum * 7 + b_p->leaves[l].checksum;
+                ++count;
+            }
+        }
+    }
+
+    std::cout << "leaves     : " << count << "\n"
+              << "checksum   : " << checksum << std::endl;
+
+    if( argc > 1 ) {
+        std::cout << "construct  : " << t_built - t_start << " s\n"
+                  << "before end : " << p.constructed - t_built << " s\n"
+                  << "binding    : " << p.in.bound - p.constructed << " s\n"
+                  << "end of elab: " << p.elaborated - p.in.bound << " s\n"
+                  << "start      : " << t_started - p.elaborated << " s"
+                  << std::endl;
+    }
+
+    for( std::size_t i = 0; i < clusters.size(); ++i )
+        delete clusters[i];
+    return 0;
+}
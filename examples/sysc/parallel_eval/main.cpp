@@ -0,0 +1,178 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Parallel evaluation of thread-safe SC_METHODs.
+
+              A ring of cells is clocked by a common clock.  Each cell
+              combines the outputs of its neighbours in a thread-safe
+              SC_METHOD and occasionally notifies an event, which
+              triggers a second thread-safe SC_METHOD with dynamic
+              sensitivity.  A third thread-safe SC_METHOD is statically
+              sensitive to the clock and to an event notified immediately
+              by the first one, and counts the delta cycles in which it
+              ran more than once.  A (non-thread-safe) monitor accumulates
+              a checksum over all outputs.
+
+              The printed results do not depend on the number of workers
+              selected by the SC_PARALLEL_WORKERS environment variable,
+              which requires a SystemC library built with parallel
+              simulation support.  Run the example with e.g.
+
+                SC_PARALLEL_WORKERS=8 ./parallel_eval 100000
+
+              to compare the run time with a sequential evaluation.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <iostream>
+
+using namespace sc_core;
+
+typedef sc_dt::sc_uint<32> word;
+
+SC_MODULE(cell)
+{
+    sc_in<bool>  clk;
+    sc_in<word>  left;
+    sc_in<word>  right;
+    sc_out<word> out;
+
+    SC_CTOR(cell)
+      : clk("clk"), left("left"), right("right"), out("out")
+      , done("done"), ping("ping"), echoes(0), relays(0), reruns(0)
+      , last_delta(~sc_dt::uint64(0))
+    {
+        // declared first, so that it is queued after step()
+        SC_METHOD(relay);
+        sensitive << clk.pos() << ping;
+        dont_initialize();
+        thread_safe();
+
+        SC_METHOD(step);
+        sensitive << clk.pos();
+        dont_initialize();
+        thread_safe();
+
+        SC_METHOD(echo);
+        sensitive << done;
+        dont_initialize();
+        thread_safe();
+    }
+
+    void step()
+    {
+        // some local work, touching only the state of this cell
+        sc_dt::uint64 x = left->read().to_uint64() * 0x9e3779b9u;
+        for( int i = 0; i < 64; ++i )
+            x = ( x >> 7 ) ^ ( x * 31 + right->read().to_uint64() );
+
+        word value = static_cast<unsigned>( x ) ^ out->read();
+        out.write( value );
+        if( ( value & 7 ) == 0 )
+            done.notify( SC_ZERO_TIME );
+        ping.notify();
+    }
+
+    void echo()
+    {
+        ++echoes;
+        if( echoes % 2 )
+            next_trigger( 3, SC_NS );
+    }
+
+    void relay()
+    {
+        ++relays;
+        if( sc_delta_count() == last_delta )
+            ++reruns;
+        last_delta = sc_delta_count();
+    }
+
+    sc_event      done;
+    sc_event      ping;
+    unsigned      echoes;
+    unsigned      relays;
+    unsigned      reruns;
+    sc_dt::uint64 last_delta;
+};
+
+SC_MODULE(ring)
+{
+    sc_in<bool>                 clk;
+    sc_vector<cell>             cells;
+    sc_vector< sc_signal<word> > wires;
+
+    SC_HAS_PROCESS(ring);
+    ring( sc_module_name, int num_cells )
+      : clk("clk"), cells("cell", num_cells), wires("wire", num_cells)
+      , checksum(0)
+    {
+        for( int i = 0; i < num_cells; ++i )
+        {
+            cells[i].clk( clk );
+            cells[i].left( wires[ (i + num_cells - 1) % num_cells ] );
+            cells[i].right( wires[ (i + 1) % num_cells ] );
+            cells[i].out( wires[i] );
+            cells[i].out.initialize( 0x12345u * (i + 1) );
+        }
+
+        SC_METHOD(monitor);
+        sensitive << clk.neg();
+        dont_initialize();
+    }
+
+    void monitor()
+    {
+        for( unsigned i = 0; i < wires.size(); ++i )
+            checksum = ( checksum * 33 ) ^ wires[i].read().to_uint64();
+    }
+
+    unsigned sum( unsigned cell::* counter ) const
+    {
+        unsigned total = 0;
+        for( unsigned i = 0; i < cells.size(); ++i )
+            total += cells[i].*counter;
+        return total;
+    }
+
+    sc_dt::uint64 checksum;
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int cycles = ( argc > 1 ) ? std::atoi( argv[1] ) : 1000;
+
+    sc_clock clk( "clk", 10, SC_NS );
+    ring     top( "top", 1024 );
+    top.clk( clk );
+
+    sc_start( cycles * 10, SC_NS );
+
+    std::cout << "cycles   : " << cycles << "\n"
+              << "echoes   : " << top.sum( &cell::echoes ) << "\n"
+              << "relays   : " << top.sum( &cell::relays ) << "\n"
+              << "reruns   : " << top.sum( &cell::reruns ) << "\n"
+              << "checksum : " << std::hex << top.checksum << std::dec
+              << std::endl;
+    return 0;
+}
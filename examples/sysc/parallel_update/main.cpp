@@ -0,0 +1,146 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Parallel update phase of signals.
+
+              A driver writes a large number of signals in every clock
+              cycle, so that the update phase dominates the simulation.
+              A monitor, sensitive to all signals, folds the values of the
+              signals that changed into an order-dependent checksum.  A
+              reset signal and a FIFO, whose update is not thread-safe,
+              are updated in the same delta cycles.
+
+              The printed results do not depend on whether the update
+              phase is performed in parallel, which is selected by the
+              SC_PARALLEL_UPDATE=ENABLE environment variable together
+              with SC_PARALLEL_WORKERS, and requires a SystemC library
+              built with parallel simulation support.  Run the example
+              with e.g.
+
+                SC_PARALLEL_WORKERS=8 SC_PARALLEL_UPDATE=ENABLE \\
+                  ./parallel_update 1000
+
+              to compare the run time with a sequential update phase.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+using namespace sc_core;
+
+static const int num_signals = 8192;
+
+SC_MODULE(top)
+{
+    sc_in<bool>                 clk;
+    sc_vector< sc_signal<int> > sig;
+    sc_signal<bool>             rst;
+    sc_fifo<int>                fifo;
+
+    int           cycle;
+    unsigned      checksum;
+    unsigned long changes;
+    int           resets;
+    int           fifo_sum;
+
+    SC_CTOR(top)
+      : clk("clk"), sig("sig", num_signals), rst("rst"), fifo("fifo", 4)
+      , cycle(0), checksum(0), changes(0), resets(0), fifo_sum(0)
+    {
+        SC_METHOD(drive);
+        sensitive << clk.pos();
+        dont_initialize();
+
+        SC_METHOD(monitor);
+        for( int i = 0; i < num_signals; ++i )
+            sensitive << sig[i];
+        dont_initialize();
+
+        SC_THREAD(resettable);
+        sensitive << clk.pos();
+        async_reset_signal_is( rst, true );
+
+        SC_THREAD(consume);
+    }
+
+    void drive()
+    {
+        ++cycle;
+        for( int i = 0; i < num_signals; ++i ) {
+            // about half of the signals change their value
+            unsigned h = ( cycle * 2654435761u ) ^ ( i * 40503u );
+            sig[i].write( ( h >> 7 ) & 3 );
+        }
+        rst.write( cycle % 16 == 0 );
+        if( fifo.num_free() > 0 )
+            fifo.nb_write( cycle );
+    }
+
+    void monitor()
+    {
+        for( int i = 0; i < num_signals; ++i ) {
+            if( sig[i].event() ) {
+                checksum = checksum * 31 + sig[i].read() + i;
+                ++changes;
+            }
+        }
+    }
+
+    void resettable()
+    {
+        ++resets;
+        for( ;; )
+            wait();
+    }
+
+    void consume()
+    {
+        for( ;; )
+            fifo_sum += fifo.read();
+    }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int cycles = ( argc > 1 ) ? std::atoi( argv[1] ) : 100;
+
+    sc_clock clk( "clk", 10, SC_NS );
+    top t( "top" );
+    t.clk( clk );
+
+    std::clock_t start = std::clock();
+    sc_start( cycles * 10, SC_NS );
+    double seconds = static_cast<double>( std::clock() - start ) / CLOCKS_PER_SEC;
+
+    std::cout << "cycles     : " << t.cycle << "\n"
+              << "changes    : " << t.changes << "\n"
+              << "checksum   : " << t.checksum << "\n"
+              << "resets     : " << t.resets << "\n"
+              << "fifo sum   : " << t.fifo_sum << "\n"
+              << "time       : " << sc_time_stamp() << std::endl;
+
+    if( argc > 1 )
+        std::cout << "cpu time   : " << seconds << " s" << std::endl;
+    return 0;
+}
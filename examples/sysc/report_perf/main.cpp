@@ -0,0 +1,111 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Cost of info reports.
+
+              Registers a few hundred message types and then issues
+              info reports that are filtered out by the verbosity level
+              and reports that are executed (with SC_DO_NOTHING actions),
+              both with SC_REPORT_INFO_VERB and SC_REPORT_INFO_VERB_CACHED.
+              The report counts are printed at the end.  With an
+              argument, each kind of report is issued the given number of
+              times and the cost of a report in ns is printed as well.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+using namespace sc_core;
+
+static const int NTYPES = 400;
+
+static const char* const msg_type = "/report_perf/hot";
+
+class stopwatch
+{
+public:
+    stopwatch() : m_start( std::clock() ) {}
+    double ns( int n ) const
+    {
+        double s = static_cast<double>( std::clock() - m_start ) / CLOCKS_PER_SEC;
+        return n > 0 ? s / n * 1e9 : 0;
+    }
+private:
+    std::clock_t m_start;
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    int  iterations = 1000;
+    bool timed = argc > 1;
+    if( timed )
+        iterations = std::atoi( argv[1] );
+
+    // message types registered later are searched first
+    sc_report_handler::set_actions( msg_type, SC_DO_NOTHING );
+    for( int i = 0; i < NTYPES; ++i ) {
+        char name[32];
+        std::sprintf( name, "/report_perf/type_%d", i );
+        sc_report_handler::set_actions( name, SC_DO_NOTHING );
+    }
+    sc_report_handler::set_verbosity_level( SC_MEDIUM );
+
+    double ns[4];
+
+    stopwatch t_filtered;
+    for( int i = 0; i < iterations; ++i )
+        SC_REPORT_INFO_VERB( msg_type, "filtered", SC_DEBUG );
+    ns[0] = t_filtered.ns( iterations );
+
+    stopwatch t_filtered_cached;
+    for( int i = 0; i < iterations; ++i )
+        SC_REPORT_INFO_VERB_CACHED( msg_type, "filtered", SC_DEBUG );
+    ns[1] = t_filtered_cached.ns( iterations );
+
+    stopwatch t_reported;
+    for( int i = 0; i < iterations; ++i )
+        SC_REPORT_INFO_VERB( msg_type, "reported", SC_LOW );
+    ns[2] = t_reported.ns( iterations );
+
+    stopwatch t_reported_cached;
+    for( int i = 0; i < iterations; ++i )
+        SC_REPORT_INFO_VERB_CACHED( msg_type, "reported", SC_LOW );
+    ns[3] = t_reported_cached.ns( iterations );
+
+    std::cout << "message types     : " << NTYPES + 1 << "\n"
+              << "reports           : " << 4 * iterations << "\n"
+              << "executed          : " << sc_report_handler::get_count( msg_type )
+              << std::endl;
+
+    if( timed ) {
+        std::cout << std::fixed << std::setprecision( 1 )
+                  << "filtered          : " << ns[0] << " ns\n"
+                  << "filtered (cached) : " << ns[1] << " ns\n"
+                  << "reported          : " << ns[2] << " ns\n"
+                  << "reported (cached) : " << ns[3] << " ns" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Tri-state bus with many drivers.
+
+              Eight drivers write a 128-bit sc_signal_rv and a single-bit
+              sc_signal_resolved in every clock cycle.  Each driver
+              drives its own byte lanes and Z elsewhere, with occasional
+              X and conflicting values.  A checker compares the resolved
+              values with the ones computed bit by bit from the
+              resolution table.  With an argument, the given number of
+              cycles is simulated and the cpu time is printed.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+
+using namespace sc_core;
+using namespace sc_dt;
+
+static const int WIDTH    = 128;
+static const int DRIVERS  = 8;
+static const int PATTERNS = 16;
+
+typedef sc_lv<WIDTH> bus_type;
+
+// driven and expected values, repeated every PATTERNS cycles
+
+struct patterns
+{
+    bus_type value[DRIVERS][PATTERNS];
+    sc_logic bit[DRIVERS][PATTERNS];
+    bus_type expected[PATTERNS];
+    sc_logic bit_expected[PATTERNS];
+
+    patterns()
+    {
+        unsigned rnd = 1;
+        for( int p = 0; p < PATTERNS; ++p ) {
+            for( int j = 0; j < WIDTH; ++j ) {
+                int owner = ( j / 8 + p ) % DRIVERS;
+                for( int k = 0; k < DRIVERS; ++k ) {
+                    rnd = rnd * 1103515245u + 12345u;
+                    unsigned r = rnd >> 16;
+                    sc_logic v( SC_LOGIC_Z );
+                    if( k == owner || r % 64 == 0 )
+                        v = sc_logic( static_cast<int>( ( r >> 8 ) & 1 ) );
+                    else if( r % 64 == 1 )
+                        v = SC_LOGIC_X;
+                    value[k][p][j] = v;
+                }
+                sc_logic_value_t res = value[0][p][j].value();
+                for( int k = 1; k < DRIVERS; ++k )
+                    res = sc_logic_resolution_tbl[res][value[k][p][j].value()];
+                expected[p][j] = res;
+            }
+            int j = ( p * 7 ) % WIDTH;
+            for( int k = 0; k < DRIVERS; ++k )
+                bit[k][p] = value[k][p][j].value();
+            bit_expected[p] = expected[p][j].value();
+        }
+    }
+};
+
+SC_MODULE(driver)
+{
+    sc_in<bool>           clk;
+    sc_out_rv<WIDTH>      bus;
+    sc_out_resolved       bit;
+
+    const patterns&       pat;
+    int                   id;
+    int                   cycle;
+
+    SC_HAS_PROCESS(driver);
+
+    driver( sc_module_name, const patterns& p, int i )
+      : pat(p), id(i), cycle(0)
+    {
+        SC_METHOD(drive);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void drive()
+    {
+        int p = cycle++ % PATTERNS;
+        bus.write( pat.value[id][p] );
+        bit.write( pat.bit[id][p] );
+    }
+};
+
+SC_MODULE(checker)
+{
+    sc_in<bool>           clk;
+    sc_in_rv<WIDTH>       bus;
+    sc_in_resolved        bit;
+
+    const patterns&       pat;
+    int                   cycles;
+    int                   cycle;
+    int                   mismatches;
+    int                   x_bits;
+
+    SC_HAS_PROCESS(checker);
+
+    checker( sc_module_name, const patterns& p )
+      : pat(p), cycles(1000), cycle(0), mismatches(0), x_bits(0)
+    {
+        SC_METHOD(check);
+        sensitive << clk.neg();
+        dont_initialize();
+    }
+
+    void check()
+    {
+        int p = cycle++ % PATTERNS;
+        const bus_type& v = bus.read();
+        if( v != pat.expected[p] )
+            ++mismatches;
+        if( bit.read() != pat.bit_expected[p] )
+            ++mismatches;
+        if( p == 0 ) {
+            for( int j = 0; j < WIDTH; ++j )
+                x_bits += ( v[j].value() == Log_X );
+        }
+        if( cycle == cycles )
+            sc_stop();
+    }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    patterns pat;
+
+    sc_clock               clk( "clk", 10, SC_NS );
+    sc_signal_rv<WIDTH>    bus( "bus" );
+    sc_signal_resolved     bit( "bit" );
+
+    checker chk( "chk", pat );
+    chk.clk( clk );
+    chk.bus( bus );
+    chk.bit( bit );
+
+    driver* drv[DRIVERS];
+    for( int k = 0; k < DRIVERS; ++k ) {
+        drv[k] = new driver( sc_gen_unique_name( "drv" ), pat, k );
+        drv[k]->clk( clk );
+        drv[k]->bus( bus );
+        drv[k]->bit( bit );
+    }
+
+    if( argc > 1 )
+        chk.cycles = std::atoi( argv[1] );
+
+    std::clock_t start = std::clock();
+    sc_start();
+    double seconds = static_cast<double>( std::clock() - start ) / CLOCKS_PER_SEC;
+
+    std::cout << "cycles     : " << chk.cycle << "\n"
+              << "mismatches : " << chk.mismatches << "\n"
+              << "X bits     : " << chk.x_bits << "\n"
+              << "time       : " << sc_time_stamp() << std::endl;
+
+    if( argc > 1 )
+        std::cout << "cpu time   : " << seconds << " s" << std::endl;
+
+    for( int k = 0; k < DRIVERS; ++k )
+        delete drv[k];
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Thread stack allocation and usage reporting.
+
+              Static threads with large stacks only use the memory they
+              touch, and the stacks of terminated dynamic threads are
+              reused by the threads spawned later on.  Run with
+
+                SC_STACK_USAGE_REPORT=ENABLE ./thread_stacks
+
+              to see the stack usage of each thread at the end of the
+              simulation.  The usage depends on the compiler, so it is
+              only compared with the stack size in the output.  With an
+              argument, the given number of waves of dynamic threads is
+              spawned and the cpu time is printed.
+
+ *****************************************************************************/
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#include <systemc>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+using namespace sc_core;
+
+// recursion with 1 KiB of stack per level
+
+static int recurse( int depth )
+{
+    volatile char frame[1024];
+    for( int i = 0; i < 1024; i += 64 )
+        frame[i] = static_cast<char>( depth + i );
+    int sum = ( depth > 0 ) ? recurse( depth - 1 ) : 0;
+    return sum + frame[depth % 16 * 64];
+}
+
+// print the stack usage reports ("<thread>: [at most] <usage> of <size>
+// bytes") without the usage
+
+static void
+report_handler( const sc_report& rep, const sc_actions& actions )
+{
+    if( std::strcmp( rep.get_msg_type(), SC_ID_STACK_USAGE_ ) != 0 ) {
+        sc_report_handler::default_handler( rep, actions );
+        return;
+    }
+
+    std::string msg = rep.get_msg();
+    std::string::size_type colon = msg.rfind( ": " );
+    const char* tail = msg.c_str() + colon + 2;
+    if( std::strncmp( tail, "at most ", 8 ) == 0 )
+        tail += 8;
+    unsigned long usage = std::strtoul( tail, 0, 10 ); // 0, if unknown
+    unsigned long size =
+      std::strtoul( msg.c_str() + msg.rfind( " of " ) + 4, 0, 10 );
+    std::cout << "stack usage: " << msg.substr( 0, colon ) << ": "
+              << ( usage == 0 ? "unknown"
+                 : usage <= size ? "within" : "beyond" )
+              << " " << size << " bytes" << std::endl;
+}
+
+SC_MODULE(top)
+{
+    int  waves;
+    int  spawned;
+    int  sum;
+    int  deep_sum;
+    bool deep_done;
+
+    SC_CTOR(top)
+      : waves(20), spawned(0), sum(0), deep_sum(0), deep_done(false)
+    {
+        SC_THREAD(shallow);
+
+        SC_THREAD(deep);
+        set_stack_size( 16 * 1024 * 1024 );
+
+        SC_THREAD(spawner);
+    }
+
+    void shallow()
+    {
+        wait( 1, SC_NS );
+    }
+
+    void deep()
+    {
+        wait( 1, SC_NS );
+        deep_sum = recurse( 256 );
+        deep_done = true;
+    }
+
+    void worker( int depth )
+    {
+        wait( depth, SC_NS );
+        sum += recurse( depth );
+    }
+
+    void spawner()
+    {
+        sc_spawn_options opt;
+        opt.set_stack_size( 128 * 1024 );
+
+        for( int w = 0; w < waves; ++w ) {
+            sc_event_and_list done;
+            for( int i = 0; i < 100; ++i ) {
+                sc_process_handle h =
+                  sc_spawn( sc_bind( &top::worker, this, i % 32 ), 0, &opt );
+                done &= h.terminated_event();
+                ++spawned;
+            }
+            wait( done );
+        }
+    }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+    sc_report_handler::set_handler( &report_handler );
+
+    top t( "top" );
+    if( argc > 1 )
+        t.waves = std::atoi( argv[1] );
+
+    std::clock_t start = std::clock();
+    sc_start();
+    double seconds = static_cast<double>( std::clock() - start ) / CLOCKS_PER_SEC;
+
+    int expected = 0;
+    for( int i = 0; i < 100; ++i )
+        expected += recurse( i % 32 );
+    expected *= t.waves;
+
+    std::cout << "spawned    : " << t.spawned << "\n"
+              << "sum ok     : " << std::boolalpha
+                                 << ( t.sum == expected ) << "\n"
+              << "deep ok    : " << ( t.deep_done
+                                      && t.deep_sum == recurse( 256 ) ) << "\n"
+              << "time       : " << sc_time_stamp() << std::endl;
+
+    if( argc > 1 )
+        std::cout << "cpu time   : " << seconds << " s" << std::endl;
+    return 0;
+}
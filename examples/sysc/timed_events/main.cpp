@@ -0,0 +1,133 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Cancellation and reuse of timed notifications.
+
+              A number of events is notified at different times, spread
+              over several levels of the timing wheel, and most of them
+              are cancelled again.  The numbers of pending and cancelled
+              timed notifications are printed on the way.  The remaining
+              events must be triggered at their times only.  Afterwards,
+              the same events are notified, cancelled and notified again
+              at earlier times, so that the entries are reused.
+
+              The test is run with both implementations of the queue of
+              timed notifications (SC_TIMED_EVENT_QUEUE=CALENDAR), which
+              differ in when cancelled notifications are dropped.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <iostream>
+
+using namespace sc_core;
+
+static const int N = 1000;
+
+SC_MODULE(top)
+{
+    SC_CTOR(top)
+      : triggered(0), errors(0)
+    {
+        SC_THREAD(notifier);
+
+        SC_METHOD(observer);
+        for( int i = 0; i < N; ++i ) {
+            sensitive << events[i];
+        }
+        dont_initialize();
+    }
+
+    static sc_time period( int i )
+        { return sc_time( 7 * ( i + 1 ), SC_NS ); }
+
+    void print( const char* what )
+    {
+        sc_simcontext* simc = sc_get_curr_simcontext();
+        std::cout << sc_time_stamp() << " " << what
+                  << ": live " << simc->timed_events_live()
+                  << ", cancelled " << simc->timed_events_cancelled()
+                  << std::endl;
+    }
+
+    void notifier()
+    {
+        for( int i = 0; i < N; ++i ) {
+            events[i].notify( period( i ) );
+        }
+        events[N - 1].notify( sc_time( 1, SC_SEC ) ); // ignored, later
+        print( "notified" );
+
+        for( int i = 0; i < N; ++i ) {
+            if( i % 4 != 0 ) {
+                events[i].cancel();
+            }
+        }
+        print( "cancelled" );
+
+        wait( period( N ) );
+        print( "expired" );
+        std::cout << "triggered : " << triggered << std::endl;
+
+        // reuse the entries: notify, cancel and notify again earlier
+        for( int round = 0; round < 10; ++round ) {
+            for( int i = 0; i < N; ++i ) {
+                events[i].notify( sc_time( 1, SC_MS ) + period( i ) );
+            }
+            for( int i = 0; i < N; ++i ) {
+                events[i].cancel();
+            }
+            for( int i = 0; i < N; ++i ) {
+                events[i].notify( sc_time( 2, SC_MS ) + period( i ) );
+                events[i].notify( period( i ) );
+            }
+            if( round == 0 ) {
+                print( "renotified" );
+            }
+            wait( period( N ) );
+        }
+        print( "reused" );
+        std::cout << "triggered : " << triggered << "\n"
+                  << "errors : " << errors << std::endl;
+    }
+
+    void observer()
+    {
+        ++triggered;
+        // all pending events are triggered at multiples of their period
+        sc_dt::uint64 ticks = sc_time_stamp().value() / period( 0 ).value();
+        if( sc_time_stamp() != period( 0 ) * static_cast<double>( ticks ) ) {
+            ++errors;
+        }
+    }
+
+    sc_event events[N];
+    int      triggered;
+    int      errors;
+};
+
+int sc_main( int, char*[] )
+{
+    top t( "top" );
+    sc_start();
+    t.print( "finished" );
+    return 0;
+}
@@ -0,0 +1,413 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Writing and reading a compressed waveform (CWF) trace file.
+
+              A source module drives a few signals of different types and
+              a wide bus of random values, which are traced to
+              trace_cwf.cwf.  After the simulation, the file is read back:
+              the block index is located via the trailer at the end of
+              the file, and only the block covering each of a few points
+              in time is decompressed to reconstruct the traced values at
+              that time.  The values of the bus are compared with the
+              values recorded during the simulation.
+
+              The format is described in sysc/tracing/sc_cwf_trace.h.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace sc_core;
+
+typedef sc_dt::sc_uint<32> word;
+typedef sc_dt::uint64      uint64;
+
+static const int num_words  = 64;
+static const int num_cycles = 20000;
+
+static const int query_cycles[] = { 0, 1, 7, 12345, num_cycles - 1 };
+static const int num_queries    = sizeof(query_cycles) / sizeof(int);
+
+// ----------------------------------------------------------------------------
+//  simulation
+// ----------------------------------------------------------------------------
+
+SC_MODULE(source)
+{
+    sc_in<bool>                        clk;
+    sc_out< sc_dt::sc_uint<8> >        count;
+    sc_out<bool>                       flag;
+    sc_out< sc_dt::sc_lv<4> >          bus;
+    sc_out<double>                     level;
+    sc_out<int>                        small;
+    sc_vector< sc_out<word> >          data;
+    sc_event                           tick;
+
+    // values of data at the query cycles
+    std::map< int, std::vector<unsigned> > snapshots;
+
+    SC_CTOR(source)
+      : clk("clk"), count("count"), flag("flag"), bus("bus"), level("level")
+      , small("small"), data("data", num_words), tick("tick")
+      , cycle(0), state(0x2545f491u)
+    {
+        SC_METHOD(step);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void step()
+    {
+        count.write( cycle & 0xff );
+        flag.write( cycle % 3 == 0 );
+        sc_dt::sc_lv<4> v;
+        for( int i = 0; i < 4; ++i )
+            v[i] = sc_dt::sc_logic( "01ZX"[ ( cycle + i ) % 4 ] );
+        bus.write( v );
+        level.write( cycle * 0.5 );
+        small.write( cycle % 20 - 10 ); // out of range for 4 bits: unknown
+        if( cycle % 5 == 0 )
+            tick.notify();
+
+        std::vector<unsigned> values( num_words );
+        for( int i = 0; i < num_words; ++i ) {
+            // change half of the words in each cycle
+            if( ( i + cycle ) % 2 == 0 ) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                data[i].write( state );
+                values[i] = state;
+            } else {
+                values[i] = data[i].read().to_uint();
+            }
+        }
+        for( int q = 0; q < num_queries; ++q )
+            if( query_cycles[q] == cycle )
+                snapshots[cycle] = values;
+        ++cycle;
+    }
+
+    int      cycle;
+    unsigned state; // xorshift32 (assumes 32-bit unsigned)
+};
+
+// ----------------------------------------------------------------------------
+//  reader
+// ----------------------------------------------------------------------------
+
+struct cwf_variable
+{
+    std::string              name;
+    int                      type;     // 0 bits, 1 logic, 2 real, 3 event
+    int                      width;
+    std::vector<std::string> literals;
+    std::vector<unsigned char> value;
+    bool                     known;
+
+    int size() const
+    {
+        switch( type ) {
+          case 0:  return ( width + 7 ) / 8;
+          case 1:  return ( width + 3 ) / 4;
+          case 2:  return 8;
+          default: return 0;
+        }
+    }
+
+    std::string to_string() const
+    {
+        std::string s;
+        if( type == 3 )
+            return "-";
+        if( type == 2 ) {
+            if( !known )
+                return "x";
+            uint64 bits = 0;
+            for( int i = 7; i >= 0; --i )
+                bits = ( bits << 8 ) | value[i];
+            double d;
+            std::memcpy( &d, &bits, sizeof(d) );
+            std::ostringstream os;
+            os << d;
+            return os.str();
+        }
+        for( int i = width - 1; i >= 0; --i ) {
+            if( !known )
+                s += 'x';
+            else if( type == 0 )
+                s += "01"[ ( value[i / 8] >> ( i % 8 ) ) & 1 ];
+            else
+                s += "01zx"[ ( value[i / 4] >> ( 2 * ( i % 4 ) ) ) & 3 ];
+        }
+        return s;
+    }
+
+    uint64 to_uint64() const
+    {
+        uint64 v = 0;
+        for( int i = size() - 1; i >= 0; --i )
+            v = ( v << 8 ) | value[i];
+        return v;
+    }
+};
+
+class cwf_reader
+{
+public:
+
+    explicit cwf_reader( const char* filename )
+      : m_pos( 0 )
+    {
+        std::ifstream in( filename, std::ios::binary );
+        m_data.assign( std::istreambuf_iterator<char>( in ),
+                       std::istreambuf_iterator<char>() );
+    }
+
+    bool read_header()
+    {
+        if( m_data.size() < 24 || std::memcmp( &m_data[0], "SCCWF\0\0\1", 8 )
+            || std::memcmp( &m_data[m_data.size() - 8], "SCCWFIDX", 8 ) )
+            return false;
+
+        m_pos = 8;
+        unit_fs = number();
+        string();  // date
+        string();  // version
+        variables.resize( number() );
+        for( std::size_t i = 0; i < variables.size(); ++i ) {
+            cwf_variable& v = variables[i];
+            v.name  = string();
+            v.type  = m_data[m_pos++];
+            v.width = static_cast<int>( number() );
+            v.literals.resize( number() );
+            for( std::size_t j = 0; j < v.literals.size(); ++j )
+                v.literals[j] = string();
+            v.value.resize( v.size() );
+            v.known = false;
+        }
+
+        // the index is found via the trailer
+        uint64 offset = 0;
+        for( int i = 7; i >= 0; --i )
+            offset = ( offset << 8 ) | m_data[m_data.size() - 16 + i];
+        m_pos = static_cast<std::size_t>( offset );
+        if( m_data[m_pos++] != 'I' )
+            return false;
+        uint64 blocks = number();
+        for( uint64 i = 0; i < blocks; ++i ) {
+            uint64 start  = number();
+            uint64 end    = number();
+            uint64 where  = number();
+            block_start.push_back( start );
+            block_end.push_back( end );
+            block_offset.push_back( where );
+        }
+        return true;
+    }
+
+    // reconstruct the values of all variables at time t
+    void seek( uint64 t )
+    {
+        // last block starting before or at t
+        std::size_t b = std::upper_bound( block_start.begin(),
+                                          block_start.end(), t )
+                        - block_start.begin();
+        if( b == 0 )
+            return;
+        --b;
+
+        m_pos = block_offset[b];
+        sc_assert( m_data[m_pos] == 'B' );
+        ++m_pos;
+        uint64 start = number();
+        number(); // end
+        uint64 raw_size = number();
+        uint64 size = number();
+        std::vector<unsigned char> raw;
+        decompress( m_pos, size, raw );
+        sc_assert( raw.size() == raw_size );
+
+        std::size_t pos = 0;
+        for( std::size_t i = 0; i < variables.size(); ++i ) {
+            cwf_variable& v = variables[i];
+            v.known = raw[pos++] != 0;
+            if( v.known ) {
+                std::copy( &raw[pos], &raw[pos] + v.size(), v.value.begin() );
+                pos += v.size();
+            }
+        }
+
+        uint64 time = start;
+        while( pos < raw.size() ) {
+            time += number( raw, pos );
+            if( time > t )
+                break;
+            uint64 count = number( raw, pos );
+            int id = -1;
+            for( uint64 c = 0; c < count; ++c ) {
+                uint64 delta = number( raw, pos );
+                id += 1 + static_cast<int>( delta / 2 );
+                cwf_variable& v = variables[id];
+                v.known = ( delta % 2 ) == 0;
+                if( v.known ) {
+                    std::copy( &raw[pos], &raw[pos] + v.size(), v.value.begin() );
+                    pos += v.size();
+                }
+            }
+        }
+    }
+
+    uint64                    unit_fs;
+    std::vector<cwf_variable> variables;
+    std::vector<uint64>       block_start;
+    std::vector<uint64>       block_end;
+    std::vector<uint64>       block_offset;
+
+private:
+
+    uint64 number()
+        { return number( m_data, m_pos ); }
+
+    static uint64 number( const std::vector<unsigned char>& d, std::size_t& pos )
+    {
+        uint64 v = 0;
+        for( int shift = 0; ; shift += 7 ) {
+            unsigned char c = d[pos++];
+            v |= uint64( c & 0x7f ) << shift;
+            if( !( c & 0x80 ) )
+                return v;
+        }
+    }
+
+    std::string string()
+    {
+        std::size_t n = number();
+        std::string s( m_data.begin() + m_pos, m_data.begin() + m_pos + n );
+        m_pos += n;
+        return s;
+    }
+
+    void decompress( std::size_t pos, uint64 size,
+                     std::vector<unsigned char>& out )
+    {
+        std::size_t end = pos + size;
+        while( pos < end ) {
+            std::size_t literals = number( m_data, pos );
+            out.insert( out.end(), &m_data[pos], &m_data[pos] + literals );
+            pos += literals;
+            std::size_t length = number( m_data, pos );
+            if( length == 0 )
+                break;
+            std::size_t from = out.size() - number( m_data, pos );
+            for( std::size_t i = 0; i < length; ++i )
+                out.push_back( out[from + i] );
+        }
+    }
+
+    std::vector<unsigned char> m_data;
+    std::size_t                m_pos;
+};
+
+// ----------------------------------------------------------------------------
+
+int sc_main( int, char*[] )
+{
+    sc_clock                                clk( "clk", 10, SC_NS );
+    sc_signal< sc_dt::sc_uint<8> >          count( "count" );
+    sc_signal<bool>                         flag( "flag" );
+    sc_signal< sc_dt::sc_lv<4> >            bus( "bus" );
+    sc_signal<double>                       level( "level" );
+    sc_signal<int>                          small( "small" );
+    sc_vector< sc_signal<word> >            data( "data", num_words );
+    source                                  src( "src" );
+
+    src.clk( clk );
+    src.count( count );
+    src.flag( flag );
+    src.bus( bus );
+    src.level( level );
+    src.small( small );
+    src.data( data );
+
+    sc_trace_file* tf = sc_create_cwf_trace_file( "trace_cwf" );
+    sc_trace( tf, clk, "clk" );
+    sc_trace( tf, count, "count" );
+    sc_trace( tf, flag, "flag" );
+    sc_trace( tf, bus, "bus" );
+    sc_trace( tf, level, "level" );
+    sc_trace( tf, small, "small", 4 );
+    sc_trace( tf, src.tick, "tick" );
+    for( int i = 0; i < num_words; ++i )
+        sc_trace( tf, data[i], data[i].name() );
+
+    sc_start( num_cycles * 10, SC_NS );
+    sc_close_cwf_trace_file( tf );
+
+    cwf_reader reader( "trace_cwf.cwf" );
+    if( !reader.read_header() ) {
+        std::cout << "invalid file" << std::endl;
+        return 1;
+    }
+
+    std::cout << "time unit : " << reader.unit_fs << " fs\n"
+              << "variables : " << reader.variables.size() << "\n"
+              << "blocks    : " << reader.block_start.size() << "\n";
+    for( int i = 0; i < 7; ++i ) {
+        const cwf_variable& v = reader.variables[i];
+        std::cout << "  " << v.name << " type " << v.type
+                  << " width " << v.width << "\n";
+    }
+
+    for( int q = 0; q < num_queries; ++q ) {
+        int    cycle = query_cycles[q];
+        sc_time at( cycle * 10 + 5, SC_NS );
+        uint64  t = static_cast<uint64>( at.to_seconds() * 1e15
+                                         / reader.unit_fs + 0.5 );
+        reader.seek( t );
+
+        std::cout << "\nat " << at << ":\n";
+        for( int i = 0; i < 6; ++i ) {
+            const cwf_variable& v = reader.variables[i];
+            std::cout << "  " << v.name << " = " << v.to_string() << "\n";
+        }
+
+        const std::vector<unsigned>& expected = src.snapshots[cycle];
+        int ok = 0;
+        for( int i = 0; i < num_words; ++i ) {
+            const cwf_variable& v = reader.variables[7 + i];
+            if( v.known && v.to_uint64() == expected[i] )
+                ++ok;
+        }
+        std::cout << "  data: " << ok << " of " << num_words
+                  << " values match" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- Simulation throughput with and without tracing.
+
+              A driver updates a subset of a large number of signals in
+              each clock cycle.  Each signal fans out to several reader
+              methods.  All signals are traced to trace_perf.vcd, or to
+              the compressed waveform file trace_perf.cwf, unless tracing
+              is disabled on the command line:
+
+                ./trace_perf [<cycles> [notrace|cwf]]
+
+              When the number of cycles is given, the elapsed time and
+              the number of simulated cycles per second are reported.
+              Compare e.g.
+
+                ./trace_perf 20000
+                ./trace_perf 20000 notrace
+                ./trace_perf 20000 cwf
+                SC_TRACE_WRITER_THREAD=DISABLE ./trace_perf 20000
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+using namespace sc_core;
+
+typedef sc_dt::sc_uint<24> word;
+
+static const int num_signals = 4096;
+static const int num_readers = 4; // readers per signal
+
+SC_MODULE(driver)
+{
+    sc_in<bool>               clk;
+    sc_vector< sc_out<word> > out;
+
+    SC_CTOR(driver)
+      : clk("clk"), out("out", num_signals), state(0x2545f491u), phase(0)
+    {
+        SC_METHOD(step);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void step()
+    {
+        // update every 8th signal, starting at a varying offset
+        for( int i = phase; i < num_signals; i += 8 ) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            out[i].write( state & 0xffffffu );
+        }
+        phase = ( phase + 3 ) % 8;
+    }
+
+    unsigned      state; // xorshift32 (assumes 32-bit unsigned)
+    int           phase;
+};
+
+SC_MODULE(reader)
+{
+    sc_in<word> in;
+
+    SC_CTOR(reader) : in("in"), sum(0)
+    {
+        SC_METHOD(read);
+        sensitive << in;
+        dont_initialize();
+    }
+
+    void read()
+        { sum = sum * 3 + in->read().to_uint64(); }
+
+    sc_dt::uint64 sum;
+};
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+    static const std::chrono::steady_clock::time_point start =
+        std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start ).count();
+#else
+    return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+int sc_main( int argc, char* argv[] )
+{
+    int  cycles = ( argc > 1 ) ? std::atoi( argv[1] ) : 200;
+    bool timed  = ( argc > 1 );
+    const char* format = ( argc > 2 ) ? argv[2] : "vcd";
+    bool traced = ( std::strcmp( format, "notrace" ) != 0 );
+    bool cwf    = ( std::strcmp( format, "cwf" ) == 0 );
+
+    sc_clock                      clk( "clk", 10, SC_NS );
+    sc_vector< sc_signal<word> >  wires( "wire", num_signals );
+    driver                        drv( "drv" );
+    sc_vector<reader>             readers( "reader", num_signals * num_readers );
+
+    drv.clk( clk );
+    drv.out( wires );
+    for( int i = 0; i < num_signals * num_readers; ++i )
+        readers[i].in( wires[ i % num_signals ] );
+
+    sc_trace_file* tf = 0;
+    if( traced ) {
+        tf = cwf ? sc_create_cwf_trace_file( "trace_perf" )
+                 : sc_create_vcd_trace_file( "trace_perf" );
+        sc_trace( tf, clk, "clk" );
+        for( int i = 0; i < num_signals; ++i )
+            sc_trace( tf, wires[i], wires[i].name() );
+    }
+
+    double start = elapsed_seconds();
+    sc_start( cycles * 10, SC_NS );
+    if( tf && cwf )
+        sc_close_cwf_trace_file( tf );
+    else if( tf )
+        sc_close_vcd_trace_file( tf );
+    double seconds = elapsed_seconds() - start;
+
+    sc_dt::uint64 checksum = 0;
+    for( int i = 0; i < num_signals * num_readers; ++i )
+        checksum = checksum * 33 + readers[i].sum;
+
+    std::cout << "signals  : " << num_signals << "\n"
+              << "readers  : " << num_signals * num_readers << "\n"
+              << "cycles   : " << cycles << "\n"
+              << "tracing  : " << ( !traced ? "off" : cwf ? "cwf" : "vcd" ) << "\n"
+              << "checksum : " << std::hex << checksum << std::dec
+              << std::endl;
+
+    if( timed ) {
+        std::cout << "time     : " << seconds << " s\n"
+                  << "rate     : " << cycles / seconds << " cycles/s"
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  main.cpp -- A trace file, which is never closed.
+
+              A counter is traced to trace_unclosed.vcd and to
+              trace_unclosed.cwf, and sc_main returns after sc_start()
+              without closing the trace files.  Their output, which is
+              buffered by the library, must still be written, including
+              the index at the end of the CWF file.  A function
+              registered with std::atexit() before the trace files are
+              created runs after the trace files have been flushed.  It
+              prints the VCD file without its date and version, and
+              checks the trailer and the index of the CWF file.
+
+ *****************************************************************************/
+
+#include <systemc>
+#include <cstdlib>
+#include <iterator>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace sc_core;
+
+SC_MODULE(counter)
+{
+    sc_in<bool>                 clk;
+    sc_out< sc_dt::sc_uint<8> > count;
+
+    SC_CTOR(counter)
+      : clk("clk"), count("count"), value(0)
+    {
+        SC_METHOD(step);
+        sensitive << clk.pos();
+        dont_initialize();
+    }
+
+    void step()
+        { count.write( ++value ); }
+
+    unsigned value;
+};
+
+// print the trace file, skipping the sections which vary between runs
+
+static void print_trace()
+{
+    std::ifstream in( "trace_unclosed.vcd" );
+    std::string   line;
+    bool          skip = false;
+    int           lines = 0;
+    while( std::getline( in, line ) ) {
+        ++lines;
+        if( line == "$date" || line == "$version" ) {
+            skip = true;
+            continue;
+        }
+        if( skip ) {
+            skip = ( line != "$end" );
+            continue;
+        }
+        std::cout << line << "\n";
+    }
+    std::cout << "lines : " << lines << std::endl;
+
+    // the trailer refers to the index
+    std::ifstream cwf( "trace_unclosed.cwf", std::ios::binary );
+    std::string   data( ( std::istreambuf_iterator<char>( cwf ) ),
+                        std::istreambuf_iterator<char>() );
+    bool complete = data.size() >= 16
+                 && data.compare( data.size() - 8, 8, "SCCWFIDX" ) == 0;
+    if( complete ) {
+        std::size_t offset = 0;
+        for( int i = 7; i >= 0; --i )
+            offset = ( offset << 8 )
+                   | static_cast<unsigned char>( data[data.size() - 16 + i] );
+        complete = offset < data.size() - 16 && data[offset] == 'I';
+    }
+    std::cout << "cwf index : " << ( complete ? "found" : "missing" )
+              << std::endl;
+}
+
+int sc_main( int, char*[] )
+{
+    std::atexit( &print_trace );
+
+    sc_clock                       clk( "clk", 10, SC_NS );
+    sc_signal< sc_dt::sc_uint<8> > count( "count" );
+
+    counter c( "c" );
+    c.clk( clk );
+    c.count( count );
+
+    sc_trace_file* tf = sc_create_vcd_trace_file( "trace_unclosed" );
+    sc_trace( tf, clk, "clk" );
+    sc_trace( tf, count, "count" );
+
+    sc_trace_file* cwf = sc_create_cwf_trace_file( "trace_unclosed" );
+    sc_trace( cwf, clk, "clk" );
+    sc_trace( cwf, count, "count" );
+
+    sc_start( 100, SC_NS );
+
+    // the trace files are not closed
+    return 0;
+}
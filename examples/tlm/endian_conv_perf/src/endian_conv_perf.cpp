@@ -0,0 +1,236 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  endian_conv_perf.cpp -- The endianness conversion functions of
+                          tlm_endian_conv.h.
+
+              Transactions are converted with the generic, word and aligned
+              functions for bus widths of 2 to 32 bytes and data words of 1
+              to 8 bytes, written to a host-endian memory and read back.
+              Each transaction is converted once without byte enables and
+              once with all bytes enabled, both of which must leave the
+              same contents in the memory.  A checksum of the memory and
+              the number of errors are printed per function set.
+
+              Usage: endian_conv_perf [transactions]
+
+              With an argument, the given number of 64 byte writes and
+              reads is converted with the word functions on a 4 byte bus,
+              as in examples/tlm/lt_mixed_endian, and the wall time and
+              the rate of the conversions are printed as well.
+
+ *****************************************************************************/
+
+#include "tlm.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+static const unsigned int memory_size = 512;
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+  static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start ).count();
+#else
+  return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+// a host-endian memory, honouring byte enables and streaming width
+
+static void access( tlm::tlm_generic_payload& t, unsigned char* mem )
+{
+  unsigned char* data  = t.get_data_ptr();
+  unsigned char* be    = t.get_byte_enable_ptr();
+  unsigned int be_len  = t.get_byte_enable_length();
+  unsigned int len     = t.get_data_length();
+  unsigned int width   = t.get_streaming_width();
+  sc_dt::uint64 addr   = t.get_address();
+
+  for( unsigned int i = 0; i < len; ++i ) {
+    if( be && be[i % be_len] != TLM_BYTE_ENABLED )
+      continue;
+    unsigned char& m = mem[ addr + i % width ];
+    if( t.is_write() )
+      m = data[i];
+    else
+      data[i] = m;
+  }
+  t.set_response_status( tlm::TLM_OK_RESPONSE );
+}
+
+typedef void conv_f( tlm::tlm_generic_payload*, unsigned int );
+
+struct conv_set
+{
+  conv_f* to;
+  conv_f* from;
+};
+
+template<class D> conv_set generic_set()
+{
+  conv_set s = { &tlm::tlm_to_hostendian_generic<D>,
+                 &tlm::tlm_from_hostendian_generic<D> };
+  return s;
+}
+
+template<class D> conv_set word_set()
+{
+  conv_set s = { &tlm::tlm_to_hostendian_word<D>,
+                 &tlm::tlm_from_hostendian_word<D> };
+  return s;
+}
+
+template<class D> conv_set aligned_set()
+{
+  conv_set s = { &tlm::tlm_to_hostendian_aligned<D>,
+                 &tlm::tlm_from_hostendian_aligned<D> };
+  return s;
+}
+
+// converts a transaction, returns false if the conversion back failed
+
+static bool transport( tlm::tlm_generic_payload& t, const conv_set& s,
+                       tlm::tlm_command cmd, sc_dt::uint64 addr,
+                       unsigned char* data, unsigned int len,
+                       unsigned char* be, unsigned int bus,
+                       unsigned char* mem )
+{
+  unsigned char copy[memory_size];
+  std::memcpy( copy, data, len );
+
+  t.set_command( cmd );
+  t.set_address( addr );
+  t.set_data_ptr( data );
+  t.set_data_length( len );
+  t.set_streaming_width( len );
+  t.set_byte_enable_ptr( be );
+  t.set_byte_enable_length( be ? len : 0 );
+
+  s.to( &t, bus );
+  access( t, mem );
+  s.from( &t, bus );
+
+  // the data of a write is left as it was
+  return cmd == tlm::TLM_READ_COMMAND || std::memcmp( copy, data, len ) == 0;
+}
+
+struct result
+{
+  result() : sum( 0 ), errors( 0 ) {}
+  unsigned int sum;
+  int          errors;
+};
+
+// writes a transaction and reads it back, without and with byte enables
+
+static void check( const conv_set& s, unsigned int bus, sc_dt::uint64 addr,
+                   unsigned int len, result& r )
+{
+  unsigned char mem[2][memory_size];
+  unsigned char data[memory_size], rdata[memory_size], be[memory_size];
+  std::memset( be, TLM_BYTE_ENABLED, len );
+
+  for( int with_be = 0; with_be < 2; ++with_be ) {
+    tlm::tlm_generic_payload t;
+    std::memset( mem[with_be], 0, memory_size );
+    for( unsigned int i = 0; i < len; ++i )
+      data[i] = static_cast<unsigned char>( i * 7 + 1 );
+    std::memset( rdata, 0, len );
+
+    unsigned char* b = with_be ? be : 0;
+    if( !transport( t, s, tlm::TLM_WRITE_COMMAND, addr, data, len, b, bus,
+                    mem[with_be] ) )
+      ++r.errors;
+    transport( t, s, tlm::TLM_READ_COMMAND, addr, rdata, len, b, bus,
+               mem[with_be] );
+    if( std::memcmp( data, rdata, len ) != 0 )
+      ++r.errors;
+  }
+
+  if( std::memcmp( mem[0], mem[1], memory_size ) != 0 )
+    ++r.errors;
+  for( unsigned int i = 0; i < memory_size; ++i )
+    r.sum = r.sum * 31u + mem[0][i];
+}
+
+template<class D>
+static void check_word( unsigned int bus, result* r )
+{
+  if( sizeof(D) > bus )
+    return;
+  static const unsigned int offsets[] = { 0, 1, 3 }; // in data words
+  for( int i = 0; i < 3; ++i ) {
+    for( unsigned int words = 1; words <= 4; ++words ) {
+      sc_dt::uint64 addr = 3 * bus + offsets[i] * sizeof(D);
+      unsigned int len = words * bus;
+      check( generic_set<D>(), bus, addr, len, r[0] );
+      check( word_set<D>(), bus, addr, len, r[1] );
+      if( offsets[i] == 0 && sizeof(D) < bus )
+        check( aligned_set<D>(), bus, addr, len, r[2] );
+    }
+  }
+}
+
+int sc_main( int argc, char* argv[] )
+{
+  result r[3];
+  for( unsigned int bus = 2; bus <= 32; bus *= 2 ) {
+    check_word<unsigned char>( bus, r );
+    check_word<unsigned short>( bus, r );
+    check_word<unsigned int>( bus, r );
+    check_word<sc_dt::uint64>( bus, r );
+  }
+
+  static const char* const names[] = { "generic", "word   ", "aligned" };
+  for( int i = 0; i < 3; ++i )
+    std::cout << names[i] << " : checksum " << r[i].sum
+              << ", errors " << r[i].errors << "\n";
+
+  if( argc > 1 ) {
+    int transactions = std::atoi( argv[1] );
+    unsigned char mem[memory_size] = { 0 };
+    unsigned char data[64] = { 0 };
+    tlm::tlm_generic_payload t;
+
+    double t_start = elapsed_seconds();
+    for( int i = 0; i < transactions; ++i ) {
+      transport( t, word_set<unsigned int>(), tlm::TLM_WRITE_COMMAND, 0,
+                 data, sizeof(data), 0, 4, mem );
+      transport( t, word_set<unsigned int>(), tlm::TLM_READ_COMMAND, 0,
+                 data, sizeof(data), 0, 4, mem );
+    }
+    double seconds = elapsed_seconds() - t_start;
+    std::cout << "word, 4 byte bus : " << seconds << " s, "
+              << 2 * transactions / seconds << " transactions/s" << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,328 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  lt_adaptive_quantum.cpp -- Temporally decoupled cores with a fixed and
+                             with an adaptive quantum.
+
+              Three cores share a memory.  The idle core computes on its
+              own, reading private data through DMI.  The other two play
+              ping-pong: each writes a token to its mailbox in the memory
+              and polls the mailbox of the other one through DMI, syncing
+              whenever the token has not arrived yet.  A write to a mailbox
+              invalidates the DMI pointers to the mailboxes.  A token seen
+              at a local time before the time it was written is a causality
+              error of the temporal decoupling, the difference is summed up
+              as the skew of the reading core, which then catches up with
+              the writer.
+
+              The system is simulated twice, side by side: with the cores
+              using tlm_utils::tlm_quantumkeeper, and with the cores using
+              tlm_utils::adaptive_quantumkeeper, whose local quantum may
+              range from 1/64 to 8 times the global quantum.  With an
+              argument, the given number of tokens is exchanged, and the
+              statistics and wall times of the adaptive quantum keepers
+              are printed as well.
+
+ *****************************************************************************/
+
+#include "tlm.h"
+#include "tlm_utils/adaptive_quantumkeeper.h"
+#include "tlm_utils/multi_passthrough_target_socket.h"
+#include "tlm_utils/simple_initiator_socket.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace sc_core;
+
+static int tokens = 200;
+
+static const int          cores = 3;
+static const unsigned int memory_size = 0x1000;
+static const unsigned int mailboxes = 0x800; // one word per core
+
+// a memory granting DMI to its private and to its mailbox half
+
+SC_MODULE(memory)
+{
+  tlm_utils::multi_passthrough_target_socket<memory> socket;
+  unsigned char data[memory_size];
+
+  SC_CTOR(memory) : socket( "socket" )
+  {
+    std::memset( data, 0, sizeof( data ) );
+    socket.register_b_transport( this, &memory::b_transport );
+    socket.register_get_direct_mem_ptr( this, &memory::get_direct_mem_ptr );
+  }
+
+  void b_transport( int, tlm::tlm_generic_payload& trans, sc_time& delay )
+  {
+    sc_dt::uint64 addr = trans.get_address();
+    unsigned int  len = trans.get_data_length();
+    if( addr + len > memory_size ) {
+      trans.set_response_status( tlm::TLM_ADDRESS_ERROR_RESPONSE );
+      return;
+    }
+    if( trans.is_write() ) {
+      std::memcpy( &data[addr], trans.get_data_ptr(), len );
+      if( addr >= mailboxes ) {
+        for( unsigned int i = 0; i < socket.size(); ++i )
+          socket[i]->invalidate_direct_mem_ptr( mailboxes, memory_size - 1 );
+      }
+    } else {
+      std::memcpy( trans.get_data_ptr(), &data[addr], len );
+    }
+    delay += sc_time( 10, SC_NS );
+    trans.set_dmi_allowed( true );
+    trans.set_response_status( tlm::TLM_OK_RESPONSE );
+  }
+
+  bool get_direct_mem_ptr( int, tlm::tlm_generic_payload& trans,
+                           tlm::tlm_dmi& dmi )
+  {
+    sc_dt::uint64 start = ( trans.get_address() < mailboxes ) ? 0 : mailboxes;
+    dmi.set_dmi_ptr( &data[start] );
+    dmi.set_start_address( start );
+    dmi.set_end_address( start + memory_size / 2 - 1 );
+    dmi.set_read_latency( sc_time( 10, SC_NS ) );
+    dmi.set_write_latency( sc_time( 10, SC_NS ) );
+    dmi.allow_read_write();
+    return true;
+  }
+};
+
+// the adaptive quantum keeper is configured and told about invalidations
+
+static void configure( tlm_utils::tlm_quantumkeeper& ) {}
+static void dmi_invalidated( tlm_utils::tlm_quantumkeeper& ) {}
+
+static void configure( tlm_utils::adaptive_quantumkeeper& qk )
+{
+  qk.set_quantum_range( qk.get_global_quantum() / 64,
+                        qk.get_global_quantum() * 8 );
+}
+
+static void dmi_invalidated( tlm_utils::adaptive_quantumkeeper& qk )
+{
+  qk.dmi_invalidated();
+}
+
+// the time each token was written, per system and core
+static sc_time written_at[2][cores];
+
+template<class QK>
+struct core : sc_module
+{
+  tlm_utils::simple_initiator_socket<core> socket;
+  QK            qk;
+  int           system;
+  int           id;
+  tlm::tlm_dmi  dmi;
+  bool          dmi_valid;
+  sc_dt::uint64 syncs;
+  sc_dt::uint64 early_syncs;
+  sc_time       total_skew;   // causality errors
+  sc_time       max_skew;
+  sc_time       done_at;
+
+  SC_HAS_PROCESS(core);
+  core( sc_module_name, int system_, int id_ )
+    : socket( "socket" ), system( system_ ), id( id_ ), dmi_valid( false )
+    , syncs( 0 ), early_syncs( 0 )
+  {
+    socket.register_invalidate_direct_mem_ptr( this, &core::invalidate );
+    SC_THREAD(run);
+  }
+
+  void sync()
+  {
+    ++syncs;
+    if( !qk.need_sync() )
+      ++early_syncs;
+    qk.sync();
+  }
+
+  void compute( int instructions )
+  {
+    for( int i = 0; i < instructions; ++i ) {
+      qk.inc( sc_time( 10, SC_NS ) );
+      if( qk.need_sync() )
+        sync();
+    }
+  }
+
+  // reads a word through DMI, requesting the DMI pointer if needed
+  unsigned int read( sc_dt::uint64 addr )
+  {
+    unsigned int value = 0;
+    if( !dmi_valid || addr < dmi.get_start_address()
+        || addr > dmi.get_end_address() ) {
+      tlm::tlm_generic_payload trans;
+      trans.set_command( tlm::TLM_READ_COMMAND );
+      trans.set_address( addr );
+      trans.set_data_ptr( reinterpret_cast<unsigned char*>( &value ) );
+      trans.set_data_length( 4 );
+      trans.set_streaming_width( 4 );
+      sc_time delay = qk.get_local_time();
+      socket->b_transport( trans, delay );
+      qk.set( delay );
+      if( trans.is_dmi_allowed() )
+        dmi_valid = socket->get_direct_mem_ptr( trans, dmi );
+    } else {
+      std::memcpy( &value, dmi.get_dmi_ptr() + addr - dmi.get_start_address(),
+                   4 );
+      qk.inc( dmi.get_read_latency() );
+    }
+    if( qk.need_sync() )
+      sync();
+    return value;
+  }
+
+  void write( sc_dt::uint64 addr, unsigned int value )
+  {
+    tlm::tlm_generic_payload trans;
+    trans.set_command( tlm::TLM_WRITE_COMMAND );
+    trans.set_address( addr );
+    trans.set_data_ptr( reinterpret_cast<unsigned char*>( &value ) );
+    trans.set_data_length( 4 );
+    trans.set_streaming_width( 4 );
+    sc_time delay = qk.get_local_time();
+    socket->b_transport( trans, delay );
+    qk.set( delay );
+    if( qk.need_sync() )
+      sync();
+  }
+
+  void send( unsigned int token )
+  {
+    written_at[system][id] = qk.get_current_time();
+    write( mailboxes + 4 * id, token );
+  }
+
+  void receive( int from, unsigned int token )
+  {
+    while( read( mailboxes + 4 * from ) != token )
+      sync(); // let the other core run
+    // a token seen before it was written: catch up with the writer
+    sc_time now = qk.get_current_time();
+    if( now < written_at[system][from] ) {
+      sc_time skew = written_at[system][from] - now;
+      total_skew += skew;
+      if( skew > max_skew )
+        max_skew = skew;
+      qk.inc( skew );
+    }
+  }
+
+  void run()
+  {
+    configure( qk );
+    qk.reset();
+
+    if( id == 0 ) {
+      // idle
+      for( int i = 0; i < 100 * tokens; ++i ) {
+        compute( 16 );
+        read( 4 * ( i % 64 ) );
+      }
+    } else if( id == 1 ) {
+      for( int i = 1; i <= tokens; ++i ) {
+        compute( 8 );
+        send( i );
+        receive( 2, i );
+      }
+    } else {
+      for( int i = 1; i <= tokens; ++i ) {
+        receive( 1, i );
+        compute( 8 );
+        send( i );
+      }
+    }
+    sync();
+    done_at = sc_time_stamp();
+  }
+
+  void invalidate( sc_dt::uint64 start, sc_dt::uint64 end )
+  {
+    if( dmi_valid && start <= dmi.get_end_address()
+        && end >= dmi.get_start_address() ) {
+      dmi_valid = false;
+      dmi_invalidated( qk );
+    }
+  }
+};
+
+template<class QK>
+struct platform
+{
+  platform( const char* name, int system )
+    : mem( sc_gen_unique_name( "memory" ) ), m_name( name )
+  {
+    for( int i = 0; i < cores; ++i ) {
+      c[i] = new core<QK>( sc_gen_unique_name( "core" ), system, i );
+      c[i]->socket.bind( mem.socket );
+    }
+  }
+
+  void print( std::ostream& os ) const
+  {
+    static const char* const roles[] = { "idle", "ping", "pong" };
+    for( int i = 0; i < cores; ++i ) {
+      os << std::left << std::setw( 18 ) << m_name << std::right
+         << roles[i] << " : " << std::setw( 6 ) << c[i]->syncs
+         << " syncs, " << std::setw( 6 ) << c[i]->early_syncs << " early, "
+         << "skew " << c[i]->total_skew << " total, " << c[i]->max_skew
+         << " max, done at " << c[i]->done_at << "\n";
+    }
+  }
+
+  memory      mem;
+  core<QK>*   c[cores];
+  const char* m_name;
+};
+
+int sc_main( int argc, char* argv[] )
+{
+  if( argc > 1 )
+    tokens = std::atoi( argv[1] );
+
+  tlm::tlm_global_quantum::instance().set( sc_time( 1, SC_US ) );
+
+  platform<tlm_utils::tlm_quantumkeeper>      fixed( "fixed quantum", 0 );
+  platform<tlm_utils::adaptive_quantumkeeper> adaptive( "adaptive quantum", 1 );
+
+  sc_start();
+
+  fixed.print( std::cout );
+  adaptive.print( std::cout );
+  for( int i = 0; i < cores; ++i )
+    std::cout << "adaptive quantum  " << ( i == 0 ? "idle" : i == 1 ? "ping"
+                                                          : "pong" )
+              << " : quantum " << adaptive.c[i]->qk.get_quantum() << "\n";
+
+  if( argc > 1 ) {
+    for( int i = 0; i < cores; ++i )
+      adaptive.c[i]->qk.print_statistics( std::cout );
+  }
+  return 0;
+}
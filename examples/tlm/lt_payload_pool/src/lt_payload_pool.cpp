@@ -0,0 +1,248 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  lt_payload_pool.cpp -- Transactions allocated from a payload pool.
+
+              An initiator issues blocking transactions through an
+              interconnect to a memory, using a quantum keeper.  The
+              interconnect attaches a routing extension to each
+              transaction, which it reuses if already present.
+
+              The transactions are issued twice: first with payloads and
+              data buffers created and deleted for each transaction, then
+              with payloads from tlm_utils::payload_pool, which recycles
+              the payloads together with their data buffers and routing
+              extensions.  With arguments, the given number of
+              transactions is issued and the wall time and rate of both
+              runs are printed as well.
+
+ *****************************************************************************/
+
+#include "tlm.h"
+#include "tlm_utils/payload_pool.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+using namespace sc_core;
+
+static int transactions = 100000;
+
+static const unsigned int memory_size = 0x10000;
+static const unsigned int data_length = 8;
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+  static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start ).count();
+#else
+  return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+// the target port the interconnect routed a transaction to
+
+struct route_extension : tlm::tlm_extension<route_extension>
+{
+  route_extension() : port( 0 ) {}
+
+  virtual tlm::tlm_extension_base* clone() const
+    { return new route_extension( *this ); }
+
+  virtual void copy_from( const tlm::tlm_extension_base& ext )
+    { port = static_cast<const route_extension&>( ext ).port; }
+
+  unsigned int port;
+};
+
+SC_MODULE(initiator)
+{
+  tlm_utils::simple_initiator_socket<initiator> socket;
+  unsigned int checksum[2];
+  double       seconds[2];
+
+  SC_CTOR(initiator) : socket( "socket" )
+  {
+    SC_THREAD(run);
+  }
+
+  void run()
+  {
+    for( int pooled = 0; pooled < 2; ++pooled ) {
+      double t_start = elapsed_seconds();
+      checksum[pooled] = issue( pooled != 0 );
+      seconds[pooled] = elapsed_seconds() - t_start;
+    }
+  }
+
+  // writes to all words of the memory, reads them back afterwards
+
+  unsigned int issue( bool pooled )
+  {
+    tlm_utils::tlm_quantumkeeper qk;
+    qk.reset();
+
+    unsigned int sum = 0;
+    for( int i = 0; i < transactions; ++i )
+    {
+      tlm::tlm_generic_payload* trans;
+      if( pooled ) {
+        trans = tlm_utils::payload_pool::instance().allocate( data_length );
+        trans->acquire();
+      } else {
+        trans = new tlm::tlm_generic_payload;
+        trans->set_data_ptr( new unsigned char[data_length] );
+        trans->set_data_length( data_length );
+        trans->set_streaming_width( data_length );
+      }
+
+      unsigned int words = memory_size / data_length;
+      unsigned int word = static_cast<unsigned int>( i ) % words;
+      bool write = ( static_cast<unsigned int>( i ) / words ) % 2 == 0;
+      trans->set_address( word * data_length );
+      if( write ) {
+        trans->set_command( tlm::TLM_WRITE_COMMAND );
+        for( unsigned int j = 0; j < data_length; ++j )
+          trans->get_data_ptr()[j] = static_cast<unsigned char>( i + j );
+      } else {
+        trans->set_command( tlm::TLM_READ_COMMAND );
+      }
+
+      sc_time delay = qk.get_local_time();
+      socket->b_transport( *trans, delay );
+      qk.set( delay );
+      if( qk.need_sync() )
+        qk.sync();
+
+      if( trans->is_response_error() )
+        SC_REPORT_ERROR( "lt_payload_pool", "transaction failed" );
+      if( !write ) {
+        for( unsigned int j = 0; j < data_length; ++j )
+          sum = sum * 31u + trans->get_data_ptr()[j];
+      }
+
+      if( pooled ) {
+        trans->release();
+      } else {
+        delete [] trans->get_data_ptr();
+        delete trans; // deletes the extensions as well
+      }
+    }
+    return sum;
+  }
+};
+
+SC_MODULE(interconnect)
+{
+  tlm_utils::simple_target_socket<interconnect>    target_socket;
+  tlm_utils::simple_initiator_socket<interconnect> initiator_socket;
+
+  SC_CTOR(interconnect)
+    : target_socket( "target_socket" ), initiator_socket( "initiator_socket" )
+  {
+    target_socket.register_b_transport( this, &interconnect::b_transport );
+  }
+
+  void b_transport( tlm::tlm_generic_payload& trans, sc_time& delay )
+  {
+    route_extension* route = trans.get_extension<route_extension>();
+    if( !route ) {
+      route = new route_extension;
+      trans.set_extension( route );
+    }
+    route->port = 0;
+    delay += sc_time( 2, SC_NS );
+    initiator_socket->b_transport( trans, delay );
+  }
+};
+
+SC_MODULE(memory)
+{
+  tlm_utils::simple_target_socket<memory> socket;
+  unsigned char data[memory_size];
+
+  SC_CTOR(memory) : socket( "socket" )
+  {
+    std::memset( data, 0, sizeof( data ) );
+    socket.register_b_transport( this, &memory::b_transport );
+  }
+
+  void b_transport( tlm::tlm_generic_payload& trans, sc_time& delay )
+  {
+    sc_dt::uint64 addr = trans.get_address();
+    unsigned int  len = trans.get_data_length();
+    if( addr + len > memory_size || trans.get_byte_enable_ptr() ) {
+      trans.set_response_status( tlm::TLM_ADDRESS_ERROR_RESPONSE );
+      return;
+    }
+    if( trans.is_write() )
+      std::memcpy( &data[addr], trans.get_data_ptr(), len );
+    else if( trans.is_read() )
+      std::memcpy( trans.get_data_ptr(), &data[addr], len );
+    delay += sc_time( 10, SC_NS );
+    trans.set_response_status( tlm::TLM_OK_RESPONSE );
+  }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+  if( argc > 1 )
+    transactions = std::atoi( argv[1] );
+
+  tlm::tlm_global_quantum::instance().set( sc_time( 1, SC_US ) );
+
+  initiator    init( "initiator" );
+  interconnect bus( "interconnect" );
+  memory       mem( "memory" );
+  init.socket.bind( bus.target_socket );
+  bus.initiator_socket.bind( mem.socket );
+
+  sc_start();
+
+  tlm_utils::payload_pool& pool = tlm_utils::payload_pool::instance();
+  std::cout << "transactions : " << transactions << "\n"
+            << "new/delete   : checksum " << init.checksum[0] << "\n"
+            << "payload pool : checksum " << init.checksum[1] << "\n"
+            << "time         : " << sc_time_stamp() << "\n";
+  pool.print_statistics( std::cout );
+
+  if( argc > 1 ) {
+    std::cout << "new/delete   : " << init.seconds[0] << " s, "
+              << transactions / init.seconds[0] << " transactions/s\n"
+              << "payload pool : " << init.seconds[1] << " s, "
+              << transactions / init.seconds[1] << " transactions/s"
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,206 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  lt_sparse_memory.cpp -- A 16 GB memory backed by tlm_utils::sparse_memory.
+
+              An initiator writes blocks of data spread over the whole
+              memory with blocking transactions, reads them back and
+              checks them.  It then fills a page through DMI, reads it
+              with debug transactions, and writes single bytes with byte
+              enables.  Only the pages written to are allocated.
+
+              Usage: lt_sparse_memory [transactions [file]]
+
+              With arguments, the given number of transactions is issued,
+              and the wall time and the rate of the transactions are
+              printed as well.  If a file is given, the memory is backed
+              by that file, which keeps its contents afterwards.
+
+ *****************************************************************************/
+
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/sparse_memory.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+using namespace sc_core;
+
+static int transactions = 10000;
+
+static const sc_dt::uint64 gigabyte = 1u << 30;
+static const sc_dt::uint64 memory_size = 16 * gigabyte;
+static const unsigned int  block_size = 64;
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+  static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start ).count();
+#else
+  return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+SC_MODULE(initiator)
+{
+  tlm_utils::simple_initiator_socket<initiator> socket;
+  unsigned int checksum;
+  int          errors;
+  double       seconds;
+
+  SC_CTOR(initiator) : socket( "socket" ), checksum( 0 ), errors( 0 )
+  {
+    SC_THREAD(run);
+  }
+
+  // the address of block i, spread over 256 MB strides
+  static sc_dt::uint64 address( int i )
+  {
+    return ( i % 64 ) * ( gigabyte / 4 )
+         + static_cast<sc_dt::uint64>( i / 64 ) * block_size;
+  }
+
+  bool transport( tlm::tlm_command cmd, sc_dt::uint64 addr,
+                  unsigned char* data, unsigned int len, sc_time& delay,
+                  unsigned char* be = 0, unsigned int be_len = 0 )
+  {
+    tlm::tlm_generic_payload trans;
+    trans.set_command( cmd );
+    trans.set_address( addr );
+    trans.set_data_ptr( data );
+    trans.set_data_length( len );
+    trans.set_streaming_width( len );
+    trans.set_byte_enable_ptr( be );
+    trans.set_byte_enable_length( be_len );
+    socket->b_transport( trans, delay );
+    return trans.is_response_ok();
+  }
+
+  void run()
+  {
+    sc_time delay = SC_ZERO_TIME;
+    unsigned char data[block_size];
+
+    double t_start = elapsed_seconds();
+    for( int i = 0; i < transactions; ++i ) {
+      for( unsigned int j = 0; j < block_size; ++j )
+        data[j] = static_cast<unsigned char>( i * 7 + j );
+      if( !transport( tlm::TLM_WRITE_COMMAND, address( i ), data,
+                      block_size, delay ) )
+        ++errors;
+    }
+    for( int i = 0; i < transactions; ++i ) {
+      if( !transport( tlm::TLM_READ_COMMAND, address( i ), data,
+                      block_size, delay ) )
+        ++errors;
+      for( unsigned int j = 0; j < block_size; ++j ) {
+        if( data[j] != static_cast<unsigned char>( i * 7 + j ) )
+          ++errors;
+        checksum = checksum * 31u + data[j];
+      }
+    }
+    seconds = elapsed_seconds() - t_start;
+    wait( delay );
+
+    // fill the last page through DMI
+
+    tlm::tlm_generic_payload trans;
+    tlm::tlm_dmi dmi;
+    trans.set_address( memory_size - 1 );
+    if( socket->get_direct_mem_ptr( trans, dmi ) && dmi.is_write_allowed() ) {
+      sc_dt::uint64 len = dmi.get_end_address() - dmi.get_start_address() + 1;
+      std::memset( dmi.get_dmi_ptr(), 0x5a, static_cast<std::size_t>( len ) );
+      std::cout << "dmi        : " << std::hex << dmi.get_start_address()
+                << " - " << dmi.get_end_address() << std::dec << "\n";
+    } else {
+      ++errors;
+    }
+
+    // read it back with debug transactions
+
+    trans.set_command( tlm::TLM_READ_COMMAND );
+    trans.set_address( memory_size - block_size );
+    trans.set_data_ptr( data );
+    trans.set_data_length( block_size );
+    if( socket->transport_dbg( trans ) != block_size || data[0] != 0x5a )
+      ++errors;
+
+    // write every other byte
+
+    unsigned char be[2] = { TLM_BYTE_ENABLED, TLM_BYTE_DISABLED };
+    std::memset( data, 0xff, block_size );
+    if( !transport( tlm::TLM_WRITE_COMMAND, 0, data, block_size, delay,
+                    be, 2 )
+        || !transport( tlm::TLM_READ_COMMAND, 0, data, 4, delay ) )
+      ++errors;
+    for( unsigned int j = 0; j < 4; ++j )
+      checksum = checksum * 31u + data[j];
+
+    // outside of the memory
+    if( transport( tlm::TLM_WRITE_COMMAND, memory_size, data, 4, delay ) )
+      ++errors;
+  }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+  if( argc > 1 )
+    transactions = std::atoi( argv[1] );
+  const char* file = ( argc > 2 ) ? argv[2] : 0;
+
+  double t_start = elapsed_seconds();
+  initiator                init( "initiator" );
+  tlm_utils::sparse_memory mem( "memory", memory_size, file );
+  mem.set_read_latency( sc_time( 10, SC_NS ) );
+  mem.set_write_latency( sc_time( 10, SC_NS ) );
+  init.socket.bind( mem.socket );
+  double t_elaboration = elapsed_seconds() - t_start;
+
+  sc_start();
+  mem.flush();
+
+  std::cout << "size       : " << ( mem.size() >> 30 ) << " GB\n"
+            << "pages      : " << mem.touched_pages() << " touched\n"
+            << "checksum   : " << init.checksum << "\n"
+            << "errors     : " << init.errors << "\n"
+            << "time       : " << sc_time_stamp() << std::endl;
+
+  if( argc > 1 ) {
+    std::cout << "mapped     : " << ( mem.is_mapped() ? "yes" : "no" )
+              << "\n"
+              << "elaboration: " << t_elaboration << " s\n"
+              << "transport  : " << init.seconds << " s, "
+              << 2 * transactions / init.seconds << " transactions/s"
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,227 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  peq_perf.cpp -- Throughput of the payload event queues.
+
+              A target keeps a given number of transactions outstanding
+              in a peq_with_cb_and_phase and in a peq_with_get: whenever
+              a transaction is fired, it is notified again with a pseudo
+              random delay, many of which are equal.  The order in which
+              the transactions are fired is folded into a checksum, for
+              queue depths of 10, 1000 and 100000.
+
+              Usage: peq_perf [fires]
+
+              With an argument, the given number of transactions is fired
+              per queue and depth, and the wall time and the rate are
+              printed as well.
+
+ *****************************************************************************/
+
+#include "tlm.h"
+#include "tlm_utils/peq_with_cb_and_phase.h"
+#include "tlm_utils/peq_with_get.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#endif
+
+using namespace sc_core;
+
+static int fires = 200000;
+
+static double elapsed_seconds()
+{
+#if SC_CPLUSPLUS >= 201103L
+  static const std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now() - start ).count();
+#else
+  return static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+#endif
+}
+
+// the transactions, identified by their addresses, and their delays
+
+struct traffic
+{
+  explicit traffic( int depth_ )
+    : trans( new tlm::tlm_generic_payload[depth_] ), depth( depth_ )
+    , seed( 1 ), fired( 0 ), sum( 0 ), seconds( 0 )
+  {
+    for( int i = 0; i < depth; ++i )
+      trans[i].set_address( i );
+  }
+
+  ~traffic() { delete [] trans; }
+
+  // 1 to 91 ns, in steps of 10 ns
+  sc_time delay()
+  {
+    seed = seed * 1103515245u + 12345u;
+    return sc_time( 1 + ( seed >> 16 ) % 10 * 10, SC_NS );
+  }
+
+  // returns false, once enough transactions have been fired
+  bool fire( tlm::tlm_generic_payload& t )
+  {
+    sum = sum * 31u + static_cast<unsigned int>( t.get_address() )
+        + static_cast<unsigned int>( sc_time_stamp().value() );
+    if( ++fired < fires )
+      return true;
+    seconds = elapsed_seconds() - seconds;
+    done.notify();
+    return false;
+  }
+
+  tlm::tlm_generic_payload* trans;
+  int          depth;
+  unsigned int seed;
+  int          fired;
+  unsigned int sum;
+  double       seconds;
+  sc_event     go;
+  sc_event     done;
+};
+
+SC_MODULE(cb_target)
+{
+  tlm_utils::peq_with_cb_and_phase<cb_target> peq;
+  traffic& tr;
+
+  SC_HAS_PROCESS(cb_target);
+  cb_target( sc_module_name, traffic& tr_ )
+    : peq( this, &cb_target::peq_cb ), tr( tr_ )
+  {
+    SC_THREAD(start);
+  }
+
+  void start()
+  {
+    wait( tr.go );
+    tr.seconds = elapsed_seconds();
+    for( int i = 0; i < tr.depth; ++i )
+      peq.notify( tr.trans[i], tlm::BEGIN_REQ, tr.delay() );
+  }
+
+  void peq_cb( tlm::tlm_generic_payload& t, const tlm::tlm_phase& phase )
+  {
+    if( tr.fire( t ) )
+      peq.notify( t, phase, tr.delay() );
+    else
+      peq.cancel_all();
+  }
+};
+
+SC_MODULE(get_target)
+{
+  tlm_utils::peq_with_get<tlm::tlm_generic_payload> peq;
+  traffic& tr;
+
+  SC_HAS_PROCESS(get_target);
+  get_target( sc_module_name, traffic& tr_ )
+    : peq( "peq" ), tr( tr_ )
+  {
+    SC_THREAD(run);
+  }
+
+  void run()
+  {
+    wait( tr.go );
+    tr.seconds = elapsed_seconds();
+    for( int i = 0; i < tr.depth; ++i )
+      peq.notify( tr.trans[i], tr.delay() );
+    for( ;; ) {
+      wait( peq.get_event() );
+      while( tlm::tlm_generic_payload* t = peq.get_next_transaction() ) {
+        if( !tr.fire( *t ) ) {
+          peq.cancel_all();
+          return;
+        }
+        peq.notify( *t, tr.delay() );
+      }
+    }
+  }
+};
+
+// starts the targets one after the other
+
+SC_MODULE(driver)
+{
+  std::vector<traffic*> traffics;
+
+  SC_CTOR(driver)
+  {
+    SC_THREAD(run);
+  }
+
+  void run()
+  {
+    for( std::size_t i = 0; i < traffics.size(); ++i ) {
+      traffics[i]->go.notify( SC_ZERO_TIME );
+      wait( traffics[i]->done );
+    }
+  }
+};
+
+int sc_main( int argc, char* argv[] )
+{
+  if( argc > 1 )
+    fires = std::atoi( argv[1] );
+
+  static const int depths[] = { 10, 1000, 100000 };
+  static const int n_depths = sizeof( depths ) / sizeof( depths[0] );
+
+  driver drv( "driver" );
+  for( int i = 0; i < n_depths; ++i ) {
+    traffic* tr = new traffic( depths[i] );
+    new cb_target( sc_gen_unique_name( "cb_target" ), *tr );
+    drv.traffics.push_back( tr );
+    tr = new traffic( depths[i] );
+    new get_target( sc_gen_unique_name( "get_target" ), *tr );
+    drv.traffics.push_back( tr );
+  }
+
+  sc_start();
+
+  for( std::size_t i = 0; i < drv.traffics.size(); ++i ) {
+    traffic* tr = drv.traffics[i];
+    std::cout << ( i % 2 == 0 ? "peq_with_cb_and_phase" : "peq_with_get         " )
+              << " depth " << std::setw( 6 ) << tr->depth
+              << " : checksum " << tr->sum;
+    if( argc > 1 )
+      std::cout << ", " << tr->seconds << " s, "
+                << tr->fired / tr->seconds << " transactions/s";
+    std::cout << "\n";
+  }
+  std::cout << "time : " << sc_time_stamp() << std::endl;
+
+  for( std::size_t i = 0; i < drv.traffics.size(); ++i )
+    delete drv.traffics[i];
+  return 0;
+}
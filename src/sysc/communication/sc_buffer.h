@@ -95,6 +95,9 @@ protected:
 
     virtual void update();
 
+    virtual const std::type_info* thread_safe_update_type() const
+        { return &typeid( this_type ); }
+
 private:
 
     // disabled
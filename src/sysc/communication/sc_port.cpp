@@ -31,12 +31,14 @@
 #include "sysc/kernel/sc_object_int.h"
 #include "sysc/kernel/sc_method_process.h"
 #include "sysc/kernel/sc_thread_process.h"
+#include "sysc/kernel/sc_worker_pool.h"
 #include "sysc/communication/sc_communication_ids.h"
 #include "sysc/utils/sc_utils_ids.h"
 #include "sysc/communication/sc_event_finder.h"
 #include "sysc/communication/sc_port.h"
 #include "sysc/communication/sc_signal_ifs.h"
 
+#include <algorithm>
 #include <sstream>
 
 namespace sc_core {
@@ -138,6 +140,8 @@ struct sc_bind_info
     int                        last_add;
     bool                       is_leaf;
     bool                       complete;
+    int                        level;   // depth below the unbound ports.
+    std::vector<sc_port_base*> parents; // inserted by resolve_binding.
 
     ef_vector                  thread_vec;
     ef_vector                  method_vec;
@@ -156,6 +160,8 @@ sc_bind_info::sc_bind_info( int max_size_, sc_port_policy policy_ )
   last_add( -1 ),
   is_leaf( true ),
   complete( false ),
+  level( -1 ),
+  parents(),
   thread_vec(),
   method_vec()
 {}
@@ -451,6 +457,66 @@ sc_port_base::insert_parent( int i )
 }
 
 
+// depth of this port in the port hierarchy, 0 for ports without parents
+
+int
+sc_port_base::binding_level()
+{
+    if( m_bind_info->level < 0 ) {
+        int level = 0;
+        for( int i = 0; i < m_bind_info->size(); ++ i ) {
+            sc_port_base* parent = m_bind_info->vec[i]->parent;
+            if( parent != 0 ) {
+                level = std::max( level, parent->binding_level() + 1 );
+            }
+        }
+        m_bind_info->level = level;
+    }
+    return m_bind_info->level;
+}
+
+// resolves the binding to our parent ports in advance, which must have been
+// resolved before; may be called in parallel for the ports of one level
+
+void
+sc_port_base::resolve_binding()
+{
+    sc_assert( m_bind_info != 0 && !m_bind_info->complete );
+
+    // INSERT THE INTERFACES OF OUR PARENT PORTS, REMEMBERING THE PARENTS:
+
+    int i = first_parent();
+    while( i >= 0 ) {
+        m_bind_info->parents.push_back( m_bind_info->vec[i]->parent );
+        insert_parent( i );
+        i = first_parent();
+    }
+
+    // ADD (CACHE) THE INTERFACES:
+    //
+    // If an interface is bound twice, this is left to complete_binding,
+    // which reports the error.
+
+    std::vector<sc_interface*> ifaces;
+    for( int j = 0; j < m_bind_info->size(); ++ j ) {
+        if( m_bind_info->vec[j]->iface != 0 ) {
+            ifaces.push_back( m_bind_info->vec[j]->iface );
+        }
+    }
+    std::sort( ifaces.begin(), ifaces.end() );
+    if( std::adjacent_find( ifaces.begin(), ifaces.end() ) != ifaces.end() ) {
+        return;
+    }
+
+    for( int j = m_bind_info->last_add + 1; j < m_bind_info->size(); ++ j ) {
+        sc_interface* iface = m_bind_info->vec[j]->iface;
+        if( iface != 0 ) {
+            add_interface( iface );
+        }
+    }
+    m_bind_info->last_add = m_bind_info->size() - 1;
+}
+
 // called when elaboration is done
 
 void
@@ -464,6 +530,13 @@ sc_port_base::complete_binding()
     }
 
     // COMPLETE BINDING OF OUR PARENT PORTS SO THAT WE CAN USE THAT INFORMATION:
+    //
+    // If the binding has been resolved in advance, the parents are completed
+    // anyway, to keep the order of the interface registrations.
+
+    for( std::size_t k = 0; k < m_bind_info->parents.size(); ++ k ) {
+        m_bind_info->parents[k]->complete_binding();
+    }
 
     int i = first_parent();
     while( i >= 0 ) {
@@ -714,12 +787,43 @@ sc_port_registry::construction_done()
 void
 sc_port_registry::complete_binding()
 {
+    sc_worker_pool* pool = m_simc->elaboration_pool();
+    if( pool ) {
+        resolve_binding( *pool );
+    }
+
     for( int i = size() - 1; i >= 0; -- i ) {
         m_port_vec[i]->complete_binding();
     }
 }
 
 
+// resolves the hierarchical bindings in parallel, one level of the port
+// hierarchy after the other
+
+void
+sc_port_registry::resolve_binding( sc_worker_pool& pool )
+{
+    std::vector<std::vector<sc_port_base*> > levels;
+    for( int i = 0; i < size(); ++ i ) {
+        sc_port_base* port = m_port_vec[i];
+        if( port->m_bind_info->complete ) {
+            continue;
+        }
+        std::size_t level = port->binding_level();
+        if( level >= levels.size() ) {
+            levels.resize( level + 1 );
+        }
+        levels[level].push_back( port );
+    }
+
+    // the ports without parents have nothing to resolve
+    for( std::size_t level = 1; level < levels.size(); ++ level ) {
+        sc_worker_member_loop<sc_port_base>( levels[level],
+          &sc_port_base::resolve_binding ).execute( pool );
+    }
+}
+
 // called when elaboration is done
 
 void
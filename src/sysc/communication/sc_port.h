@@ -52,6 +52,7 @@ namespace sc_core {
 
 class sc_event_finder;
 class sc_port_base;
+class sc_worker_pool;
 
 struct sc_bind_info;
 
@@ -172,6 +173,8 @@ private:
     void construction_done();
 
     // called when elaboration is done
+    int binding_level();
+    void resolve_binding();
     void complete_binding();
     void elaboration_done();
 
@@ -226,6 +229,7 @@ private:
 
     // called when by construction_done and elaboration done
     void complete_binding();
+    void resolve_binding( sc_worker_pool& );
 
     // called when construction is done
     bool construction_done();
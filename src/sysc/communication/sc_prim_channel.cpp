@@ -53,7 +53,11 @@ namespace sc_core {
 sc_prim_channel::sc_prim_channel()
 : sc_object( 0 ),
   m_registry( simcontext()->get_prim_channel_registry() ),
-  m_update_next_p( 0 ) 
+  m_update_next_p( 0 ),
+  m_update_thread_safe( false ),
+  m_update_thread_safe_set( false ),
+  m_async_next_p( 0 ),
+  m_async_pending( 0 )
 {
     m_registry->insert( *this );
 }
@@ -61,7 +65,11 @@ sc_prim_channel::sc_prim_channel()
 sc_prim_channel::sc_prim_channel( const char* name_ )
 : sc_object( name_ ),
   m_registry( simcontext()->get_prim_channel_registry() ),
-  m_update_next_p( 0 )
+  m_update_next_p( 0 ),
+  m_update_thread_safe( false ),
+  m_update_thread_safe_set( false ),
+  m_async_next_p( 0 ),
+  m_async_pending( 0 )
 {
     m_registry->insert( *this );
 }
@@ -110,6 +118,11 @@ sc_prim_channel::elaboration_done()
 {
     sc_object::hierarchy_scope scope( get_parent_object() );
     end_of_elaboration();
+
+    if( !m_update_thread_safe_set ) {
+        const std::type_info* type_p = thread_safe_update_type();
+        m_update_thread_safe = type_p && *type_p == typeid( *this );
+    }
 }
 
 // called by start_simulation (does nothing)
@@ -147,13 +160,90 @@ sc_prim_channel::simulation_done()
 //
 //  Thread-safe list of pending external updates
 //  FOR INTERNAL USE ONLY!
+//
+//  Where the compiler provides the __atomic builtins, the channels are
+//  pushed onto a lock-free intrusive stack, linked by m_async_next_p.  A
+//  channel already in the stack is not pushed again (m_async_pending).
+//  The semaphore is posted only when the stack becomes non-empty, which
+//  wakes up a suspended simulation.  Otherwise, the list is guarded by a
+//  mutex.
 // ----------------------------------------------------------------------------
 
+#if !defined(SC_DISABLE_ASYNC_UPDATES) && defined(__ATOMIC_ACQUIRE)
+#  define SC_ASYNC_UPDATE_LIST_LOCK_FREE_
+#endif
+
 class sc_prim_channel_registry::async_update_list
 {
 #ifndef SC_DISABLE_ASYNC_UPDATES
 public:
 
+#ifdef SC_ASYNC_UPDATE_LIST_LOCK_FREE_
+
+    bool pending() const
+    {
+        return __atomic_load_n( &m_head, __ATOMIC_ACQUIRE ) != 0;
+    }
+
+    // A token may be left over from a stack emptied by accept_updates()
+    // before it was posted, so the stack is checked after each wake-up.
+
+    void suspend()
+    {
+        if( m_has_suspending_channels ) {
+            while( !pending() )
+                m_suspend_semaphore.wait();
+        }
+    }
+
+    void append( sc_prim_channel& prim_channel_ )
+    {
+        if( __atomic_exchange_n( &prim_channel_.m_async_pending, 1,
+                                 __ATOMIC_ACQ_REL ) )
+            return; // already pending
+
+        sc_prim_channel* head = __atomic_load_n( &m_head, __ATOMIC_RELAXED );
+        do {
+            prim_channel_.m_async_next_p = head;
+        } while( !__atomic_compare_exchange_n( &m_head, &head, &prim_channel_,
+                                               true, __ATOMIC_RELEASE,
+                                               __ATOMIC_RELAXED ) );
+        if( !head )
+            m_suspend_semaphore.post();
+    }
+
+    void accept_updates()
+    {
+        sc_prim_channel* list = __atomic_exchange_n( &m_head,
+                                   static_cast<sc_prim_channel*>(0),
+                                   __ATOMIC_ACQUIRE );
+        if( !list )
+            return;
+        m_suspend_semaphore.trywait(); // this must never block !
+
+        // restore the order of the requests
+        sc_prim_channel* fifo = 0;
+        while( list ) {
+            sc_prim_channel* next_p = list->m_async_next_p;
+            list->m_async_next_p = fifo;
+            fifo = list;
+            list = next_p;
+        }
+
+        while( fifo ) {
+            sc_prim_channel* next_p = fifo->m_async_next_p;
+            // the channel may be appended again from here on, the
+            // exchange makes the values written before visible
+            __atomic_exchange_n( &fifo->m_async_pending, 0, __ATOMIC_ACQ_REL );
+            // we use request_update instead of perform_update
+            // to skip duplicates
+            fifo->request_update();
+            fifo = next_p;
+        }
+    }
+
+#else // SC_ASYNC_UPDATE_LIST_LOCK_FREE_
+
     bool pending() const
     {
 	return m_push_queue.size() != 0;
@@ -197,6 +287,8 @@ public:
 	m_pop_queue.clear();
     }
 
+#endif // SC_ASYNC_UPDATE_LIST_LOCK_FREE_
+
     bool attach_suspending( sc_prim_channel& p )
     {
         sc_scoped_lock lock( m_mutex );
@@ -226,13 +318,21 @@ public:
         // return releases the mutex
     }
 
+#ifdef SC_ASYNC_UPDATE_LIST_LOCK_FREE_
+    async_update_list() : m_head(), m_has_suspending_channels() {}
+#else
     async_update_list() : m_has_suspending_channels() {}
+#endif
 
 private:
     sc_host_mutex                   m_mutex;
     sc_host_semaphore               m_suspend_semaphore;
+#ifdef SC_ASYNC_UPDATE_LIST_LOCK_FREE_
+    sc_prim_channel*                m_head; // most recent request.
+#else
     std::vector< sc_prim_channel* > m_push_queue;
     std::vector< sc_prim_channel* > m_pop_queue;
+#endif
     std::vector< sc_prim_channel* > m_suspending_channels;
     bool                            m_has_suspending_channels;
 
@@ -375,6 +475,8 @@ sc_prim_channel_registry::perform_update()
 
     now_p = m_update_list_p;
     m_update_list_p = (sc_prim_channel*)sc_prim_channel::list_end;
+    if ( m_simc->perform_parallel_update( now_p ) )
+        return;
     for ( ; now_p != (sc_prim_channel*)sc_prim_channel::list_end;
 	now_p = next_p )
     {
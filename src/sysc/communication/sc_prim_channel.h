@@ -33,6 +33,8 @@
 #include "sysc/kernel/sc_wait.h"
 #include "sysc/kernel/sc_wait_cthread.h"
 
+#include <typeinfo>
+
 namespace sc_core {
 
 // ----------------------------------------------------------------------------
@@ -45,6 +47,7 @@ class SC_API sc_prim_channel
 : public sc_object
 {
     friend class sc_prim_channel_registry;
+    friend class sc_simcontext;
 
 public:
     enum { list_end = 0xdb };
@@ -86,6 +89,19 @@ protected:
     // called by simulation_done (does nothing by default)
     virtual void end_of_simulation();
 
+    // may update() be executed in parallel with the updates of other
+    // channels? (it must only modify the state of this channel, other
+    // kernel actions like event notifications are deferred)
+    bool update_thread_safe() const { return m_update_thread_safe; }
+    void update_thread_safe( bool safe )
+        { m_update_thread_safe = safe; m_update_thread_safe_set = true; }
+
+    // the channel class whose update() is thread-safe, if any; unless set
+    // explicitly, update_thread_safe() is true after elaboration if this is
+    // the class of the channel, i.e., if no derived class overrides it
+    virtual const std::type_info* thread_safe_update_type() const
+        { return 0; }
+
     // indicate that this channel is async and could call async_request_update
     // therefore, the kernel should arrange to suspend rather than exit while
     // this channel is attached.
@@ -223,6 +239,10 @@ private:
 
     sc_prim_channel_registry* m_registry;          // Update list manager.
     sc_prim_channel*          m_update_next_p;     // Next entry in update list.
+    bool                      m_update_thread_safe; // Parallel update.
+    bool                      m_update_thread_safe_set; // Not by default.
+    sc_prim_channel*          m_async_next_p;      // Next entry in async list.
+    int                       m_async_pending;     // In the async list.
 };
 
 
@@ -323,6 +343,10 @@ inline
 void
 sc_prim_channel_registry::request_update( sc_prim_channel& prim_channel_ )
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_request_update( prim_channel_ );
+        return;
+    }
     prim_channel_.m_update_next_p = m_update_list_p;
     m_update_list_p = &prim_channel_;
 }
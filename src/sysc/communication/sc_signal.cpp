@@ -95,6 +95,8 @@ sc_writer_policy_check_port::
 
 sc_signal_channel::~sc_signal_channel()
 {
+    while( m_trace_hooks_p )
+        m_trace_hooks_p->detach();
     delete m_change_event_p;
 }
 
@@ -159,6 +161,43 @@ sc_signal_channel::do_update()
 {
     notify_next_delta( m_change_event_p );
     m_change_stamp = simcontext()->change_stamp();
+
+    for( sc_signal_trace_hook* h = m_trace_hooks_p; h; h = h->m_next_p ) {
+        if( SC_UNLIKELY_( simcontext()->in_parallel_evaluation() ) )
+            simcontext()->defer_value_changed( *h );
+        else
+            h->value_changed();
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_signal_trace_hook
+//
+//  An object informed about the value changes of a signal channel.
+// ----------------------------------------------------------------------------
+
+void
+sc_signal_trace_hook::attach( const sc_signal_channel& ch )
+{
+    detach();
+    m_channel_p = &ch;
+    m_next_p = ch.m_trace_hooks_p;
+    ch.m_trace_hooks_p = this;
+}
+
+void
+sc_signal_trace_hook::detach()
+{
+    if( !m_channel_p )
+        return;
+
+    sc_signal_trace_hook** h = &m_channel_p->m_trace_hooks_p;
+    while( *h != this )
+        h = &(*h)->m_next_p;
+    *h = m_next_p;
+
+    m_channel_p = 0;
+    m_next_p = 0;
 }
 
 // IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
@@ -180,7 +219,12 @@ sc_signal<bool,POL>::do_update()
     // order of execution below is important, the notify_processes() call
     // must come after the update of m_cur_val for things to work properly!
     base_type::do_update();
-    if ( m_reset_p ) m_reset_p->notify_processes();
+    if ( m_reset_p ) {
+        if( SC_UNLIKELY_( this->simcontext()->in_parallel_evaluation() ) )
+            this->simcontext()->defer_reset( *m_reset_p );
+        else
+            m_reset_p->notify_processes();
+    }
 
     sc_event* event_p = this->m_cur_val ? m_posedge_event_p : m_negedge_event_p;
     sc_signal_channel::notify_next_delta( event_p );
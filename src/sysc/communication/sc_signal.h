@@ -74,6 +74,51 @@ sc_writer_policy_check_write::update()
 }
 
 
+class sc_signal_channel;
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_signal_trace_hook (implementation-defined)
+//
+//  An object informed about the value changes of a signal channel.  Used
+//  by trace files to only check those traced signals for changes, which
+//  have actually been updated.
+// ----------------------------------------------------------------------------
+
+class SC_API sc_signal_trace_hook
+{
+    friend class sc_signal_channel;
+    friend class sc_simcontext;
+public:
+
+    // start/stop receiving value changes of the channel
+    void attach( const sc_signal_channel& );
+    void detach();
+
+    bool attached() const
+        { return m_channel_p != 0; }
+
+protected:
+
+    sc_signal_trace_hook()
+      : m_channel_p( 0 ), m_next_p( 0 )
+    {}
+
+    virtual ~sc_signal_trace_hook()
+        { detach(); }
+
+    // called from the update phase, when the value of the channel changed
+    virtual void value_changed() = 0;
+
+private:
+    const sc_signal_channel* m_channel_p;  // observed channel, if attached.
+    sc_signal_trace_hook*    m_next_p;     // next hook of the same channel.
+
+private:
+    // disabled
+    sc_signal_trace_hook( const sc_signal_trace_hook& ) /* = delete */;
+    sc_signal_trace_hook& operator=( const sc_signal_trace_hook& ) /* = delete */;
+};
+
 // ----------------------------------------------------------------------------
 //  CLASS : sc_signal_channel
 //
@@ -83,12 +128,14 @@ sc_writer_policy_check_write::update()
 class SC_API sc_signal_channel
   : public sc_prim_channel
 {
+    friend class sc_signal_trace_hook;
 protected:
 
     sc_signal_channel( const char* name_ )
       : sc_prim_channel( name_ )
       , m_change_event_p( 0 )
       , m_change_stamp( ~sc_dt::UINT64_ONE )
+      , m_trace_hooks_p( 0 )
     {}
 
 public:
@@ -128,6 +175,9 @@ protected:
     mutable sc_event* m_change_event_p;  // value change event if present.
     sc_dt::uint64     m_change_stamp;    // delta of last event
 
+private:
+    mutable sc_signal_trace_hook* m_trace_hooks_p; // change-driven tracing.
+
 private:
     // disabled
     sc_signal_channel( const sc_signal_channel& ) /* = delete */;
@@ -258,6 +308,9 @@ protected:
     virtual void update();
             void do_update();
 
+    virtual const std::type_info* thread_safe_update_type() const
+        { return &typeid( sc_signal<T,POL> ); }
+
 protected:
     T m_cur_val;         // current value of object.
     T m_new_val;         // next value of object.
@@ -54,7 +54,7 @@ sc_in<bool>::end_of_elaboration()
 	for( int i = 0; i < (int)m_traces->size(); ++ i ) {
 	    sc_trace_params* p = (*m_traces)[i];
 	    in_if_type* iface = dynamic_cast<in_if_type*>( get_interface() );
-	    sc_trace( p->tf, iface->read(), p->name );
+	    sc_trace( p->tf, *iface, p->name );
 	}
 	remove_traces();
     }
@@ -136,7 +136,7 @@ sc_in<sc_dt::sc_logic>::end_of_elaboration()
 	for( int i = 0; i < (int)m_traces->size(); ++ i ) {
 	    sc_trace_params* p = (*m_traces)[i];
 	    in_if_type* iface = dynamic_cast<in_if_type*>( get_interface() );
-	    sc_trace( p->tf, iface->read(), p->name );
+	    sc_trace( p->tf, *iface, p->name );
 	}
 	remove_traces();
     }
@@ -253,7 +253,7 @@ sc_inout<bool>::end_of_elaboration()
 	for( int i = 0; i < (int)m_traces->size(); ++ i ) {
 	    sc_trace_params* p = (*m_traces)[i];
 	    in_if_type* iface = dynamic_cast<in_if_type*>( get_interface() );
-	    sc_trace( p->tf, iface->read(), p->name );
+	    sc_trace( p->tf, *iface, p->name );
 	}
 	remove_traces();
     }
@@ -344,7 +344,7 @@ sc_inout<sc_dt::sc_logic>::end_of_elaboration()
 	for( int i = 0; i < (int)m_traces->size(); ++ i ) {
 	    sc_trace_params* p = (*m_traces)[i];
 	    in_if_type* iface = dynamic_cast<in_if_type*>( get_interface() );
-	    sc_trace( p->tf, iface->read(), p->name );
+	    sc_trace( p->tf, *iface, p->name );
 	}
 	remove_traces();
     }
@@ -36,6 +36,9 @@
 #include "sysc/kernel/sc_process_handle.h"
 #include "sysc/communication/sc_signal_resolved.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace sc_core {
 
 // Note that we assume that two drivers driving the resolved signal to a 1 or
@@ -95,22 +98,22 @@ sc_signal_resolved::write( const value_type& value_ )
     sc_process_b* cur_proc = sc_get_current_process_b();
 
     bool value_changed = false;
-    bool found = false;
-    
-    for( int i = m_proc_vec.size() - 1; i >= 0; -- i ) {
-	if( cur_proc == m_proc_vec[i] ) {
-	    if( value_ != m_val_vec[i] ) {
-		m_val_vec[i] = value_;
-		value_changed = true;
-	    }
-	    found = true;
-	    break;
+
+    // the drivers are kept sorted by process, as the resolution does
+    // not depend on their order
+    std::vector<sc_process_b*>::iterator it =
+      std::lower_bound( m_proc_vec.begin(), m_proc_vec.end(), cur_proc,
+                        std::less<sc_process_b*>() );
+    int i = it - m_proc_vec.begin();
+
+    if( it != m_proc_vec.end() && *it == cur_proc ) {
+	if( value_ != m_val_vec[i] ) {
+	    m_val_vec[i] = value_;
+	    value_changed = true;
 	}
-    }
-    
-    if( ! found ) {
-	m_proc_vec.push_back( cur_proc );
-	m_val_vec.push_back( value_ );
+    } else {
+	m_proc_vec.insert( it, cur_proc );
+	m_val_vec.insert( m_val_vec.begin() + i, value_ );
 	value_changed = true;
     }
     
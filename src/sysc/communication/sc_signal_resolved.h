@@ -109,6 +109,9 @@ public:
 protected:
     virtual void update();
 
+    virtual const std::type_info* thread_safe_update_type() const
+        { return &typeid( this_type ); }
+
 protected:
     std::vector<sc_process_b*> m_proc_vec; // processes writing this signal
     std::vector<value_type>    m_val_vec;  // new values written this signal
@@ -32,6 +32,9 @@
 #include "sysc/communication/sc_signal.h"
 #include "sysc/datatypes/bit/sc_lv.h"
 
+#include <algorithm>
+#include <functional>
+
 namespace sc_core {
 
 class sc_process_b;
@@ -74,13 +77,26 @@ sc_lv_resolve<W>::resolve( sc_dt::sc_lv<W>& result_,
 	return;
     }
 
-    for( int j = result_.length() - 1; j >= 0; -- j ) {
-	sc_dt::sc_logic_value_t res = (*values_[0])[j].value();
-	for( int i = sz - 1; i > 0 && res != 3; -- i ) {
-	    res = sc_logic_resolution_tbl[res][(*values_[i])[j].value()];
+    // Resolve a word of bits at a time on the data and control words
+    // (0 = 00, 1 = 10, Z = 01, X = 11): a bit is X, if a driver drives
+    // X or the drivers drive both 0 and 1, otherwise it is the value of
+    // the drivers not driving Z.
+    for( int wi = result_.size() - 1; wi >= 0; -- wi ) {
+	sc_dt::sc_digit any_0 = 0;
+	sc_dt::sc_digit any_1 = 0;
+	sc_dt::sc_digit any_x = 0;
+	for( int i = sz - 1; i >= 0; -- i ) {
+	    sc_dt::sc_digit d = values_[i]->get_word( wi );
+	    sc_dt::sc_digit c = values_[i]->get_cword( wi );
+	    any_0 |= ~( d | c );
+	    any_1 |= d & ~c;
+	    any_x |= d & c;
 	}
-	result_[j] = res;
+	any_x |= any_0 & any_1;
+	result_.set_word( wi, any_x | any_1 );
+	result_.set_cword( wi, any_x | ~( any_0 | any_1 ) );
     }
+    result_.clean_tail();
 }
 
 
@@ -152,6 +168,9 @@ protected:
 
     virtual void update();
 
+    virtual const std::type_info* thread_safe_update_type() const
+        { return &typeid( this_type ); }
+
 protected:
 
     std::vector<sc_process_b*> m_proc_vec; // processes writing this signal
@@ -189,22 +208,22 @@ sc_signal_rv<W>::write( const value_type& value_ )
     sc_process_b* cur_proc = sc_get_current_process_b();
 
     bool value_changed = false;
-    bool found = false;
-    
-    for( int i = m_proc_vec.size() - 1; i >= 0; -- i ) {
-	if( cur_proc == m_proc_vec[i] ) {
-	    if( value_ != *m_val_vec[i] ) {
-		*m_val_vec[i] = value_;
-		value_changed = true;
-	    }
-	    found = true;
-	    break;
+
+    // the drivers are kept sorted by process, as the resolution does
+    // not depend on their order
+    std::vector<sc_process_b*>::iterator it =
+      std::lower_bound( m_proc_vec.begin(), m_proc_vec.end(), cur_proc,
+                        std::less<sc_process_b*>() );
+    int i = it - m_proc_vec.begin();
+
+    if( it != m_proc_vec.end() && *it == cur_proc ) {
+	if( value_ != *m_val_vec[i] ) {
+	    *m_val_vec[i] = value_;
+	    value_changed = true;
 	}
-    }
-    
-    if( ! found ) {
-	m_proc_vec.push_back( cur_proc );
-	m_val_vec.push_back( new value_type( value_ ) );
+    } else {
+	m_proc_vec.insert( it, cur_proc );
+	m_val_vec.insert( m_val_vec.begin() + i, new value_type( value_ ) );
 	value_changed = true;
     }
     
@@ -77,6 +77,7 @@ class SC_API sc_bv_base
     : public sc_proxy<sc_bv_base>
 {
     friend class sc_lv_base;
+    friend struct sc_word_access_<sc_bv_base>;
 
 
     void init( int length_, bool init_value = false );
@@ -226,6 +227,15 @@ protected:
 };
 
 
+template <>
+struct sc_word_access_<sc_bv_base>
+{
+    enum { contiguous = 1 };
+    static sc_digit* data( const sc_bv_base& x ) { return x.m_data; }
+    static sc_digit* ctrl( const sc_bv_base& ) { return 0; }
+};
+
+
 // IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
 
 #if 0
@@ -51,8 +51,16 @@
 #include "sysc/datatypes/bit/sc_bit_ids.h"
 #include "sysc/datatypes/bit/sc_lv_base.h"
 
+#include <cstring>
 #include <sstream>
 
+// Word kernels for AVX2 and AVX-512 are compiled with GCC on x86, and
+// selected at run-time if the processor supports them.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    ( defined(__x86_64__) || defined(__i386__) )
+#   define SC_WORD_KERNELS_X86_
+#endif
+
 namespace sc_dt {
 
 // explicit template instantiations
@@ -69,6 +77,151 @@ SC_API void sc_proxy_out_of_bounds(const char* msg, int64 val)
     SC_REPORT_ERROR( sc_core::SC_ID_OUT_OF_BOUNDS_, ss.str().c_str() );
 }
 
+// ----------------------------------------------------------------------------
+//  SECTION : Word kernels
+//
+//  The loops of the bitwise operators, shifts and reductions of sc_lv_base
+//  and sc_bv_base, on 64-bit words or, where supported, on 256-bit (AVX2)
+//  or 512-bit (AVX-512) vectors.
+// ----------------------------------------------------------------------------
+
+namespace {
+
+struct sc_word_summary
+{
+    bool any_0;
+    bool any_1;
+    bool any_xz;
+    bool parity;
+};
+
+struct sc_word_kernels
+{
+    void (*op_assign)( sc_word_op, int, sc_digit*, sc_digit*,
+		       const sc_digit*, const sc_digit* );
+    void (*b_not)( int, sc_digit*, const sc_digit* );
+    void (*shift_left)( int, sc_digit*, int );
+    void (*shift_right)( int, sc_digit*, int );
+    void (*scan)( int, const sc_digit*, const sc_digit*, sc_word_summary& );
+};
+
+namespace sc_word_generic {
+#if defined(__GNUC__)
+    typedef sc_digit word_type __attribute__(( vector_size( 8 ) ));
+#else
+    typedef sc_digit word_type;
+#endif
+#   include "sysc/datatypes/bit/sc_word_kernels.inc"
+} // namespace sc_word_generic
+
+#if defined(SC_WORD_KERNELS_X86_)
+
+#pragma GCC push_options
+#pragma GCC target( "avx2" )
+namespace sc_word_avx2 {
+    typedef sc_digit word_type __attribute__(( vector_size( 32 ) ));
+#   include "sysc/datatypes/bit/sc_word_kernels.inc"
+} // namespace sc_word_avx2
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target( "avx512f" )
+namespace sc_word_avx512 {
+    typedef sc_digit word_type __attribute__(( vector_size( 64 ) ));
+#   include "sysc/datatypes/bit/sc_word_kernels.inc"
+} // namespace sc_word_avx512
+#pragma GCC pop_options
+
+#endif // SC_WORD_KERNELS_X86_
+
+#define SC_WORD_KERNELS_( isa )                                               \
+    { &isa::op_assign, &isa::b_not, &isa::shift_left, &isa::shift_right,     \
+      &isa::scan }
+
+const sc_word_kernels*
+select_word_kernels()
+{
+    static const sc_word_kernels generic = SC_WORD_KERNELS_( sc_word_generic );
+#if defined(SC_WORD_KERNELS_X86_)
+    static const sc_word_kernels avx2 = SC_WORD_KERNELS_( sc_word_avx2 );
+    static const sc_word_kernels avx512 = SC_WORD_KERNELS_( sc_word_avx512 );
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports( "avx512f" ) )
+	return &avx512;
+    if( __builtin_cpu_supports( "avx2" ) )
+	return &avx2;
+#endif
+    return &generic;
+}
+
+#undef SC_WORD_KERNELS_
+
+// selected on the first use; concurrent first uses select the same kernels
+const sc_word_kernels* word_kernels = 0;
+
+inline const sc_word_kernels&
+kernels()
+{
+    if( !word_kernels )
+	word_kernels = select_word_kernels();
+    return *word_kernels;
+}
+
+} // namespace
+
+void
+sc_word_assign( int n, sc_digit* x_dw, sc_digit* x_cw,
+		const sc_digit* y_dw, const sc_digit* y_cw )
+{
+    std::memcpy( x_dw, y_dw, n * sizeof( sc_digit ) );
+    if( x_cw && y_cw )
+	std::memcpy( x_cw, y_cw, n * sizeof( sc_digit ) );
+    else if( x_cw )
+	std::memset( x_cw, 0, n * sizeof( sc_digit ) );
+}
+
+void
+sc_word_op_assign( sc_word_op op, int n, sc_digit* x_dw, sc_digit* x_cw,
+		   const sc_digit* y_dw, const sc_digit* y_cw )
+{
+    kernels().op_assign( op, n, x_dw, x_cw, y_dw, y_cw );
+}
+
+void
+sc_word_not( int n, sc_digit* x_dw, const sc_digit* x_cw )
+{
+    kernels().b_not( n, x_dw, x_cw );
+}
+
+void
+sc_word_shift_left( int n, sc_digit* w, int shift )
+{
+    kernels().shift_left( n, w, shift );
+}
+
+void
+sc_word_shift_right( int n, sc_digit* w, int shift )
+{
+    kernels().shift_right( n, w, shift );
+}
+
+sc_logic_value_t
+sc_word_reduce( sc_word_op op, int len, const sc_digit* x_dw,
+		const sc_digit* x_cw )
+{
+    sc_word_summary s;
+    kernels().scan( len, x_dw, x_cw, s );
+    switch( op ) {
+    case SC_WORD_AND:
+	return s.any_0 ? Log_0 : s.any_xz ? Log_X : Log_1;
+    case SC_WORD_OR:
+	return s.any_1 ? Log_1 : s.any_xz ? Log_X : Log_0;
+    default:
+	return s.any_xz ? Log_X : s.parity ? Log_1 : Log_0;
+    }
+}
+
+
 // ----------------------------------------------------------------------------
 //  CLASS : sc_lv_base
 //
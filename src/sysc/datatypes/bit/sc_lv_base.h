@@ -88,6 +88,7 @@ class SC_API sc_lv_base
     : public sc_proxy<sc_lv_base>
 {
     friend class sc_bv_base;
+    friend struct sc_word_access_<sc_lv_base>;
 
 
     void init( int length_, const sc_logic& init_value = SC_LOGIC_X );
@@ -242,6 +243,15 @@ protected:
 };
 
 
+template <>
+struct sc_word_access_<sc_lv_base>
+{
+    enum { contiguous = 1 };
+    static sc_digit* data( const sc_lv_base& x ) { return x.m_data; }
+    static sc_digit* ctrl( const sc_lv_base& x ) { return x.m_ctrl; }
+};
+
+
 // IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
 
 #if 0
@@ -338,8 +348,13 @@ X&
 operator &= ( sc_proxy<X>& px, const sc_proxy<Y>& py )
 {
     X& x = px.back_cast();
+    const Y& y = py.back_cast();
+    if( sc_word_access_<X>::contiguous && sc_word_access_<Y>::contiguous &&
+	x.length() == y.length() ) {
+	return b_and_assign_( x, y ); // elementwise, even if x and y are the same
+    }
     sc_lv_base a( x.length() );
-    a = py.back_cast();
+    a = y;
     return b_and_assign_( x, a );
 }
 
@@ -440,8 +455,13 @@ X&
 operator |= ( sc_proxy<X>& px, const sc_proxy<Y>& py )
 {
     X& x = px.back_cast();
+    const Y& y = py.back_cast();
+    if( sc_word_access_<X>::contiguous && sc_word_access_<Y>::contiguous &&
+	x.length() == y.length() ) {
+	return b_or_assign_( x, y ); // elementwise, even if x and y are the same
+    }
     sc_lv_base a( x.length() );
-    a = py.back_cast();
+    a = y;
     return b_or_assign_( x, a );
 }
 
@@ -542,8 +562,13 @@ X&
 operator ^= ( sc_proxy<X>& px, const sc_proxy<Y>& py )
 {
     X& x = px.back_cast();
+    const Y& y = py.back_cast();
+    if( sc_word_access_<X>::contiguous && sc_word_access_<Y>::contiguous &&
+	x.length() == y.length() ) {
+	return b_xor_assign_( x, y ); // elementwise, even if x and y are the same
+    }
     sc_lv_base a( x.length() );
-    a = py.back_cast();
+    a = y;
     return b_xor_assign_( x, a );
 }
 
@@ -98,6 +98,37 @@ const sc_digit SC_DIGIT_TWO  = (sc_digit)2;
 
 SC_API void sc_proxy_out_of_bounds(const char* msg = NULL, int64 val = 0);
 
+// word kernels for the data and control words of sc_lv_base and sc_bv_base
+// (see sc_lv_base.cpp); a null control word array stands for a bit vector
+
+enum sc_word_op { SC_WORD_AND, SC_WORD_OR, SC_WORD_XOR };
+
+// smaller vectors are processed inline, except in reductions
+const int SC_WORD_KERNEL_MIN_SIZE = 8;
+
+SC_API void sc_word_assign( int n, sc_digit* x_dw, sc_digit* x_cw,
+                            const sc_digit* y_dw, const sc_digit* y_cw );
+SC_API void sc_word_op_assign( sc_word_op op, int n,
+                               sc_digit* x_dw, sc_digit* x_cw,
+                               const sc_digit* y_dw, const sc_digit* y_cw );
+SC_API void sc_word_not( int n, sc_digit* x_dw, const sc_digit* x_cw );
+SC_API void sc_word_shift_left( int n, sc_digit* w, int shift );
+SC_API void sc_word_shift_right( int n, sc_digit* w, int shift );
+SC_API sc_logic_value_t sc_word_reduce( sc_word_op op, int len,
+                                        const sc_digit* x_dw,
+                                        const sc_digit* x_cw );
+
+// access to the word arrays of a vector, if it has contiguous ones
+// (specialized for sc_lv_base and sc_bv_base)
+
+template <class X>
+struct sc_word_access_
+{
+    enum { contiguous = 0 };
+    static sc_digit* data( const X& ) { return 0; }
+    static sc_digit* ctrl( const X& ) { return 0; }
+};
+
 // assignment functions; forward declarations
 
 template <class X, class Y>
@@ -746,6 +777,16 @@ assign_p_( sc_proxy<X>& px, const sc_proxy<Y>& py )
 	X& x = px.back_cast();
 	const Y& y = py.back_cast();
 	int sz = x.size();
+	if( sc_word_access_<X>::contiguous && sc_word_access_<Y>::contiguous &&
+	    sz >= SC_WORD_KERNEL_MIN_SIZE && sz == y.size() &&
+	    ( sc_word_access_<X>::ctrl( x ) || !sc_word_access_<Y>::ctrl( y ) ) ) {
+	    sc_word_assign( sz, sc_word_access_<X>::data( x ),
+			    sc_word_access_<X>::ctrl( x ),
+			    sc_word_access_<Y>::data( y ),
+			    sc_word_access_<Y>::ctrl( y ) );
+	    x.clean_tail();
+	    return;
+	}
 	int min_sz = sc_min( sz, y.size() );
 	int i = 0;
 	for( ; i < min_sz; ++ i ) {
@@ -1039,6 +1080,28 @@ sc_proxy<X>::assign_( int64 a )
 
 // bitwise operators and functions
 
+// applies a word kernel if both vectors have contiguous word arrays
+
+template <class X, class Y>
+inline
+bool
+word_op_assign_( X& x, const Y& y, sc_word_op op )
+{
+    if( !sc_word_access_<X>::contiguous || !sc_word_access_<Y>::contiguous ||
+	x.size() < SC_WORD_KERNEL_MIN_SIZE ) {
+	return false;
+    }
+    sc_digit* x_cw = sc_word_access_<X>::ctrl( x );
+    const sc_digit* y_cw = sc_word_access_<Y>::ctrl( y );
+    if( x_cw == 0 && y_cw != 0 ) {
+	return false; // X and Z into a bit vector: warn in the generic loop
+    }
+    sc_word_op_assign( op, x.size(), sc_word_access_<X>::data( x ), x_cw,
+		       sc_word_access_<Y>::data( y ), y_cw );
+    return true;
+}
+
+
 // bitwise complement
 
 template <class X>
@@ -1048,10 +1111,15 @@ sc_proxy<X>::b_not()
 {
     X& x = back_cast();
     int sz = x.size();
-    for( int i = 0; i < sz; ++ i ) {
-	sc_digit x_dw, x_cw;
-	get_words_( x, i, x_dw, x_cw );
-	x.set_word( i, x_cw | ~x_dw );
+    if( sc_word_access_<X>::contiguous && sz >= SC_WORD_KERNEL_MIN_SIZE ) {
+	sc_word_not( sz, sc_word_access_<X>::data( x ),
+		     sc_word_access_<X>::ctrl( x ) );
+    } else {
+	for( int i = 0; i < sz; ++ i ) {
+	    sc_digit x_dw, x_cw;
+	    get_words_( x, i, x_dw, x_cw );
+	    x.set_word( i, x_cw | ~x_dw );
+	}
     }
     x.clean_tail();
     return x;
@@ -1068,6 +1136,9 @@ b_and_assign_( sc_proxy<X>& px, const sc_proxy<Y>& py )
     X& x = px.back_cast();
     const Y& y = py.back_cast();
     sc_assert( x.length() == y.length() );
+    if( word_op_assign_( x, y, SC_WORD_AND ) ) {
+	return x;
+    }
     int sz = x.size();
     for( int i = 0; i < sz; ++ i ) {
 	sc_digit x_dw, x_cw, y_dw, y_cw;
@@ -1092,6 +1163,9 @@ b_or_assign_( sc_proxy<X>& px, const sc_proxy<Y>& py )
     X& x = px.back_cast();
     const Y& y = py.back_cast();
     sc_assert( x.length() == y.length() );
+    if( word_op_assign_( x, y, SC_WORD_OR ) ) {
+	return x;
+    }
     int sz = x.size();
     for( int i = 0; i < sz; ++ i ) {
 	sc_digit x_dw, x_cw, y_dw, y_cw;
@@ -1116,6 +1190,9 @@ b_xor_assign_( sc_proxy<X>& a, const sc_proxy<Y>& b )
     X& x = a.back_cast();
     const Y& y = b.back_cast();
     sc_assert( x.length() == y.length() );
+    if( word_op_assign_( x, y, SC_WORD_XOR ) ) {
+	return x;
+    }
     int sz = x.size();
     for( int i = 0; i < sz; ++ i ) {
 	sc_digit x_dw, x_cw, y_dw, y_cw;
@@ -1149,6 +1226,14 @@ sc_proxy<X>::operator <<= ( int n )
 	return x;
     }
     int sz = x.size();
+    if( sc_word_access_<X>::contiguous && sz >= SC_WORD_KERNEL_MIN_SIZE ) {
+	sc_word_shift_left( sz, sc_word_access_<X>::data( x ), n );
+	if( sc_word_access_<X>::ctrl( x ) ) {
+	    sc_word_shift_left( sz, sc_word_access_<X>::ctrl( x ), n );
+	}
+	x.clean_tail();
+	return x;
+    }
     int wn = n / SC_DIGIT_SIZE;
     int bn = n % SC_DIGIT_SIZE;
     if( wn != 0 ) {
@@ -1203,6 +1288,14 @@ sc_proxy<X>::operator >>= ( int n )
 	return x;
     }
     int sz = x.size();
+    if( sc_word_access_<X>::contiguous && sz >= SC_WORD_KERNEL_MIN_SIZE ) {
+	sc_word_shift_right( sz, sc_word_access_<X>::data( x ), n );
+	if( sc_word_access_<X>::ctrl( x ) ) {
+	    sc_word_shift_right( sz, sc_word_access_<X>::ctrl( x ), n );
+	}
+	x.clean_tail();
+	return x;
+    }
     int wn = n / SC_DIGIT_SIZE;
     int bn = n % SC_DIGIT_SIZE;
     if( wn != 0 ) {
@@ -1285,6 +1378,11 @@ typename sc_proxy<X>::value_type
 sc_proxy<X>::and_reduce() const
 {
     const X& x = back_cast();
+    if( sc_word_access_<X>::contiguous ) {
+	return value_type( sc_word_reduce( SC_WORD_AND, x.length(),
+					   sc_word_access_<X>::data( x ),
+					   sc_word_access_<X>::ctrl( x ) ) );
+    }
     value_type result = value_type( 1 );
     int len = x.length();
     for( int i = 0; i < len; ++ i ) {
@@ -1299,6 +1397,11 @@ typename sc_proxy<X>::value_type
 sc_proxy<X>::or_reduce() const
 {
     const X& x = back_cast();
+    if( sc_word_access_<X>::contiguous ) {
+	return value_type( sc_word_reduce( SC_WORD_OR, x.length(),
+					   sc_word_access_<X>::data( x ),
+					   sc_word_access_<X>::ctrl( x ) ) );
+    }
     value_type result = value_type( 0 );
     int len = x.length();
     for( int i = 0; i < len; ++ i ) {
@@ -1313,6 +1416,11 @@ typename sc_proxy<X>::value_type
 sc_proxy<X>::xor_reduce() const
 {
     const X& x = back_cast();
+    if( sc_word_access_<X>::contiguous ) {
+	return value_type( sc_word_reduce( SC_WORD_XOR, x.length(),
+					   sc_word_access_<X>::data( x ),
+					   sc_word_access_<X>::ctrl( x ) ) );
+    }
     value_type result = value_type( 0 );
     int len = x.length();
     for( int i = 0; i < len; ++ i ) {
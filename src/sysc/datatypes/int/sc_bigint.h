@@ -85,97 +85,98 @@ template< int W = SC_MAX_NBITS >
 template< int W >
 #endif
 class sc_bigint
-    : public sc_signed
+    : private sc_big_digits< DIV_CEIL(W) >
+    , public sc_signed
 {
 public:
 
     // constructors
 
     sc_bigint()
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{}
 
     sc_bigint( const sc_bigint<W>& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_signed& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_signed_subref& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     template< class T >
     sc_bigint( const sc_generic_base<T>& a )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ a->to_sc_signed(*this); }
 
     sc_bigint( const sc_unsigned& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_unsigned_subref& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( const char* v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( int64 v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( uint64 v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( long v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( unsigned long v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( int v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( unsigned int v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( double v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
   
     sc_bigint( const sc_bv_base& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     sc_bigint( const sc_lv_base& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
 #ifdef SC_INCLUDE_FX
 
     explicit sc_bigint( const sc_fxval& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     explicit sc_bigint( const sc_fxval_fast& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     explicit sc_bigint( const sc_fxnum& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
     explicit sc_bigint( const sc_fxnum_fast& v )
-	: sc_signed( W )
+	: sc_signed( W, this->big_digits() )
 	{ *this = v; }
 
 #endif
@@ -85,97 +85,98 @@ template< int W = SC_MAX_NBITS >
 template< int W >
 #endif
 class sc_biguint
-    : public sc_unsigned
+    : private sc_big_digits< DIV_CEIL(W+1) >
+    , public sc_unsigned
 {
 public:
 
     // constructors
 
     sc_biguint()
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{}
 
     sc_biguint( const sc_biguint<W>& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_unsigned& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_unsigned_subref& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     template< class T >
     sc_biguint( const sc_generic_base<T>& a )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ a->to_sc_unsigned(*this); }
 
     sc_biguint( const sc_signed& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_signed_subref& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( const char* v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; } 
 
     sc_biguint( int64 v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( uint64 v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( long v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( unsigned long v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( int v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; } 
 
     sc_biguint( unsigned int v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( double v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
   
     sc_biguint( const sc_bv_base& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     sc_biguint( const sc_lv_base& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
 #ifdef SC_INCLUDE_FX
 
     explicit sc_biguint( const sc_fxval& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     explicit sc_biguint( const sc_fxval_fast& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     explicit sc_biguint( const sc_fxnum& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
     explicit sc_biguint( const sc_fxnum_fast& v )
-	: sc_unsigned( W )
+	: sc_unsigned( W, this->big_digits() )
 	{ *this = v; }
 
 #endif
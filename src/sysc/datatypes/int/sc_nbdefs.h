@@ -163,6 +163,12 @@ static const int MAX_NDIGITS = DIV_CEIL(SC_MAX_NBITS) + 2;
 // DIV_CEIL(y) <= DIV_CEIL(SC_MAX_NBITS) + 2. This is the reason for +2
 // above. With this change, MAX_NDIGITS must be enough to hold the
 // result of any operation.
+#else
+// Number of digits kept inside every sc_signed and sc_unsigned object,
+// enough for sc_biguint<512>. Values that fit never touch the heap;
+// wider values are allocated with new unless they belong to an
+// sc_bigint/sc_biguint, which carry their own storage.
+static const int SC_BASE_VEC_DIGITS = DIV_CEIL(512 + 1);
 #endif
 
 // Support for "digit" vectors used to hold the values of sc_signed,
@@ -170,7 +170,7 @@ mul_on_help_signed(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
   
     vec_zero(nd, d);
@@ -189,10 +189,6 @@ mul_on_help_signed(small_type &us,
     
     COPY_DIGITS(us, unb, old_und, ud, unb + vnb, nd, d);
     
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-    
   }
 
 #undef COPY_DIGITS
@@ -245,7 +241,7 @@ mul_on_help_unsigned(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
   
     vec_zero(nd, d);
@@ -264,10 +260,6 @@ mul_on_help_unsigned(small_type &us,
     
     COPY_DIGITS(us, unb, old_und, ud, unb + vnb, nd, d);
     
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-    
   }
 
 #undef COPY_DIGITS
@@ -318,7 +310,7 @@ div_on_help_signed(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS + 1];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
     
     vec_zero(nd, d);
@@ -338,10 +330,6 @@ div_on_help_signed(small_type &us,
     
     COPY_DIGITS(us, unb, old_und, ud, sc_max(unb, vnb), nd - 1, d);
     
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-    
   }
   
 #undef COPY_DIGITS
@@ -388,7 +376,7 @@ div_on_help_unsigned(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS + 1];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
     
     vec_zero(nd, d);
@@ -408,10 +396,6 @@ div_on_help_unsigned(small_type &us,
     
     COPY_DIGITS(us, unb, old_und, ud, sc_max(unb, vnb), nd - 1, d);
     
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-    
   }
   
 #undef COPY_DIGITS
@@ -470,7 +454,7 @@ mod_on_help_signed(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS + 1];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
     
     vec_zero(nd, d);
@@ -491,10 +475,6 @@ mod_on_help_signed(small_type &us,
     else
       COPY_DIGITS(us, unb, old_und, ud, sc_min(unb, vnd), nd - 1, d);
     
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-    
   }
   
 #undef COPY_DIGITS
@@ -548,7 +528,7 @@ mod_on_help_unsigned(small_type &us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS + 1];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
     
     vec_zero(nd, d);
@@ -569,10 +549,6 @@ mod_on_help_unsigned(small_type &us,
     else
       COPY_DIGITS(us, unb, old_und, ud, sc_min(unb, vnd), nd - 1, d);
     
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-    
   }
   
 #undef COPY_DIGITS
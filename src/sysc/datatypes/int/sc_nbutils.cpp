@@ -1016,6 +1016,245 @@ vec_sub_small_on(int ulen, sc_digit *u, sc_digit v)
 
 }
 
+#ifdef SC_ENABLE_64BIT_LIMBS
+
+// ----------------------------------------------------------------------------
+//  SECTION: Limb arithmetic.
+//
+//  The digits only hold BITS_PER_DIGIT bits each. For the quadratic
+//  operations, i.e., multiplication and long division, the operands are
+//  repacked into full 64-bit limbs (32-bit limbs if the compiler has no
+//  128-bit integer type), which need less steps and no masking of the
+//  carries. The digit representation itself is not changed.
+// ----------------------------------------------------------------------------
+
+#if defined(__SIZEOF_INT128__)
+typedef uint64 sc_limb;
+__extension__ typedef unsigned __int128 sc_dlimb;
+#else
+typedef unsigned int sc_limb;
+typedef uint64 sc_dlimb;
+#endif
+
+static const int BITS_PER_LIMB = 8 * sizeof(sc_limb);
+
+// Number of limbs needed for ulen digits.
+static inline int
+limb_len(int ulen)
+{
+  return DIV_CEIL2(ulen * BITS_PER_DIGIT, BITS_PER_LIMB);
+}
+
+// Set (sc_limb) x = (sc_digit) u. Return the length of x without the
+// leading zeros.
+static int
+limb_pack(int ulen, const sc_digit *u, sc_limb *x)
+{
+  int xlen = 0;
+  int nbits = 0;
+  sc_limb acc = 0;
+
+  for (int i = 0; i < ulen; ++i) {
+    sc_limb d = u[i] & DIGIT_MASK;
+    acc |= d << nbits;
+    nbits += BITS_PER_DIGIT;
+    if (nbits >= BITS_PER_LIMB) {
+      x[xlen++] = acc;
+      nbits -= BITS_PER_LIMB;
+      acc = nbits ? d >> (BITS_PER_DIGIT - nbits) : 0;
+    }
+  }
+
+  if (nbits)
+    x[xlen++] = acc;
+
+  while ((xlen > 0) && (x[xlen - 1] == 0))
+    --xlen;
+
+  return xlen;
+}
+
+// Set (sc_digit) w = (sc_limb) x, filling all wlen digits of w.
+static void
+limb_unpack(int xlen, const sc_limb *x, int wlen, sc_digit *w)
+{
+  for (int i = 0, pos = 0; i < wlen; ++i, pos += BITS_PER_DIGIT) {
+    int k = pos / BITS_PER_LIMB;
+    int off = pos % BITS_PER_LIMB;
+    sc_limb d = (k < xlen) ? (x[k] >> off) : 0;
+    if ((off > BITS_PER_LIMB - BITS_PER_DIGIT) && (k + 1 < xlen))
+      d |= x[k + 1] << (BITS_PER_LIMB - off);
+    w[i] = (sc_digit) (d & DIGIT_MASK);
+  }
+}
+
+// Compute z = x * y, where z has xlen + ylen limbs.
+static void
+limb_mul(int xlen, const sc_limb *x, int ylen, const sc_limb *y, sc_limb *z)
+{
+  for (int i = 0; i < ylen; ++i)
+    z[i] = 0;
+
+  for (int i = 0; i < xlen; ++i) {
+    sc_limb carry = 0;
+    for (int j = 0; j < ylen; ++j) {
+      sc_dlimb t = (sc_dlimb) x[i] * y[j] + z[i + j] + carry;
+      z[i + j] = (sc_limb) t;
+      carry = (sc_limb) (t >> BITS_PER_LIMB);
+    }
+    z[i + ylen] = carry;
+  }
+}
+
+// Compute q = x / y and r = x % y (Knuth, TAOCP Vol. 2, Algorithm D).
+// - xlen >= ylen > 0 and y[ylen - 1] != 0.
+// - q has xlen - ylen + 1 limbs and r has ylen limbs; either may be null.
+static void
+limb_div(int xlen, const sc_limb *x, int ylen, const sc_limb *y,
+         sc_limb *q, sc_limb *r)
+{
+  if (ylen == 1) {
+    sc_dlimb rem = 0;
+    for (int i = xlen - 1; i >= 0; --i) {
+      sc_dlimb t = (rem << BITS_PER_LIMB) | x[i];
+      if (q)
+        q[i] = (sc_limb) (t / y[0]);
+      rem = t % y[0];
+    }
+    if (r)
+      r[0] = (sc_limb) rem;
+    return;
+  }
+
+  // Normalize y such that its most significant bit is set, and shift x
+  // by the same amount into one more limb.
+  int s = 0;
+  for (sc_limb top = y[ylen - 1]; !(top >> (BITS_PER_LIMB - 1)); top <<= 1)
+    ++s;
+
+  sc_scratch_vec<sc_limb> vn(ylen);
+  sc_scratch_vec<sc_limb> un(xlen + 1);
+
+  for (int i = ylen - 1; i > 0; --i)
+    vn[i] = (y[i] << s) | (s ? y[i - 1] >> (BITS_PER_LIMB - s) : 0);
+  vn[0] = y[0] << s;
+
+  un[xlen] = s ? x[xlen - 1] >> (BITS_PER_LIMB - s) : 0;
+  for (int i = xlen - 1; i > 0; --i)
+    un[i] = (x[i] << s) | (s ? x[i - 1] >> (BITS_PER_LIMB - s) : 0);
+  un[0] = x[0] << s;
+
+  const sc_dlimb base = (sc_dlimb) 1 << BITS_PER_LIMB;
+  const sc_limb vtop = vn[ylen - 1];
+  const sc_limb vnext = vn[ylen - 2];
+
+  for (int j = xlen - ylen; j >= 0; --j) {
+
+    // Estimate the quotient limb, which is at most one too large.
+    sc_dlimb t = ((sc_dlimb) un[j + ylen] << BITS_PER_LIMB) | un[j + ylen - 1];
+    sc_dlimb qhat = t / vtop;
+    sc_dlimb rhat = t % vtop;
+
+    while ((qhat >= base) ||
+           (qhat * vnext > ((rhat << BITS_PER_LIMB) | un[j + ylen - 2]))) {
+      --qhat;
+      rhat += vtop;
+      if (rhat >= base)
+        break;
+    }
+
+    // Multiply and subtract.
+    sc_limb borrow = 0;
+    sc_limb carry = 0;
+    for (int i = 0; i < ylen; ++i) {
+      sc_dlimb p = qhat * vn[i] + carry;
+      carry = (sc_limb) (p >> BITS_PER_LIMB);
+      sc_limb lo = (sc_limb) p;
+      sc_limb diff = un[i + j] - lo;
+      sc_limb b = (un[i + j] < lo);
+      un[i + j] = diff - borrow;
+      borrow = b + (diff < borrow);
+    }
+    sc_limb diff = un[j + ylen] - carry;
+    sc_limb b = (un[j + ylen] < carry);
+    un[j + ylen] = diff - borrow;
+    borrow = b + (diff < borrow);
+
+    // Add back if the estimate was one too large.
+    if (borrow) {
+      --qhat;
+      carry = 0;
+      for (int i = 0; i < ylen; ++i) {
+        sc_dlimb sum = (sc_dlimb) un[i + j] + vn[i] + carry;
+        un[i + j] = (sc_limb) sum;
+        carry = (sc_limb) (sum >> BITS_PER_LIMB);
+      }
+      un[j + ylen] += carry;
+    }
+
+    if (q)
+      q[j] = (sc_limb) qhat;
+  }
+
+  // Unnormalize the remainder.
+  if (r) {
+    for (int i = 0; i < ylen; ++i)
+      r[i] = (un[i] >> s) | (s ? un[i + 1] << (BITS_PER_LIMB - s) : 0);
+  }
+}
+
+// Compute w = u * v on limbs. w has ulen + vlen digits.
+static void
+limb_vec_mul(int ulen, const sc_digit *u,
+             int vlen, const sc_digit *v,
+             sc_digit *w)
+{
+  sc_scratch_vec<sc_limb> x(limb_len(ulen));
+  sc_scratch_vec<sc_limb> y(limb_len(vlen));
+
+  int xlen = limb_pack(ulen, u, x);
+  int ylen = limb_pack(vlen, v, y);
+
+  sc_scratch_vec<sc_limb> z(xlen + ylen);
+  limb_mul(xlen, x, ylen, y, z);
+
+  limb_unpack(xlen + ylen, z, ulen + vlen, w);
+}
+
+// Compute q = u / v and r = u % v on limbs. q and r, if not null, have
+// ulen digits.
+static void
+limb_vec_div(int ulen, const sc_digit *u,
+             int vlen, const sc_digit *v,
+             sc_digit *q, sc_digit *r)
+{
+  sc_scratch_vec<sc_limb> x(limb_len(ulen));
+  sc_scratch_vec<sc_limb> y(limb_len(vlen));
+
+  int xlen = limb_pack(ulen, u, x);
+  int ylen = limb_pack(vlen, v, y);
+
+  if (xlen < ylen) {
+    if (q)
+      vec_zero(ulen, q);
+    if (r)
+      vec_copy(ulen, r, u);
+    return;
+  }
+
+  sc_scratch_vec<sc_limb> lq(xlen - ylen + 1);
+  sc_scratch_vec<sc_limb> lr(ylen);
+
+  limb_div(xlen, x, ylen, y, q ? (sc_limb*) lq : 0, r ? (sc_limb*) lr : 0);
+
+  if (q)
+    limb_unpack(xlen - ylen + 1, lq, ulen, q);
+  if (r)
+    limb_unpack(ylen, lr, ulen, r);
+}
+
+#endif // SC_ENABLE_64BIT_LIMBS
+
 // Compute w = u * v, where w, u, and v are vectors.
 void
 vec_mul(int ulen, const sc_digit *u,
@@ -1085,6 +1324,11 @@ vec_mul(int ulen, const sc_digit *u,
   sc_assert(wbegin != NULL);
 #endif
 
+#ifdef SC_ENABLE_64BIT_LIMBS
+  limb_vec_mul(ulen, u, vlen, vbegin, wbegin);
+  return;
+#endif
+
 #define prod_h carry
 
   const sc_digit *uend = (u + ulen);
@@ -1240,6 +1484,11 @@ vec_div_large(int ulen, const sc_digit *u,
   sc_assert(BITS_PER_DIGIT >= 3 * BITS_PER_BYTE);
 #endif
 
+#ifdef SC_ENABLE_64BIT_LIMBS
+  limb_vec_div(ulen, u, vlen, v, w, 0);
+  return;
+#endif
+
   // We will compute q = x / y where x = u and y = v. The reason for
   // using x and y is that x and y are BYTE_RADIX copies of u and v,
   // respectively. The use of BYTE_RADIX radix greatly simplifies the
@@ -1254,10 +1503,10 @@ vec_div_large(int ulen, const sc_digit *u,
   uchar y[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
   uchar q[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
 #else
-  uchar *x = new uchar[xlen];
-  uchar *y = new uchar[ylen];
+  sc_scratch_vec<uchar> x( xlen );
+  sc_scratch_vec<uchar> y( ylen );
   // valgrind complains about us accessing too far to so leave a buffer.
-  uchar *q = new uchar[(xlen - ylen) + 10];
+  sc_scratch_vec<uchar> q( (xlen - ylen) + 10 );
 #endif
 
   // q corresponds to w.
@@ -1359,12 +1608,6 @@ vec_div_large(int ulen, const sc_digit *u,
   // Set (sc_digit) w = (uchar) q.
   vec_from_char(xlen - ylen + 1, q, ulen, w);
 
-#ifndef SC_MAX_NBITS
-  delete [] x;
-  delete [] y;
-  delete [] q;
-#endif
-
 }
 
 // Compute w = u / v, where u and w are vectors, and v is a scalar.
@@ -1448,6 +1691,11 @@ vec_rem_large(int ulen, const sc_digit *u,
   sc_assert(BITS_PER_DIGIT >= 3 * BITS_PER_BYTE);
 #endif
 
+#ifdef SC_ENABLE_64BIT_LIMBS
+  limb_vec_div(ulen, u, vlen, v, 0, w);
+  return;
+#endif
+
   // This function is adapted from vec_div_large.
 
   int xlen = BYTES_PER_DIGIT * ulen + 1;
@@ -1457,8 +1705,8 @@ vec_rem_large(int ulen, const sc_digit *u,
   uchar x[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
   uchar y[DIV_CEIL2(SC_MAX_NBITS, BITS_PER_BYTE)];
 #else
-  uchar *x = new uchar[xlen];
-  uchar *y = new uchar[ylen];
+  sc_scratch_vec<uchar> x( xlen );
+  sc_scratch_vec<uchar> y( ylen );
 #endif
 
   // r corresponds to w.
@@ -1555,11 +1803,6 @@ vec_rem_large(int ulen, const sc_digit *u,
   // Set (sc_digit) w = (uchar) x for the remainder.
   vec_from_char(ylen, x, ulen, w);
 
-#ifndef SC_MAX_NBITS
-  delete [] x;
-  delete [] y;
-#endif
-
 }
 
 // Compute r = u % v, where u is a vector, and r and v are scalars.
@@ -1883,7 +2126,7 @@ vec_reverse(int unb, int und, sc_digit *ud,
 #ifdef SC_MAX_NBITS
   sc_digit d[MAX_NDIGITS];
 #else
-  sc_digit *d = new sc_digit[und];
+  sc_scratch_vec<sc_digit> d( und );
 #endif
 
   // d is a copy of ud.
@@ -1901,9 +2144,6 @@ vec_reverse(int unb, int und, sc_digit *ud,
 
   }
 
-#ifndef SC_MAX_NBITS
-  delete [] d;
-#endif
 }
 
 #ifdef SC_MAX_NBITS
@@ -1019,6 +1019,73 @@ is_bad_double(double v)
 		         "v is not finite - NaN or Inf" );
 }
 
+
+// ----------------------------------------------------------------------------
+//  CLASS TEMPLATE : sc_scratch_vec<T>
+//
+//  Scratch vector for the arithmetic helpers. Short vectors live on the
+//  stack; only vectors of more than 256 bytes are taken from the heap.
+//  The storage is released when the scratch vector goes out of scope.
+// ----------------------------------------------------------------------------
+
+template< class T >
+class sc_scratch_vec
+{
+    enum { local_size = 256 / sizeof(T) };
+
+public:
+
+    explicit sc_scratch_vec( int n )
+      : m_vec( n <= local_size ? m_local : new T[n] )
+    {}
+
+    ~sc_scratch_vec()
+    { if( m_vec != m_local ) delete [] m_vec; }
+
+    operator T* ()
+    { return m_vec; }
+
+private:
+
+    T  m_local[local_size];
+    T* m_vec;
+
+private:
+
+    // disabled
+    sc_scratch_vec( const sc_scratch_vec& );
+    sc_scratch_vec& operator = ( const sc_scratch_vec& );
+};
+
+
+// ----------------------------------------------------------------------------
+//  CLASS TEMPLATE : sc_big_digits<N>
+//
+//  Digit storage for the fixed-width types sc_bigint<W> and sc_biguint<W>.
+//  Widths that fit into the inline digits of sc_signed/sc_unsigned do not
+//  need any extra storage.
+// ----------------------------------------------------------------------------
+
+#ifdef SC_MAX_NBITS
+template< int N, bool Inline = false >
+#else
+template< int N, bool Inline = ( N > SC_BASE_VEC_DIGITS ) >
+#endif
+class sc_big_digits
+{
+protected:
+    sc_digit* big_digits() { return 0; }
+};
+
+template< int N >
+class sc_big_digits<N,true>
+{
+protected:
+    sc_digit* big_digits() { return m_big_digits; }
+private:
+    sc_digit  m_big_digits[N];
+};
+
 } // namespace sc_dt
 
 
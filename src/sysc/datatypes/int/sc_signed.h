@@ -1161,13 +1161,21 @@ public:
     const sc_signed& operator = ( const sc_fxnum_fast& );
 #endif
 
+protected:
+
+    // Create a number with nb bits whose digits are kept in storage, if
+    // given. Used by the fixed-width types that carry their own digits.
+    sc_signed( int nb, sc_digit* storage );
+
+public:
 
     // destructor
 
     virtual ~sc_signed()
 	{
 #ifndef SC_MAX_NBITS
-	    delete [] digit;
+	    if( digit_owned )
+	        delete [] digit;
 #endif
 	}
 
@@ -2176,6 +2184,8 @@ private:
   sc_digit digit[DIV_CEIL(SC_MAX_NBITS)];   // Shortened as d.
 #else
   sc_digit *digit;                       // Shortened as d.
+  sc_digit base_vec[SC_BASE_VEC_DIGITS]; // Inline digits for small values.
+  bool     digit_owned;                  // digit is allocated with new.
 #endif
 
   // Private constructors:
@@ -2194,6 +2204,17 @@ private:
 
   // Private member functions. The called functions are inline functions.
 
+#ifndef SC_MAX_NBITS
+  // Point digit at the given storage, at the inline digits or, for
+  // wide values, at a new heap vector.
+  void alloc_digits( sc_digit* storage = 0 )
+    {
+      digit_owned = !storage && ndigits > SC_BASE_VEC_DIGITS;
+      digit = storage ? storage
+                      : ( digit_owned ? new sc_digit[ndigits] : base_vec );
+    }
+#endif
+
   small_type default_sign() const
     { return SC_NOSIGN; }
 
@@ -2359,7 +2380,7 @@ sc_signed::sc_signed( const sc_generic_base<T>& v )
 #   ifdef SC_MAX_NBITS
         test_bound(nb);
 #    else
-        digit = new sc_digit[ndigits];
+        alloc_digits();
 #    endif
     makezero();
     v->to_sc_signed(*this);
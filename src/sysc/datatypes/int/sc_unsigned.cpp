@@ -2111,7 +2111,7 @@ compare_unsigned(small_type us,
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS];
 #else
-    sc_digit *d = new sc_digit[nd];
+    sc_scratch_vec<sc_digit> d( nd );
 #endif
 
     if (us == SC_NEG) {
@@ -2131,10 +2131,6 @@ compare_unsigned(small_type us,
 
     }
 
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-
     return cmp_res;
 
   }
@@ -2159,7 +2155,7 @@ sc_unsigned::iszero() const
 #ifdef SC_MAX_NBITS
     sc_digit d[MAX_NDIGITS];
 #else
-    sc_digit *d = new sc_digit[ndigits];
+    sc_scratch_vec<sc_digit> d( ndigits );
 #endif
 
     vec_copy(ndigits, d, digit);
@@ -2168,10 +2164,6 @@ sc_unsigned::iszero() const
 
     bool res = check_for_zero(ndigits, d);
 
-#ifndef SC_MAX_NBITS
-    delete [] d;
-#endif
-
     return res;
 
   }
@@ -0,0 +1,443 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_calendar_queue.cpp -- Queue of pending timed event notifications.
+
+ CHANGE LOG APPEARS AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_calendar_queue.h"
+#include "sysc/kernel/sc_event.h"
+#include "sysc/utils/sc_report.h" // sc_assert
+
+#include <new>
+
+#if defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
+namespace sc_core {
+
+// index of the lowest bit set in a non-zero word
+
+static inline int
+sc_lowest_bit( sc_dt::uint64 w )
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll( w );
+#elif defined(_MSC_VER) && defined(_WIN64)
+    unsigned long i;
+    _BitScanForward64( &i, w );
+    return static_cast<int>( i );
+#else
+    int i = 0;
+    while( !( w & 1 ) ) { w >>= 1; ++i; }
+    return i;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//  STRUCT : sc_calendar_queue::pool_entry
+//
+//  Storage of an unused entry.
+// ----------------------------------------------------------------------------
+
+struct sc_calendar_queue::pool_entry
+{
+    union {
+        pool_entry*   m_next;
+        sc_dt::uint64 m_align;
+        char          m_data[sizeof( sc_event_timed )];
+    };
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_calendar_queue
+//
+//  Priority queue of the pending timed notifications of a simulation
+//  context, ordered by their notification time.
+// ----------------------------------------------------------------------------
+
+sc_calendar_queue::sc_calendar_queue( bool calendar )
+  : m_calendar( calendar )
+  , m_heap( 1, static_cast<sc_event_timed*>( 0 ) )
+  , m_cancelled( 0 )
+  , m_free( 0 )
+  , m_chunks()
+  , m_now( 0 )
+  , m_head( 0 )
+  , m_wheel_size( 0 )
+  , m_slots( 0 )
+  , m_cascade()
+{
+    m_heap.reserve( 129 );
+    if( m_calendar ) {
+        m_slots = new bucket[LEVELS][SLOTS];
+    }
+    for( int level = 0; level < LEVELS; ++level ) {
+        m_level_size[level] = 0;
+        for( int w = 0; w < WORDS; ++w ) {
+            m_used[level][w] = 0;
+        }
+    }
+}
+
+sc_calendar_queue::~sc_calendar_queue()
+{
+    // detach the events of the pending notifications from their entries
+
+    for( int i = 1; i <= heap_size(); ++i ) {
+        m_heap[i]->~sc_event_timed();
+    }
+    int curr = static_cast<int>( m_now & MASK );
+    for( int level = 0; level < LEVELS; ++level ) {
+        if( m_level_size[level] == 0 ) {
+            continue;
+        }
+        for( int slot = 0; slot < SLOTS; ++slot ) {
+            const bucket& b = m_slots[level][slot];
+            std::size_t i = ( level == 0 && slot == curr ) ? m_head : 0;
+            for( ; i < b.size(); ++i ) {
+                b[i]->~sc_event_timed();
+            }
+        }
+    }
+
+    for( std::size_t i = 0; i < m_chunks.size(); ++i ) {
+        delete [] m_chunks[i];
+    }
+    delete [] m_slots;
+}
+
+sc_event_timed*
+sc_calendar_queue::insert( sc_event* e, const sc_time& t )
+{
+    const int CHUNK_SIZE = 256;
+
+    if( m_free == 0 ) {
+        pool_entry* chunk = new pool_entry[CHUNK_SIZE];
+        m_chunks.push_back( chunk );
+        for( int i = 0; i < CHUNK_SIZE - 1; ++i ) {
+            chunk[i].m_next = &chunk[i + 1];
+        }
+        chunk[CHUNK_SIZE - 1].m_next = 0;
+        m_free = chunk;
+    }
+
+    pool_entry* q = m_free;
+    m_free = q->m_next;
+    sc_event_timed* et = new( q->m_data ) sc_event_timed( e, t );
+
+    if( m_calendar && t.value() >= m_now ) {
+        place( et );
+    } else {
+        insert_heap( et );
+    }
+    return et;
+}
+
+void
+sc_calendar_queue::cancel( sc_event_timed* et )
+{
+    et->m_event = 0;
+    if( et->m_index != 0 ) {
+        remove_heap( et->m_index );
+        free_entry( et );
+    } else if( ++m_cancelled > m_wheel_size / 2 && m_cancelled >= SLOTS ) {
+        purge();
+    }
+}
+
+sc_event_timed*
+sc_calendar_queue::reschedule( sc_event_timed* et, const sc_time& t )
+{
+    sc_assert( t < et->m_notify_time );
+    if( et->m_index != 0 ) {
+        // move to the earlier time in place
+        et->m_notify_time = t;
+        sift_up( et->m_index );
+        return et;
+    }
+    sc_event* e = et->m_event;
+    cancel( et );
+    return insert( e, t );
+}
+
+void
+sc_calendar_queue::release( sc_event_timed* et )
+{
+    if( et->m_event == 0 ) {
+        // cancelled entry extracted from the wheel
+        --m_cancelled;
+    }
+    free_entry( et );
+}
+
+void
+sc_calendar_queue::free_entry( sc_event_timed* et )
+{
+    et->~sc_event_timed();
+    pool_entry* q = reinterpret_cast<pool_entry*>( et );
+    q->m_next = m_free;
+    m_free = q;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_calendar_queue::insert_heap"
+// |
+// | The binary heap stores the position of each entry in the entry itself,
+// | so that cancelled entries can be removed and entries can be moved to an
+// | earlier time without searching the heap.  Entries with equal times are
+// | ordered in the same way as by sc_ppq.
+// +----------------------------------------------------------------------------
+void
+sc_calendar_queue::insert_heap( sc_event_timed* et )
+{
+    m_heap.push_back( et );
+    et->m_index = heap_size();
+    sift_up( et->m_index );
+}
+
+sc_event_timed*
+sc_calendar_queue::extract_heap()
+{
+    sc_event_timed* et = m_heap[1];
+    remove_heap( 1 );
+    return et;
+}
+
+void
+sc_calendar_queue::remove_heap( int i )
+{
+    m_heap[i]->m_index = 0;
+    sc_event_timed* last = m_heap.back();
+    m_heap.pop_back();
+    if( i > heap_size() ) {
+        return;
+    }
+    m_heap[i] = last;
+    last->m_index = i;
+    if( i > 1 && last->m_notify_time < m_heap[i / 2]->m_notify_time ) {
+        sift_up( i );
+    } else {
+        heapify( i );
+    }
+}
+
+void
+sc_calendar_queue::sift_up( int i )
+{
+    sc_event_timed* et = m_heap[i];
+    while( i > 1 && et->m_notify_time < m_heap[i / 2]->m_notify_time ) {
+        m_heap[i] = m_heap[i / 2];
+        m_heap[i]->m_index = i;
+        i = i / 2;
+    }
+    m_heap[i] = et;
+    et->m_index = i;
+}
+
+void
+sc_calendar_queue::heapify( int i )
+{
+    int size = heap_size();
+    int l;
+    while( l = 2 * i, l <= size ) {
+        int first = ( m_heap[l]->m_notify_time < m_heap[i]->m_notify_time )
+                  ? l : i;
+        int r = l + 1;
+        if( r <= size &&
+            m_heap[r]->m_notify_time < m_heap[first]->m_notify_time ) {
+            first = r;
+        }
+        if( first == i ) {
+            break;
+        }
+        sc_event_timed* tmp = m_heap[i];
+        m_heap[i] = m_heap[first];
+        m_heap[i]->m_index = i;
+        m_heap[first] = tmp;
+        tmp->m_index = first;
+        i = first;
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_calendar_queue::top_calendar"
+// |
+// | This method advances the wheel to the earliest pending entry and
+// | returns it.  All slots before the current position of a level are empty,
+// | so the first occupied slot of the lowest non-empty level contains the
+// | earliest entries.  Slots of higher levels are redistributed, until the
+// | earliest entries are found in a slot of the lowest level.
+// +----------------------------------------------------------------------------
+sc_event_timed*
+sc_calendar_queue::top_calendar()
+{
+    sc_assert( m_wheel_size > 0 );
+
+    int level = 0;
+    for( ;; ) {
+        if( m_level_size[level] == 0 ) {
+            ++level;
+            sc_assert( level < LEVELS );
+            continue;
+        }
+
+        int shift = level * BITS;
+        int curr  = static_cast<int>( ( m_now >> shift ) & MASK );
+        int slot  = find_slot( level, level == 0 ? curr : curr + 1 );
+        sc_assert( slot >= 0 );
+
+        if( level == 0 ) {
+            if( slot != curr ) {
+                m_now = ( m_now & ~time_type( MASK ) ) | slot;
+                m_head = 0;
+            }
+            return m_slots[0][slot][m_head];
+        }
+
+        // advance to the start of the slot and redistribute its entries
+
+        time_type upper = ~time_type( 0 ) << shift << BITS;
+        m_now = ( m_now & upper ) | ( time_type( slot ) << shift );
+
+        m_cascade.swap( m_slots[level][slot] );
+        m_used[level][slot / 64] &= ~( sc_dt::uint64( 1 ) << ( slot % 64 ) );
+        m_level_size[level] -= static_cast<int>( m_cascade.size() );
+        m_wheel_size -= static_cast<int>( m_cascade.size() );
+
+        for( std::size_t i = 0; i < m_cascade.size(); ++i ) {
+            place( m_cascade[i] );
+        }
+        m_cascade.clear();
+        level = 0;
+    }
+}
+
+sc_event_timed*
+sc_calendar_queue::extract_calendar()
+{
+    sc_event_timed* et = top_calendar();
+
+    int     slot = static_cast<int>( m_now & MASK );
+    bucket& b    = m_slots[0][slot];
+    if( ++m_head == b.size() ) {
+        b.clear();
+        m_head = 0;
+        m_used[0][slot / 64] &= ~( sc_dt::uint64( 1 ) << ( slot % 64 ) );
+    }
+    --m_level_size[0];
+    --m_wheel_size;
+    return et;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_calendar_queue::purge"
+// |
+// | This method drops all cancelled entries from the wheel.  It is called,
+// | when at least half of the entries in the wheel have been cancelled, so
+// | that its cost is amortized over the cancellations.
+// +----------------------------------------------------------------------------
+void
+sc_calendar_queue::purge()
+{
+    int curr = static_cast<int>( m_now & MASK );
+    for( int level = 0; level < LEVELS; ++level ) {
+        if( m_level_size[level] == 0 ) {
+            continue;
+        }
+        for( int slot = 0; slot < SLOTS; ++slot ) {
+            bucket& b = m_slots[level][slot];
+            if( b.empty() ) {
+                continue;
+            }
+            // skip the entries already extracted from the current slot
+            std::size_t i = ( level == 0 && slot == curr ) ? m_head : 0;
+            std::size_t j = 0;
+            for( ; i < b.size(); ++i ) {
+                if( b[i]->m_event != 0 ) {
+                    b[j++] = b[i];
+                } else {
+                    free_entry( b[i] );
+                    --m_level_size[level];
+                    --m_wheel_size;
+                    --m_cancelled;
+                }
+            }
+            b.resize( j );
+            if( level == 0 && slot == curr ) {
+                m_head = 0;
+            }
+            if( j == 0 ) {
+                m_used[level][slot / 64] &=
+                    ~( sc_dt::uint64( 1 ) << ( slot % 64 ) );
+            }
+        }
+    }
+    sc_assert( m_cancelled == 0 );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_calendar_queue::place"
+// |
+// | This method stores an entry not earlier than the current position in
+// | the level of the most significant digit, in which its time differs from
+// | the current position.
+// +----------------------------------------------------------------------------
+void
+sc_calendar_queue::place( sc_event_timed* et )
+{
+    time_type t    = et->m_notify_time.value();
+    time_type diff = ( t ^ m_now ) >> BITS;
+    int       level = 0;
+    while( diff != 0 ) {
+        diff >>= BITS;
+        ++level;
+    }
+
+    int slot = static_cast<int>( ( t >> ( level * BITS ) ) & MASK );
+    m_slots[level][slot].push_back( et );
+    m_used[level][slot / 64] |= sc_dt::uint64( 1 ) << ( slot % 64 );
+    ++m_level_size[level];
+    ++m_wheel_size;
+}
+
+// first occupied slot of the given level, starting at from, or -1
+
+int
+sc_calendar_queue::find_slot( int level, int from ) const
+{
+    for( int w = from / 64; w < WORDS; ++w ) {
+        sc_dt::uint64 bits = m_used[level][w];
+        if( w == from / 64 ) {
+            bits &= ~sc_dt::uint64( 0 ) << ( from % 64 );
+        }
+        if( bits != 0 ) {
+            return w * 64 + sc_lowest_bit( bits );
+        }
+    }
+    return -1;
+}
+
+} // namespace sc_core
+
+// Taf!
@@ -0,0 +1,178 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_calendar_queue.h -- Queue of pending timed event notifications.
+
+  FOR INTERNAL USE ONLY!
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_CALENDAR_QUEUE_H_INCLUDED_
+#define SC_CALENDAR_QUEUE_H_INCLUDED_
+
+#include "sysc/kernel/sc_cmnhdr.h"
+#include "sysc/kernel/sc_time.h"
+
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(SC_WIN_DLL_WARN)
+#pragma warning(push)
+#pragma warning(disable: 4251) // DLL import for std::vector
+#endif
+
+namespace sc_core {
+
+class sc_event;
+class sc_event_timed;
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_calendar_queue
+//
+//  Priority queue of the pending timed notifications of a simulation
+//  context, ordered by their notification time.
+//
+//  By default, all entries are kept in a binary heap.  If the calendar
+//  mode is enabled, entries are sorted into a hierarchical timing wheel
+//  instead: the 64-bit notification time is split into 8-bit digits, and
+//  an entry is stored in the slot of the most significant digit, in which
+//  its time differs from the current position of the wheel.  Insertion
+//  is O(1), and all entries of a single time stamp end up in the same
+//  slot of the lowest level, from which they are extracted in FIFO order.
+//  Entries of a higher level are redistributed to the lower levels when
+//  the wheel advances to their slot, i.e., at most once per level.
+//
+//  Entries earlier than the current position of the wheel (which may
+//  happen after peeking at the next time without advancing the simulation
+//  to it) are kept in the binary heap, which is always served first.
+//  The slots of the wheel are only allocated in calendar mode.
+//
+//  The entries are allocated from a pool owned by the queue.  Cancelled
+//  entries are removed from the binary heap right away.  In the timing
+//  wheel, they are only marked and released, when they are extracted or
+//  when they make up half of the wheel.
+// ----------------------------------------------------------------------------
+
+class SC_API sc_calendar_queue
+{
+public:
+
+    explicit sc_calendar_queue( bool calendar );
+    ~sc_calendar_queue();
+
+    bool calendar() const
+        { return m_calendar; }
+
+    // creates and inserts a notification of the event at time t
+    sc_event_timed* insert( sc_event* e, const sc_time& t );
+
+    // removes a pending notification
+    void cancel( sc_event_timed* et );
+
+    // moves a pending notification to the earlier time t
+    sc_event_timed* reschedule( sc_event_timed* et, const sc_time& t );
+
+    // returns the earliest entry, requires size() > 0
+    sc_event_timed* top()
+        { return heap_size() ? m_heap[1] : top_calendar(); }
+
+    sc_event_timed* extract_top()
+        { return heap_size() ? extract_heap() : extract_calendar(); }
+
+    // returns an extracted entry to the pool
+    void release( sc_event_timed* et );
+
+    // number of entries, including cancelled ones still in the queue
+    int size() const
+        { return heap_size() + m_wheel_size; }
+
+    bool empty() const
+        { return size() == 0; }
+
+    int live() const
+        { return size() - m_cancelled; }
+
+    int cancelled() const
+        { return m_cancelled; }
+
+private:
+
+    typedef sc_time::value_type           time_type;
+    typedef std::vector<sc_event_timed*>  bucket;
+
+    enum
+    {
+        BITS   = 8,                   // bits of the time per level
+        SLOTS  = 1 << BITS,           // slots per level
+        MASK   = SLOTS - 1,
+        LEVELS = 64 / BITS,           // levels covering the full time range
+        WORDS  = SLOTS / 64           // occupancy bitmap words per level
+    };
+
+    int heap_size() const
+        { return static_cast<int>( m_heap.size() ) - 1; }
+
+    void            insert_heap( sc_event_timed* );
+    sc_event_timed* extract_heap();
+    void            remove_heap( int i );
+    void            sift_up( int i );
+    void            heapify( int i );
+
+    sc_event_timed* top_calendar();
+    sc_event_timed* extract_calendar();
+    void            place( sc_event_timed* );
+    void            purge();
+    int             find_slot( int level, int from ) const;
+
+    void            free_entry( sc_event_timed* );
+
+private:
+
+    struct pool_entry;
+
+    bool                     m_calendar;    // true: use the timing wheel.
+    bucket                   m_heap;        // binary heap, starts at [1].
+    int                      m_cancelled;   // cancelled entries in wheel.
+    pool_entry*              m_free;        // free list of entries.
+    std::vector<pool_entry*> m_chunks;      // allocated pool memory.
+    time_type                m_now;         // current wheel position.
+    std::size_t              m_head;        // next entry in current slot.
+    int                      m_wheel_size;  // entries in the wheel.
+    int                      m_level_size[LEVELS];
+    sc_dt::uint64            m_used[LEVELS][WORDS];
+    bucket                   (*m_slots)[SLOTS]; // wheel, in calendar mode.
+    bucket                   m_cascade;     // scratch for redistribution.
+
+private:
+
+    // disabled
+    sc_calendar_queue( const sc_calendar_queue& );
+    sc_calendar_queue& operator = ( const sc_calendar_queue& );
+};
+
+} // namespace sc_core
+
+#if defined(_MSC_VER) && !defined(SC_WIN_DLL_WARN)
+#pragma warning(pop)
+#endif
+
+#endif // SC_CALENDAR_QUEUE_H_INCLUDED_
+// Taf!
@@ -69,6 +69,9 @@ public:
     // switch stack protection on/off
     virtual void stack_protect( bool /* enable */ ) {}
 
+    // stack memory touched so far (in bytes, 0 if unknown)
+    virtual std::size_t stack_usage() const { return 0; }
+
 private:
 
     // disabled
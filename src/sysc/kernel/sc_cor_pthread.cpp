@@ -32,6 +32,8 @@
 
 #include "sysc/kernel/sc_cor_pthread.h"
 #include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_simcontext_int.h"
+#include "sysc/kernel/sc_worker_pool.h"
 
 using namespace std;
 
@@ -54,13 +56,20 @@ namespace sc_core {
 // (1) The thread creation mutex and the creation condition are used to
 //     suspend the thread creating another one until the created thread
 //     reaches its invoke_module_method. This allows us to get control of
-//     thread scheduling away from the pthread package.
+//     thread scheduling away from the pthread package. As they are shared
+//     by all host threads creating coroutines, each created coroutine also
+//     flags its start, until it is resumed for the first time.  A coroutine
+//     destroyed before that ends its thread through the same handshake.
+// (2) The main coroutine and the package count are kept per host thread
+//     running a simulation context (see sc_island).  The active coroutine
+//     of a coroutine's own thread is that coroutine.
 // ----------------------------------------------------------------------------
 
-static sc_cor_pthread* active_cor_p=0;   // Active co-routine.
-static pthread_cond_t  create_condition; // See note 1 above.
-static pthread_mutex_t create_mutex;     // See note 1 above.
-static sc_cor_pthread  main_cor;         // Main coroutine.
+static SC_HOST_THREAD_LOCAL_ sc_cor_pthread* active_cor_p=0; // See note 2.
+static pthread_cond_t  create_condition = PTHREAD_COND_INITIALIZER;  // Note 1.
+static pthread_mutex_t create_mutex = PTHREAD_MUTEX_INITIALIZER;     // Note 1.
+static SC_HOST_THREAD_LOCAL_ sc_cor_pthread* main_cor_p=0;   // See note 2.
+static SC_HOST_THREAD_LOCAL_ int instance_count=0;           // See note 2.
 
 
 // ----------------------------------------------------------------------------
@@ -72,7 +81,7 @@ static sc_cor_pthread  main_cor;         // Main coroutine.
 // constructor
 
 sc_cor_pthread::sc_cor_pthread()
-    : m_cor_fn_arg( 0 ), m_pkg_p( 0 )
+    : m_cor_fn_arg( 0 ), m_pkg_p( 0 ), m_started( false )
 {
     DEBUGF << this << ": sc_cor_pthread::sc_cor_pthread()" << std::endl;
     pthread_cond_init( &m_pt_condition, PTHREAD_NULL );
@@ -85,6 +94,24 @@ sc_cor_pthread::sc_cor_pthread()
 sc_cor_pthread::~sc_cor_pthread()
 {
     DEBUGF << this << ": sc_cor_pthread::~sc_cor_pthread()" << std::endl;
+
+    // A thread that has never been resumed still waits on our condition,
+    // wake it up without a function to run and wait until it is gone.
+
+    pthread_mutex_lock( &create_mutex );
+    if ( m_started )
+    {
+        m_cor_fn = 0;
+        pthread_mutex_lock( &m_mutex );
+        pthread_cond_signal( &m_pt_condition );
+        pthread_mutex_unlock( &m_mutex );
+        while ( m_started )
+        {
+            pthread_cond_wait( &create_condition, &create_mutex );
+        }
+    }
+    pthread_mutex_unlock( &create_mutex );
+
 	pthread_cond_destroy( &m_pt_condition);
 	pthread_mutex_destroy( &m_mutex );
 }
@@ -112,16 +139,26 @@ void* sc_cor_pthread::invoke_module_method(void* context_p)
 
     pthread_mutex_lock( &create_mutex );
 	DEBUGF << p << ": child signalling main thread " << endl;
-    pthread_cond_signal( &create_condition );
+    p->m_started = true;
+    pthread_cond_broadcast( &create_condition );
     pthread_mutex_lock( &p->m_mutex );
     pthread_mutex_unlock( &create_mutex );
     pthread_cond_wait( &p->m_pt_condition, &p->m_mutex );
     pthread_mutex_unlock( &p->m_mutex );
 
+    pthread_mutex_lock( &create_mutex );
+    p->m_started = false;
+    bool destroyed = ( p->m_cor_fn == 0 );
+    pthread_cond_broadcast( &create_condition );
+    pthread_mutex_unlock( &create_mutex );
+    if ( destroyed )
+        return 0;
+
 
     // CALL THE SYSTEMC CODE THAT WILL ACTUALLY START THE THREAD OFF:
 
     active_cor_p = p;
+    sc_set_curr_simcontext( p->m_pkg_p->simcontext() );
     DEBUGF << p << ": about to invoke real method " 
 	   << active_cor_p << std::endl;
     (p->m_cor_fn)(p->m_cor_fn_arg);
@@ -136,9 +173,6 @@ void* sc_cor_pthread::invoke_module_method(void* context_p)
 //  Coroutine package class implemented with Posix Threads.
 // ----------------------------------------------------------------------------
 
-int sc_cor_pkg_pthread::instance_count = 0;
-
-
 // constructor
 
 sc_cor_pkg_pthread::sc_cor_pkg_pthread( sc_simcontext* simc )
@@ -147,12 +181,11 @@ sc_cor_pkg_pthread::sc_cor_pkg_pthread( sc_simcontext* simc )
     // initialize the current coroutine
     if( ++ instance_count == 1 )
     {
-        pthread_cond_init( &create_condition, PTHREAD_NULL );
-        pthread_mutex_init( &create_mutex, PTHREAD_NULL );
         sc_assert( active_cor_p == 0 );
-        main_cor.m_pkg_p = this;
-		DEBUGF << &main_cor << ": is main co-routine" << std::endl;
-        active_cor_p = &main_cor;
+        main_cor_p = new sc_cor_pthread;
+        main_cor_p->m_pkg_p = this;
+		DEBUGF << main_cor_p << ": is main co-routine" << std::endl;
+        active_cor_p = main_cor_p;
     }
 }
 
@@ -163,6 +196,9 @@ sc_cor_pkg_pthread::~sc_cor_pkg_pthread()
 {
     if( -- instance_count == 0 ) {
         // cleanup the main coroutine
+        active_cor_p = 0;
+        delete main_cor_p;
+        main_cor_p = 0;
     }
 }
 
@@ -173,7 +209,7 @@ sc_cor*
 sc_cor_pkg_pthread::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
 {
     sc_cor_pthread* cor_p = new sc_cor_pthread;
-    DEBUGF << &main_cor << ": sc_cor_pkg_pthread::create(" 
+    DEBUGF << main_cor_p << ": sc_cor_pkg_pthread::create(" 
 	       << cor_p << ")" << std::endl;
 
 
@@ -206,12 +242,14 @@ sc_cor_pkg_pthread::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
     //   (1) Lock the creation mutex before creating the new thread.
     //   (2) Sleep on the creation condition, which will be signalled by
     //       the newly created thread just before it goes to sleep in
-    //       invoke_module_method.
+    //       invoke_module_method, until that thread has flagged its start
+    //       (the condition is signalled for threads created by other host
+    //       threads as well).
     // This scheme results in the newly created thread being dormant before
     // the main thread continues execution.
 
     pthread_mutex_lock( &create_mutex );
-    DEBUGF << &main_cor << ": about to create actual thread " 
+    DEBUGF << main_cor_p << ": about to create actual thread " 
 	       << cor_p << std::endl;
     if ( pthread_create( &cor_p->m_thread, &attr,
              &sc_cor_pthread::invoke_module_method, (void*)cor_p ) )
@@ -219,14 +257,17 @@ sc_cor_pkg_pthread::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
         std::fprintf(stderr, "ERROR - could not create thread\n");
     }
 
-    DEBUGF << &main_cor << ": main thread waiting for signal from " 
+    DEBUGF << main_cor_p << ": main thread waiting for signal from " 
 	       << cor_p << std::endl;
-    pthread_cond_wait( &create_condition, &create_mutex );
-	DEBUGF << &main_cor << ": main thread signaled by " 
+    while ( !cor_p->m_started )
+    {
+        pthread_cond_wait( &create_condition, &create_mutex );
+    }
+	DEBUGF << main_cor_p << ": main thread signaled by " 
 	       << cor_p << endl;
 	pthread_attr_destroy( &attr ); 
     pthread_mutex_unlock( &create_mutex );
-    DEBUGF << &main_cor << ": exiting sc_cor_pkg_pthread::create(" 
+    DEBUGF << main_cor_p << ": exiting sc_cor_pkg_pthread::create(" 
 	       << cor_p << ")" << std::endl;
 
     return cor_p;
@@ -279,7 +320,7 @@ sc_cor_pkg_pthread::abort( sc_cor* next_cor_p )
 sc_cor*
 sc_cor_pkg_pthread::get_main()
 {
-    return &main_cor;
+    return main_cor_p;
 }
 
 } // namespace sc_core
@@ -77,6 +77,7 @@ class sc_cor_pthread : public sc_cor
     sc_cor_pkg_pthread* m_pkg_p;        // the creating coroutine package
 	pthread_cond_t      m_pt_condition; // Condition waiting for.
 	pthread_t           m_thread;       // Our pthread storage.
+	bool                m_started;      // Waiting to be resumed first.
 
 private:
 
@@ -115,10 +116,6 @@ public:
     // get the main coroutine
     virtual sc_cor* get_main();
 
-private:
-
-    static int instance_count;
-
 private:
 
     // disabled
@@ -35,24 +35,84 @@
 #include <cstring>
 #include <cstdlib>
 #include <sstream>
+#include <vector>
 
 #include "sysc/kernel/sc_cor_qt.h"
 #include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_worker_pool.h"
+#include "sysc/communication/sc_host_mutex.h"
 #include "sysc/utils/sc_report.h"
 
+// Reserve stacks with mmap, so that only touched pages consume memory.
+
+#if defined(MAP_ANONYMOUS) && defined(MAP_NORESERVE)
+#  define SC_COR_QT_MMAP_STACKS_ 1
+#else
+#  define SC_COR_QT_MMAP_STACKS_ 0
+#endif
+
 namespace sc_core {
 
 // ----------------------------------------------------------------------------
 //  File static variables.
 // ----------------------------------------------------------------------------
 
-// main coroutine
+// main coroutine and current coroutine of the host thread
+//
+// Each host thread running a simulation context (see sc_island) switches
+// between the coroutines of its own packages.
+
+static SC_HOST_THREAD_LOCAL_ sc_cor_qt* main_cor = 0;
+static SC_HOST_THREAD_LOCAL_ sc_cor_qt* curr_cor = 0;
+
+// number of packages of the host thread
+
+static SC_HOST_THREAD_LOCAL_ int thread_instance_count = 0;
+
+#if defined(SC_ENABLE_PARALLEL_SIMULATION)
+
+// protects the package count and the stacks, shared by all host threads
+
+static sc_host_mutex stack_mutex;
+
+#endif
+
+struct stack_lock
+{
+#if defined(SC_ENABLE_PARALLEL_SIMULATION)
+    stack_lock()  { stack_mutex.lock(); }
+    ~stack_lock() { stack_mutex.unlock(); }
+#else
+    stack_lock()  {}
+#endif
+};
+
+#if SC_COR_QT_MMAP_STACKS_
+
+// stacks of deleted coroutines, kept for reuse while a package exists
 
-static sc_cor_qt main_cor;
+struct sc_cor_qt_stack
+{
+    void*       base;
+    std::size_t size;
+};
+
+static std::vector<sc_cor_qt_stack>* stack_pool = 0;
 
-// current coroutine
+// maximum number of pooled stacks
 
-static sc_cor_qt* curr_cor = 0;
+static const std::size_t stack_pool_max = 1024;
+
+// number of mapped stacks (including pooled ones), and its maximum
+//
+// Each stack takes two memory mappings, as the guard page splits it. To
+// leave room within the limit of mappings per process (65530 by default
+// on Linux), further stacks are allocated on the heap instead.
+
+static std::size_t       stack_map_count = 0;
+static const std::size_t stack_map_max   = 16384;
+
+#endif // SC_COR_QT_MMAP_STACKS_
 
 // ----------------------------------------------------------------------------
 
@@ -78,9 +138,34 @@ static std::size_t sc_pagesize()
 //  Coroutine class implemented with QuickThreads.
 // ----------------------------------------------------------------------------
 
+// release stack memory
+
+static void
+stack_free( void* buf, std::size_t stack_size, bool mapped )
+{
+#if SC_COR_QT_MMAP_STACKS_
+    if( mapped ) {
+        stack_lock lock;
+        // touched pages stay allocated, avoiding page faults on reuse
+        if( stack_pool && stack_pool->size() < stack_pool_max ) {
+            sc_cor_qt_stack stack = { buf, stack_size };
+            stack_pool->push_back( stack );
+        } else {
+            munmap( buf, stack_size );
+            --stack_map_count;
+        }
+        return;
+    }
+#else
+    sc_assert( !mapped );
+    (void) stack_size;
+#endif // SC_COR_QT_MMAP_STACKS_
+    std::free( buf );
+}
+
 sc_cor_qt::~sc_cor_qt()
 {
-    std::free( m_stack );
+    stack_free( m_stack, m_stack_size, m_mapped );
 }
 
 // switch stack protection on/off
@@ -146,6 +231,41 @@ sc_cor_qt::stack_protect( bool enable )
 }
 
 
+// stack memory touched so far
+
+std::size_t
+sc_cor_qt::stack_usage() const
+{
+#if SC_COR_QT_MMAP_STACKS_ && defined(__linux__)
+    if( !m_mapped )
+        return 0;
+
+    // untouched pages of the mapping are not resident (unless swapped out),
+    // pages touched by a previous user of a pooled stack are included
+
+    const std::size_t pagesize = sc_pagesize();
+    const std::size_t pages    = m_stack_size / pagesize;
+    std::vector<unsigned char> resident( pages );
+    if( mincore( m_stack, m_stack_size, &resident[0] ) != 0 )
+        return 0;
+
+#  ifdef QUICKTHREADS_GROW_DOWN
+    std::size_t deepest = 0;
+    while( deepest < pages && !( resident[deepest] & 1 ) )
+        ++deepest;
+    return ( pages - deepest ) * pagesize;
+#  else
+    std::size_t deepest = pages;
+    while( deepest > 0 && !( resident[deepest - 1] & 1 ) )
+        --deepest;
+    return deepest * pagesize;
+#  endif
+#else
+    return 0;
+#endif
+}
+
+
 // ----------------------------------------------------------------------------
 //  CLASS : sc_cor_pkg_qt
 //
@@ -158,7 +278,7 @@ int sc_cor_pkg_qt::instance_count = 0;
 
 // allocate aligned stack memory
 static inline void*
-stack_alloc( void** buf, std::size_t* stack_size )
+stack_alloc( void** buf, std::size_t* stack_size, bool* mapped )
 {
     const std::size_t alignment     = sc_pagesize();
     const std::size_t round_up_mask = alignment - 1;
@@ -168,6 +288,35 @@ stack_alloc( void** buf, std::size_t* stack_size )
     // round up to multiple of alignment
     *stack_size = (*stack_size + round_up_mask) & ~round_up_mask;
 
+#if SC_COR_QT_MMAP_STACKS_
+    stack_lock lock;
+
+    // reuse a pooled stack of the same size, most recently released first
+    if( stack_pool ) {
+        for( std::size_t i = stack_pool->size(); i-- > 0; ) {
+            if( (*stack_pool)[i].size == *stack_size ) {
+                *buf = (*stack_pool)[i].base;
+                (*stack_pool)[i] = stack_pool->back();
+                stack_pool->pop_back();
+                *mapped = true;
+                return *buf;
+            }
+        }
+    }
+
+    // reserve address space only, pages are allocated when touched
+    if( stack_map_count < stack_map_max ) {
+        *buf = mmap( 0, *stack_size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+        if( *buf != MAP_FAILED ) {
+            ++stack_map_count;
+            *mapped = true;
+            return *buf;
+        }
+    }
+#endif // SC_COR_QT_MMAP_STACKS_
+
+    *mapped = false;
 #ifdef SC_HAVE_POSIX_MEMALIGN
     if( 0 != posix_memalign( buf, alignment, *stack_size ) ) {
         *buf = NULL; // allocation failed
@@ -191,10 +340,18 @@ stack_alloc( void** buf, std::size_t* stack_size )
 sc_cor_pkg_qt::sc_cor_pkg_qt( sc_simcontext* simc )
 : sc_cor_pkg( simc )
 {
-    if( ++ instance_count == 1 ) {
+    if( ++ thread_instance_count == 1 ) {
 	// initialize the current coroutine
 	sc_assert( curr_cor == 0 );
-	curr_cor = &main_cor;
+	main_cor = new sc_cor_qt();
+	curr_cor = main_cor;
+    }
+
+    stack_lock lock;
+    if( ++ instance_count == 1 ) {
+#if SC_COR_QT_MMAP_STACKS_
+	stack_pool = new std::vector<sc_cor_qt_stack>();
+#endif
     }
 }
 
@@ -203,9 +360,23 @@ sc_cor_pkg_qt::sc_cor_pkg_qt( sc_simcontext* simc )
 
 sc_cor_pkg_qt::~sc_cor_pkg_qt()
 {
-    if( -- instance_count == 0 ) {
+    if( -- thread_instance_count == 0 ) {
 	// cleanup the current coroutine
 	curr_cor = 0;
+	delete main_cor;
+	main_cor = 0;
+    }
+
+    stack_lock lock;
+    if( -- instance_count == 0 ) {
+#if SC_COR_QT_MMAP_STACKS_
+	// coroutines deleted later unmap their stacks directly
+	for( std::size_t i = 0; i < stack_pool->size(); ++i )
+	    munmap( (*stack_pool)[i].base, (*stack_pool)[i].size );
+	stack_map_count -= stack_pool->size();
+	delete stack_pool;
+	stack_pool = 0;
+#endif
     }
 }
 
@@ -229,7 +400,8 @@ sc_cor_pkg_qt::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
     cor->m_pkg = this;
     cor->m_stack_size = stack_size;
 
-    void* aligned_sp = stack_alloc( &cor->m_stack, &cor->m_stack_size );
+    void* aligned_sp = stack_alloc( &cor->m_stack, &cor->m_stack_size,
+                                    &cor->m_mapped );
     if( aligned_sp == NULL )
     {
         SC_REPORT_ERROR( SC_ID_STACK_SETUP_FAILED_
@@ -287,7 +459,7 @@ sc_cor_pkg_qt::abort( sc_cor* next_cor )
 sc_cor*
 sc_cor_pkg_qt::get_main()
 {
-    return &main_cor;
+    return main_cor;
 }
 
 } // namespace sc_core
@@ -54,7 +54,8 @@ public:
 
     // constructor
     sc_cor_qt()
-	: m_stack_size( 0 ), m_stack( 0 ), m_sp( 0 ), m_pkg( 0 )
+	: m_stack_size( 0 ), m_stack( 0 ), m_mapped( false ), m_sp( 0 ),
+	  m_pkg( 0 )
 	{}
 
     // destructor
@@ -63,10 +64,14 @@ public:
     // switch stack protection on/off
     virtual void stack_protect( bool enable );
 
+    // stack memory touched so far (in bytes, 0 if unknown)
+    virtual std::size_t stack_usage() const;
+
 public:
 
     std::size_t    m_stack_size;  // stack size
     void*          m_stack;       // stack
+    bool           m_mapped;      // stack allocated with mmap?
     qt_t*          m_sp;          // stack pointer
 
     sc_cor_pkg_qt* m_pkg;         // the creating coroutine package
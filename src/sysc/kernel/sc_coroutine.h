@@ -0,0 +1,357 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_coroutine.h -- Stackless thread processes based on C++20 coroutines.
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_COROUTINE_H_INCLUDED_
+#define SC_COROUTINE_H_INCLUDED_
+
+#include "sysc/kernel/sc_cmnhdr.h"
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+
+#include "sysc/kernel/sc_module.h"
+#include "sysc/kernel/sc_process_handle.h"
+#include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_wait.h"
+
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <sstream>
+#include <utility>
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_co_thread
+//
+//  Return type of the body of a coroutine thread process (SC_COTHREAD).
+//
+//  A coroutine thread behaves like an SC_THREAD, but suspends itself with
+//  co_await sc_co_wait(...) instead of calling wait(...).  It is executed
+//  as a method process without a stack of its own: each activation of the
+//  process resumes the coroutine, and each sc_co_wait sets the trigger of
+//  the next activation via next_trigger().  Only the coroutine frame,
+//  holding the local variables of the body, is kept between activations.
+//
+//  When the body returns, the process is terminated.  Exceptions leaving
+//  the body are passed on to the kernel like those of a method process.
+//  Resets and throw_it() are not supported for coroutine threads.
+// ----------------------------------------------------------------------------
+
+class sc_co_thread
+{
+public:
+
+    struct promise_type
+    {
+        promise_type() : skip( 0 ), exception() {}
+
+        sc_co_thread get_return_object()
+          { return sc_co_thread( handle_type::from_promise( *this ) ); }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept   { return {}; }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() noexcept
+          { exception = std::current_exception(); }
+
+        int                skip;       // activations to ignore (wait(n))
+        std::exception_ptr exception;  // exception leaving the body
+    };
+
+    typedef std::coroutine_handle<promise_type> handle_type;
+
+    sc_co_thread() : m_handle() {}
+
+    sc_co_thread( sc_co_thread&& other ) noexcept
+      : m_handle( std::exchange( other.m_handle, handle_type() ) )
+    {}
+
+    sc_co_thread& operator = ( sc_co_thread&& other ) noexcept
+    {
+        if( this != &other ) {
+            destroy();
+            m_handle = std::exchange( other.m_handle, handle_type() );
+        }
+        return *this;
+    }
+
+    ~sc_co_thread()
+        { destroy(); }
+
+    // runs the body up to the next sc_co_wait, returns false when done
+    bool resume();
+
+private:
+
+    explicit sc_co_thread( handle_type h ) : m_handle( h ) {}
+
+    void destroy()
+    {
+        if( m_handle )
+            m_handle.destroy();
+        m_handle = handle_type();
+    }
+
+    handle_type m_handle;
+};
+
+inline bool
+sc_co_thread::resume()
+{
+    promise_type& p = m_handle.promise();
+    if( p.skip > 0 ) {
+        --p.skip;
+        return true;
+    }
+
+    m_handle.resume();
+    if( !m_handle.done() )
+        return true;
+
+    std::exception_ptr e = p.exception;
+    destroy();
+    if( e )
+        std::rethrow_exception( e );
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_co_thread_host (implementation-defined)
+//
+//  Host object of the method process executing a coroutine thread.
+// ----------------------------------------------------------------------------
+
+class sc_co_thread_host
+  : public sc_process_host
+{
+public:
+
+    explicit sc_co_thread_host( std::function<sc_co_thread()> body )
+      : m_body( std::move( body ) ), m_thread(), m_started( false )
+    {}
+
+    void resume()
+    {
+        if( !m_started ) {
+            m_started = true;
+            m_thread  = m_body();
+        }
+        if( !m_thread.resume() )
+            sc_get_current_process_handle().kill();
+    }
+
+private:
+    std::function<sc_co_thread()> m_body;
+    sc_co_thread                  m_thread;
+    bool                          m_started;
+};
+
+template <class Module>
+inline sc_process_handle
+sc_create_co_thread_process( const char* name, Module* module,
+                             sc_co_thread (Module::*func)() )
+{
+    return sc_get_curr_simcontext()->create_method_process(
+             name, true, SC_MAKE_FUNC_PTR( sc_co_thread_host, resume ),
+             new sc_co_thread_host( std::bind( func, module ) ), 0 );
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_co_wait_awaiter (implementation-defined)
+//
+//  Sets the trigger of the next activation, when the coroutine suspends.
+// ----------------------------------------------------------------------------
+
+template <class Trigger>
+class sc_co_wait_awaiter
+{
+public:
+
+    explicit sc_co_wait_awaiter( Trigger trigger )
+      : m_trigger( std::move( trigger ) )
+    {}
+
+    bool await_ready() const noexcept
+        { return false; }
+
+    void await_suspend( sc_co_thread::handle_type h )
+        { m_trigger( h.promise() ); }
+
+    void await_resume() const noexcept
+        {}
+
+private:
+    Trigger m_trigger;
+};
+
+template <class Trigger>
+inline sc_co_wait_awaiter<Trigger>
+sc_co_make_wait( Trigger trigger )
+{
+    return sc_co_wait_awaiter<Trigger>( std::move( trigger ) );
+}
+
+// ----------------------------------------------------------------------------
+//  sc_co_wait - Suspend a coroutine thread
+//
+//  The arguments correspond to those of wait() in a thread process.
+// ----------------------------------------------------------------------------
+
+// static sensitivity
+inline auto
+sc_co_wait()
+{
+    return sc_co_make_wait( []( sc_co_thread::promise_type& ) {} );
+}
+
+// n activations of the static sensitivity
+inline auto
+sc_co_wait( int n )
+{
+    if( n <= 0 ) {
+        std::stringstream msg;
+        msg << "n = " << n;
+        SC_REPORT_ERROR( SC_ID_WAIT_N_INVALID_, msg.str().c_str() );
+    }
+    return sc_co_make_wait(
+             [n]( sc_co_thread::promise_type& p ) { p.skip = n - 1; } );
+}
+
+inline auto
+sc_co_wait( const sc_event& e )
+{
+    return sc_co_make_wait(
+             [&e]( sc_co_thread::promise_type& ) { next_trigger( e ); } );
+}
+
+inline auto
+sc_co_wait( const sc_event_or_list& el )
+{
+    return sc_co_make_wait(
+             [&el]( sc_co_thread::promise_type& ) { next_trigger( el ); } );
+}
+
+inline auto
+sc_co_wait( const sc_event_and_list& el )
+{
+    return sc_co_make_wait(
+             [&el]( sc_co_thread::promise_type& ) { next_trigger( el ); } );
+}
+
+inline auto
+sc_co_wait( const sc_time& t )
+{
+    return sc_co_make_wait(
+             [t]( sc_co_thread::promise_type& ) { next_trigger( t ); } );
+}
+
+inline auto
+sc_co_wait( double v, sc_time_unit tu )
+{
+    return sc_co_wait( sc_time( v, tu ) );
+}
+
+inline auto
+sc_co_wait( const sc_time& t, const sc_event& e )
+{
+    return sc_co_make_wait(
+             [t, &e]( sc_co_thread::promise_type& ) { next_trigger( t, e ); } );
+}
+
+inline auto
+sc_co_wait( double v, sc_time_unit tu, const sc_event& e )
+{
+    return sc_co_wait( sc_time( v, tu ), e );
+}
+
+inline auto
+sc_co_wait( const sc_time& t, const sc_event_or_list& el )
+{
+    return sc_co_make_wait(
+             [t, &el]( sc_co_thread::promise_type& ) { next_trigger( t, el ); } );
+}
+
+inline auto
+sc_co_wait( double v, sc_time_unit tu, const sc_event_or_list& el )
+{
+    return sc_co_wait( sc_time( v, tu ), el );
+}
+
+inline auto
+sc_co_wait( const sc_time& t, const sc_event_and_list& el )
+{
+    return sc_co_make_wait(
+             [t, &el]( sc_co_thread::promise_type& ) { next_trigger( t, el ); } );
+}
+
+inline auto
+sc_co_wait( double v, sc_time_unit tu, const sc_event_and_list& el )
+{
+    return sc_co_wait( sc_time( v, tu ), el );
+}
+
+} // namespace sc_core
+
+// ----------------------------------------------------------------------------
+//  MACRO : SC_COTHREAD(func)
+//
+//  Declares the member function func, returning sc_co_thread, as the body
+//  of a coroutine thread process of the current module.
+// ----------------------------------------------------------------------------
+
+#define declare_co_thread_process(handle, name, host_tag, func)             \
+    {                                                                       \
+        ::sc_core::sc_process_handle handle =                              \
+            ::sc_core::sc_create_co_thread_process(                        \
+                name, this, &host_tag::func );                              \
+        this->sensitive << handle;                                          \
+        this->sensitive_pos << handle;                                      \
+        this->sensitive_neg << handle;                                      \
+    }
+
+#define SC_COTHREAD(func)                                                     \
+    declare_co_thread_process( func ## _handle,                               \
+                               #func,                                         \
+                               SC_CURRENT_USER_MODULE,                        \
+                               func )
+
+#endif // __cpp_impl_coroutine
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+#endif // SC_COROUTINE_H_INCLUDED_
+// Taf!
@@ -31,6 +31,7 @@
 
 #include "sysc/kernel/sc_event.h"
 #include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/kernel/sc_kernel_profiler.h"
 #include "sysc/kernel/sc_phase_callback_registry.h"
 #include "sysc/kernel/sc_process.h"
 #include "sysc/kernel/sc_process_handle.h"
@@ -65,6 +66,10 @@ sc_event::basename() const
 void
 sc_event::cancel()
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_cancel( *this );
+        return;
+    }
     // cancel a delta or timed notification
     switch( m_notify_type ) {
     case DELTA: {
@@ -76,7 +81,7 @@ sc_event::cancel()
     case TIMED: {
         // remove this event from the timed events set
         sc_assert( m_timed != 0 );
-        m_timed->m_event = 0;
+        m_simc->remove_timed_event( m_timed );
         m_timed = 0;
         m_notify_type = NONE;
         break;
@@ -90,6 +95,11 @@ sc_event::cancel()
 void
 sc_event::notify()
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_notify( *this );
+        return;
+    }
+    SC_KERNEL_PROFILE_( m_simc, notified( this ) );
     // immediate notification
     if( !m_simc->evaluation_phase() )
         // coming from
@@ -107,6 +117,11 @@ sc_event::notify()
 void
 sc_event::notify( const sc_time& t )
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_notify( *this, t );
+        return;
+    }
+    SC_KERNEL_PROFILE_( m_simc, notified( this ) );
     if( m_notify_type == DELTA ) {
         return;
     }
@@ -127,7 +142,7 @@ sc_event::notify( const sc_time& t )
         if( m_notify_type == TIMED ) {
             // remove this event from the timed events set
             sc_assert( m_timed != 0 );
-            m_timed->m_event = 0;
+            m_simc->remove_timed_event( m_timed );
             m_timed = 0;
         }
         // add this event to the delta events set
@@ -153,14 +168,13 @@ sc_event::notify( const sc_time& t )
         if( m_timed->m_notify_time <= m_simc->time_stamp() + t ) {
             return;
         }
-        // remove this event from the timed events set
-        m_timed->m_event = 0;
-        m_timed = 0;
+        // move the pending notification to the earlier time
+        m_timed = m_simc->reschedule_timed_event( m_timed,
+                                                  m_simc->time_stamp() + t );
+        return;
     }
     // add this event to the timed events set
-    sc_event_timed* et = new sc_event_timed( this, m_simc->time_stamp() + t );
-    m_simc->add_timed_event( et );
-    m_timed = et;
+    m_timed = m_simc->add_timed_event( this, m_simc->time_stamp() + t );
     m_notify_type = TIMED;
 }
 
@@ -178,7 +192,12 @@ static void sc_warn_notify_delayed()
 void
 sc_event::notify_delayed()
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_notify_delayed( *this, SC_ZERO_TIME );
+        return;
+    }
     sc_warn_notify_delayed();
+    SC_KERNEL_PROFILE_( m_simc, notified( this ) );
     if( m_notify_type != NONE ) {
         SC_REPORT_ERROR( SC_ID_NOTIFY_DELAYED_, 0 );
     }
@@ -190,7 +209,12 @@ sc_event::notify_delayed()
 void
 sc_event::notify_delayed( const sc_time& t )
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_notify_delayed( *this, t );
+        return;
+    }
     sc_warn_notify_delayed();
+    SC_KERNEL_PROFILE_( m_simc, notified( this ) );
     if( m_notify_type != NONE ) {
         SC_REPORT_ERROR( SC_ID_NOTIFY_DELAYED_, 0 );
     }
@@ -200,10 +224,7 @@ sc_event::notify_delayed( const sc_time& t )
         m_notify_type = DELTA;
     } else {
         // add this event to the timed events set
-        sc_event_timed* et = new sc_event_timed( this,
-                                                 m_simc->time_stamp() + t );
-        m_simc->add_timed_event( et );
-        m_timed = et;
+        m_timed = m_simc->add_timed_event( this, m_simc->time_stamp() + t );
         m_notify_type = TIMED;
     }
 }
@@ -355,6 +376,7 @@ sc_event::sc_event( kernel_tag, const char* name ) :
 // +----------------------------------------------------------------------------
 sc_event::~sc_event()
 {
+    SC_KERNEL_PROFILE_( m_simc, destroyed( this ) );
     cancel();
     if ( m_name.length() != 0 )
     {
@@ -382,6 +404,7 @@ sc_event::~sc_event()
 void
 sc_event::trigger()
 {
+    SC_KERNEL_PROFILE_( m_simc, triggered( this ) );
     m_trigger_stamp = m_simc->change_stamp();
     m_notify_type = NONE;
     m_delta_event_index = -1;
@@ -395,12 +418,7 @@ sc_event::trigger()
 
     if( ( size = m_methods_static.size() ) != 0 )
     {
-        sc_method_handle* l_methods_static = &m_methods_static[0];
-        int i = size - 1;
-        do {
-            sc_method_handle method_h = l_methods_static[i];
-            method_h->trigger_static();
-        } while( -- i >= 0 );
+        sc_method_process::trigger_static( &m_methods_static[0], size );
     }
 
     // trigger the dynamic sensitive methods
@@ -530,54 +548,6 @@ sc_event::remove_dynamic( sc_thread_handle thread_h_ ) const
 }
 
 
-// ----------------------------------------------------------------------------
-//  CLASS : sc_event_timed
-//
-//  Class for storing the time to notify a timed event.
-// ----------------------------------------------------------------------------
-
-// dedicated memory management; not MT-Safe
-
-union sc_event_timed_u
-{
-    sc_event_timed_u* next;
-    char              dummy[sizeof( sc_event_timed )];
-};
-
-static
-sc_event_timed_u* free_list = 0;
-
-void*
-sc_event_timed::allocate()
-{
-    const int ALLOC_SIZE = 64;
-
-    if( free_list == 0 ) {
-        free_list = (sc_event_timed_u*) malloc( ALLOC_SIZE *
-                                                sizeof( sc_event_timed_u ) );
-        int i = 0;
-        for( ; i < ALLOC_SIZE - 1; ++ i ) {
-            free_list[i].next = &free_list[i + 1];
-        }
-        free_list[i].next = 0;
-    }
-
-    sc_event_timed_u* q = free_list;
-    free_list = free_list->next;
-    return q;
-}
-
-void
-sc_event_timed::deallocate( void* p )
-{
-    if( p != 0 ) {
-        sc_event_timed_u* q = reinterpret_cast<sc_event_timed_u*>( p );
-        q->next = free_list;
-        free_list = q;
-    }
-}
-
-
 // ----------------------------------------------------------------------------
 //  CLASS : sc_event_list
 //
@@ -32,6 +32,7 @@
 
 #include "sysc/kernel/sc_cmnhdr.h"
 #include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/kernel/sc_kernel_profiler.h"
 #include "sysc/kernel/sc_simcontext.h"
 #include "sysc/communication/sc_writer_policy.h"
 
@@ -359,17 +360,23 @@ class SC_API sc_event_timed
 {
     friend class sc_event;
     friend class sc_simcontext;
+    friend class sc_calendar_queue;
 
     friend SC_API int sc_notify_time_compare( const void*, const void* );
 
 private:
 
     sc_event_timed( sc_event* e, const sc_time& t )
-        : m_event( e ), m_notify_time( t )
+        : m_event( e ), m_notify_time( t ), m_index( 0 )
         {}
 
     ~sc_event_timed()
-        { if( m_event != 0 ) { m_event->m_timed = 0; } }
+    {
+        if( m_event != 0 ) {
+            m_event->m_timed = 0;
+            m_event->m_notify_type = sc_event::NONE;
+        }
+    }
 
     sc_event* event() const
         { return m_event; }
@@ -377,22 +384,11 @@ private:
     const sc_time& notify_time() const
         { return m_notify_time; }
 
-    static void* operator new( std::size_t )
-        { return allocate(); }
-
-    static void operator delete( void* p, std::size_t )
-        { deallocate( p ); }
-
-private:
-
-    // dedicated memory management
-    static void* allocate();
-    static void  deallocate( void* );
-
 private:
 
     sc_event* m_event;
     sc_time   m_notify_time;
+    int       m_index;       // position in the heap of sc_calendar_queue.
 
 private:
 
@@ -417,15 +413,13 @@ inline
 void
 sc_event::notify_internal( const sc_time& t )
 {
+    SC_KERNEL_PROFILE_( m_simc, notified( this ) );
     if( t == SC_ZERO_TIME ) {
         // add this event to the delta events set
         m_delta_event_index = m_simc->add_delta_event( this );
         m_notify_type = DELTA;
     } else {
-        sc_event_timed* et =
-		new sc_event_timed( this, m_simc->time_stamp() + t );
-        m_simc->add_timed_event( et );
-        m_timed = et;
+        m_timed = m_simc->add_timed_event( this, m_simc->time_stamp() + t );
         m_notify_type = TIMED;
     }
 }
@@ -434,9 +428,14 @@ inline
 void
 sc_event::notify_next_delta()
 {
+    if( SC_UNLIKELY_( m_simc->in_parallel_evaluation() ) ) {
+        m_simc->defer_notify_next_delta( *this );
+        return;
+    }
     if( m_notify_type != NONE ) {
         SC_REPORT_ERROR( SC_ID_NOTIFY_DELAYED_, 0 );
     }
+    SC_KERNEL_PROFILE_( m_simc, notified( this ) );
     // add this event to the delta events set
     m_delta_event_index = m_simc->add_delta_event( this );
     m_notify_type = DELTA;
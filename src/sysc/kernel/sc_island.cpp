@@ -0,0 +1,403 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_island.cpp -- Sub-models simulated in parallel with their own contexts.
+
+ CHANGE LOG APPEARS AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_island.h"
+#include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/kernel/sc_module.h"
+#include "sysc/kernel/sc_process_handle.h"
+#include "sysc/kernel/sc_simcontext_int.h"
+#include "sysc/kernel/sc_worker_pool.h"
+#include "sysc/communication/sc_event_queue.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_context
+//
+//  Makes the context of an island the current one of the calling host
+//  thread, for the lifetime of the object.
+// ----------------------------------------------------------------------------
+
+class sc_island_context
+{
+public:
+    explicit sc_island_context( sc_simcontext* simc )
+      : m_prev( sc_get_curr_simcontext() )
+        { sc_set_curr_simcontext( simc ); }
+
+    ~sc_island_context()
+        { sc_set_curr_simcontext( m_prev ); }
+
+private:
+    sc_simcontext* m_prev;
+};
+
+// Kill the thread processes among and below the given objects.
+
+static void
+kill_threads( const std::vector<sc_object*>& objects )
+{
+    for( std::size_t i = 0; i < objects.size(); ++i ) {
+        sc_object* object_p = objects[i];
+        const std::vector<sc_object*> children = object_p->get_child_objects();
+        kill_threads( children );
+
+        sc_process_handle process( object_p );
+        if( process.valid() && process.proc_kind() != SC_METHOD_PROC_ )
+            process.kill();
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island
+//
+//  A sub-model with its own simulation context.
+// ----------------------------------------------------------------------------
+
+sc_island::sc_island( const char* name )
+  : m_name( name ), m_simc( 0 ), m_scheduler( 0 ), m_inputs(), m_outputs()
+{}
+
+sc_island::~sc_island()
+{}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_link_base
+//
+//  The untyped part of a sc_island_link.
+// ----------------------------------------------------------------------------
+
+sc_island_link_base::sc_island_link_base( sc_island& from, sc_island& to,
+                                          const sc_time& latency )
+  : m_from( &from ), m_to( &to ), m_latency( latency ), m_arrivals( 0 )
+{
+    if( from.m_simc || to.m_simc ) {
+        SC_REPORT_ERROR( SC_ID_ISLAND_,
+                         "link created after the elaboration of its islands" );
+    }
+    if( latency == SC_ZERO_TIME ) {
+        SC_REPORT_ERROR( SC_ID_ISLAND_,
+                         "the latency of a link must be greater than zero" );
+    }
+    from.m_outputs.push_back( this );
+    to.m_inputs.push_back( this );
+}
+
+sc_island_link_base::~sc_island_link_base()
+{
+    m_from->m_outputs.erase( std::find( m_from->m_outputs.begin(),
+                                        m_from->m_outputs.end(), this ) );
+    m_to->m_inputs.erase( std::find( m_to->m_inputs.begin(),
+                                     m_to->m_inputs.end(), this ) );
+}
+
+const sc_event&
+sc_island_link_base::data_written_event() const
+{
+    if( !m_arrivals ) {
+        SC_REPORT_ERROR( SC_ID_ISLAND_, "data_written_event() called "
+                         "before the elaboration of the receiving island" );
+        sc_abort();
+    }
+    return m_arrivals->default_event();
+}
+
+void
+sc_island_link_base::notify_arrival( const sc_time& arrival )
+{
+    m_arrivals->notify( arrival - sc_time_stamp() );
+}
+
+// The event queue is created with the context of the receiving island,
+// before its sub-model.
+
+void
+sc_island_link_base::elaborate_receiver()
+{
+    std::string name = m_from->name();
+    name += "_link";
+    m_arrivals = new sc_event_queue( sc_gen_unique_name( name.c_str() ) );
+}
+
+void
+sc_island_link_base::wrong_island( const char* side ) const
+{
+    std::stringstream msg;
+    msg << "link from island '" << m_from->name() << "' to island '"
+        << m_to->name() << "' accessed outside of its " << side;
+    SC_REPORT_ERROR( SC_ID_ISLAND_, msg.str().c_str() );
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_scheduler::island_loop
+//
+//  Elaborates a single island, simulates the current window on all
+//  islands, or destroys all islands.  Each island is always handled by the
+//  same worker.
+// ----------------------------------------------------------------------------
+
+class sc_island_scheduler::island_loop : public sc_worker_loop
+{
+public:
+    enum phase_t { ELABORATE, RUN, DESTROY };
+
+    island_loop( sc_island_scheduler& scheduler, phase_t phase,
+                 std::size_t elaborated = 0 )
+      : sc_worker_loop( scheduler.m_islands.size(), true )
+      , m_scheduler( scheduler ), m_phase( phase ), m_elaborated( elaborated )
+    {}
+
+protected:
+    virtual void body( std::size_t i )
+    {
+        switch( m_phase ) {
+          case ELABORATE:
+            if( m_elaborated == i )
+                m_scheduler.elaborate_island( i );
+            break;
+          case RUN:
+            m_scheduler.run_island( i );
+            break;
+          case DESTROY:
+            m_scheduler.destroy_island( i );
+            break;
+        }
+    }
+
+private:
+    sc_island_scheduler& m_scheduler;
+    phase_t              m_phase;
+    std::size_t          m_elaborated; // island to elaborate.
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_scheduler
+//
+//  Simulates islands in parallel, synchronized conservatively.
+// ----------------------------------------------------------------------------
+
+sc_island_scheduler::sc_island_scheduler()
+  : m_islands(), m_simc( 0 ), m_pool( 0 ), m_time(), m_window_end()
+  , m_stopped( false )
+{}
+
+// The contexts are deleted on the workers which created them, as their
+// coroutines belong to these host threads.
+
+sc_island_scheduler::~sc_island_scheduler()
+{
+    if( m_pool )
+        island_loop( *this, island_loop::DESTROY ).execute( *m_pool );
+    delete m_pool;
+    for( std::size_t i = 0; i < m_islands.size(); ++i )
+        m_islands[i]->m_scheduler = 0;
+}
+
+void
+sc_island_scheduler::add( sc_island& island )
+{
+    if( m_pool ) {
+        SC_REPORT_ERROR( SC_ID_ISLAND_, "island added after the start" );
+        return;
+    }
+    if( island.m_scheduler ) {
+        std::stringstream msg;
+        msg << "island '" << island.name() << "' added twice";
+        SC_REPORT_ERROR( SC_ID_ISLAND_, msg.str().c_str() );
+        return;
+    }
+    island.m_scheduler = this;
+    m_islands.push_back( &island );
+}
+
+sc_time
+sc_island_scheduler::lookahead() const
+{
+    sc_time result = sc_max_time();
+    for( std::size_t i = 0; i < m_islands.size(); ++i ) {
+        sc_island* island = m_islands[i];
+        for( std::size_t j = 0; j < island->m_inputs.size(); ++j )
+            result = std::min( result, island->m_inputs[j]->latency() );
+    }
+    return result;
+}
+
+void
+sc_island_scheduler::start( const sc_time& duration )
+{
+    if( m_islands.empty() ) {
+        SC_REPORT_ERROR( SC_ID_ISLAND_, "no islands to simulate" );
+        return;
+    }
+    if( !m_pool )
+        elaborate();
+    if( m_stopped ) {
+        SC_REPORT_WARNING( SC_ID_ISLAND_,
+                           "start() ignored, as an island has stopped" );
+        return;
+    }
+
+    const sc_time window = lookahead();
+    const sc_time end = m_time + duration;
+    while( m_time < end && !m_stopped )
+    {
+        m_window_end = ( end - m_time > window ) ? m_time + window : end;
+        island_loop( *this, island_loop::RUN ).execute( *m_pool );
+        m_time = m_window_end;
+
+        // barrier: the receivers take the values at the next window
+
+        for( std::size_t i = 0; i < m_islands.size(); ++i ) {
+            sc_island* island = m_islands[i];
+            for( std::size_t j = 0; j < island->m_outputs.size(); ++j )
+                island->m_outputs[j]->hand_over();
+            if( island->m_simc->get_status() != SC_PAUSED )
+                m_stopped = true;
+        }
+    }
+}
+
+// Each island has its own worker, so that the coroutines of its context
+// are created and resumed on the same host thread.  The islands are
+// elaborated one after the other.
+
+void
+sc_island_scheduler::elaborate()
+{
+#if defined(SC_ENABLE_PARALLEL_SIMULATION) \
+    && ( defined(_WIN32) || defined(WIN32) )
+    // the fibers of all host threads share their current coroutine
+    if( m_islands.size() > 1 ) {
+        SC_REPORT_ERROR( SC_ID_ISLAND_, "parallel islands are not "
+                         "supported with the fiber coroutine package" );
+        return;
+    }
+#endif
+
+    for( std::size_t i = 0; i < m_islands.size(); ++i ) {
+        sc_island* island = m_islands[i];
+        for( std::size_t j = 0; j < island->m_inputs.size(); ++j ) {
+            if( island->m_inputs[j]->sender().m_scheduler != this ) {
+                std::stringstream msg;
+                msg << "island '" << island->m_inputs[j]->sender().name()
+                    << "' linked to island '" << island->name()
+                    << "' is not simulated by the same scheduler";
+                SC_REPORT_ERROR( SC_ID_ISLAND_, msg.str().c_str() );
+                return;
+            }
+        }
+        for( std::size_t j = 0; j < island->m_outputs.size(); ++j ) {
+            if( island->m_outputs[j]->receiver().m_scheduler != this ) {
+                std::stringstream msg;
+                msg << "island '" << island->m_outputs[j]->receiver().name()
+                    << "' linked from island '" << island->name()
+                    << "' is not simulated by the same scheduler";
+                SC_REPORT_ERROR( SC_ID_ISLAND_, msg.str().c_str() );
+                return;
+            }
+        }
+    }
+
+    // the islands share the time resolution of the calling context
+
+    m_simc = sc_get_curr_simcontext();
+    m_simc->m_time_params->time_resolution_fixed = true;
+
+    // an island failing to elaborate stops the simulation
+
+    m_stopped = true;
+    m_pool = new sc_worker_pool( static_cast<int>( m_islands.size() ) );
+    for( std::size_t i = 0; i < m_islands.size(); ++i )
+        island_loop( *this, island_loop::ELABORATE, i ).execute( *m_pool );
+
+    m_stopped = false;
+    for( std::size_t i = 0; i < m_islands.size(); ++i ) {
+        if( m_islands[i]->m_simc->get_status() != SC_PAUSED )
+            m_stopped = true;
+    }
+}
+
+void
+sc_island_scheduler::elaborate_island( std::size_t i )
+{
+    sc_island* island = m_islands[i];
+    island->m_simc = new sc_simcontext;
+    *island->m_simc->m_time_params = *m_simc->m_time_params;
+
+    sc_island_context context( island->m_simc );
+    for( std::size_t j = 0; j < island->m_inputs.size(); ++j )
+        island->m_inputs[j]->elaborate_receiver();
+    island->elaborate();
+    sc_start( SC_ZERO_TIME );
+}
+
+void
+sc_island_scheduler::run_island( std::size_t i )
+{
+    sc_island* island = m_islands[i];
+    sc_simcontext* simc = island->m_simc;
+
+    sc_island_context context( simc );
+    for( std::size_t j = 0; j < island->m_inputs.size(); ++j )
+        island->m_inputs[j]->deliver();
+
+    // an explicit sc_pause() ends the simulation before the window does
+
+    while( simc->get_status() == SC_PAUSED
+           && simc->time_stamp() < m_window_end )
+        sc_start( m_window_end - simc->time_stamp() );
+}
+
+// The threads of the island are killed first, so that their coroutines end,
+// then the sub-model is deleted, followed by the event queues of the links
+// to the island and the context, all with the context of the island.
+
+void
+sc_island_scheduler::destroy_island( std::size_t i )
+{
+    sc_island* island = m_islands[i];
+    sc_simcontext* simc = island->m_simc;
+    if( !simc )
+        return;
+
+    sc_island_context context( simc );
+    if( sc_is_running() )
+        kill_threads( sc_get_top_level_objects() );
+    island->destroy();
+    for( std::size_t j = 0; j < island->m_inputs.size(); ++j ) {
+        delete island->m_inputs[j]->m_arrivals;
+        island->m_inputs[j]->m_arrivals = 0;
+    }
+    island->m_simc = 0;
+    delete simc;
+}
+
+} // namespace sc_core
+
+// Taf!
@@ -0,0 +1,300 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_island.h -- Sub-models simulated in parallel with their own contexts.
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_ISLAND_H_INCLUDED_
+#define SC_ISLAND_H_INCLUDED_
+
+#include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_time.h"
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sc_core {
+
+class sc_event;
+class sc_event_queue;
+class sc_island_link_base;
+class sc_island_scheduler;
+class sc_worker_pool;
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island
+//
+//  A sub-model with its own simulation context.
+//
+//  The islands added to a sc_island_scheduler are simulated in parallel,
+//  each on its own host thread, and communicate through sc_island_link
+//  channels only.  elaborate() builds the sub-model while the context of
+//  the island is the current one; the objects it creates belong to that
+//  context and must not be accessed by the other islands.  The context is
+//  owned by the scheduler, which calls destroy() to delete the sub-model
+//  before it deletes the context, so an island must outlive its scheduler.
+// ----------------------------------------------------------------------------
+
+class SC_API sc_island
+{
+    friend class sc_island_link_base;
+    friend class sc_island_scheduler;
+
+public:
+
+    explicit sc_island( const char* name );
+    virtual ~sc_island();
+
+    const char* name() const
+        { return m_name.c_str(); }
+
+    // the context of the island, 0 until the island is elaborated
+    sc_simcontext* simcontext() const
+        { return m_simc; }
+
+protected:
+
+    // build the sub-model
+    virtual void elaborate() = 0;
+
+    // delete the sub-model built by elaborate()
+    virtual void destroy() {}
+
+private:
+    std::string                       m_name;
+    sc_simcontext*                    m_simc;
+    sc_island_scheduler*              m_scheduler; // the scheduler (or 0).
+    std::vector<sc_island_link_base*> m_inputs;    // links to this island.
+    std::vector<sc_island_link_base*> m_outputs;   // links from this island.
+
+private:
+    // disabled
+    sc_island( const sc_island& );
+    sc_island& operator = ( const sc_island& );
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_link_base
+//
+//  The untyped part of a sc_island_link.
+//
+//  The values written by the sending island during a time window of the
+//  scheduler are handed over at the barrier ending that window, and are
+//  delivered to the receiving island at the beginning of the next window,
+//  which starts no later than their arrival time.  data_written_event() is
+//  notified at the arrival time of each value.
+// ----------------------------------------------------------------------------
+
+class SC_API sc_island_link_base
+{
+    friend class sc_island_scheduler;
+
+public:
+
+    sc_island& sender() const
+        { return *m_from; }
+
+    sc_island& receiver() const
+        { return *m_to; }
+
+    const sc_time& latency() const
+        { return m_latency; }
+
+    // notified when a value arrives, belongs to the receiving island
+    const sc_event& data_written_event() const;
+
+protected:
+
+    sc_island_link_base( sc_island& from, sc_island& to,
+                         const sc_time& latency );
+    virtual ~sc_island_link_base();
+
+    // report an error unless called from the sending/receiving island
+    void check_sender() const
+    {
+        if( sc_get_curr_simcontext() != m_from->m_simc )
+            wrong_island( "sender" );
+    }
+    void check_receiver() const
+    {
+        if( sc_get_curr_simcontext() != m_to->m_simc )
+            wrong_island( "receiver" );
+    }
+
+    // notify data_written_event() at the given arrival time
+    void notify_arrival( const sc_time& arrival );
+
+private:
+    // hand the written values over, called on the barrier
+    virtual void hand_over() = 0;
+
+    // deliver the values handed over, called on the receiving island
+    virtual void deliver() = 0;
+
+    void elaborate_receiver();
+    void wrong_island( const char* side ) const;
+
+private:
+    sc_island*      m_from;
+    sc_island*      m_to;
+    sc_time         m_latency;
+    sc_event_queue* m_arrivals; // notifies data_written_event().
+
+private:
+    // disabled
+    sc_island_link_base( const sc_island_link_base& );
+    sc_island_link_base& operator = ( const sc_island_link_base& );
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_link<T>
+//
+//  A channel sending values of type T from one island to another, with a
+//  fixed latency.  The values are received in the order they are written.
+// ----------------------------------------------------------------------------
+
+template< class T >
+class sc_island_link : public sc_island_link_base
+{
+public:
+
+    sc_island_link( sc_island& from, sc_island& to, const sc_time& latency )
+      : sc_island_link_base( from, to, latency )
+      , m_written(), m_handed_over(), m_arrived()
+    {}
+
+    // send a value, it arrives at the receiving island after latency()
+    void write( const T& value )
+    {
+        check_sender();
+        m_written.push_back( message( sc_time_stamp() + latency(), value ) );
+    }
+
+    // receive the oldest value which has arrived, if any
+    bool nb_read( T& value )
+    {
+        check_receiver();
+        if( m_arrived.empty() || m_arrived.front().first > sc_time_stamp() )
+            return false;
+        value = m_arrived.front().second;
+        m_arrived.pop_front();
+        return true;
+    }
+
+private:
+    typedef std::pair<sc_time, T> message; // arrival time and value.
+
+    virtual void hand_over()
+    {
+        if( m_handed_over.empty() ) {
+            m_handed_over.swap( m_written );
+        } else {
+            m_handed_over.insert( m_handed_over.end(),
+                                  m_written.begin(), m_written.end() );
+            m_written.clear();
+        }
+    }
+
+    virtual void deliver()
+    {
+        for( std::size_t i = 0; i < m_handed_over.size(); ++i ) {
+            notify_arrival( m_handed_over[i].first );
+            m_arrived.push_back( m_handed_over[i] );
+        }
+        m_handed_over.clear();
+    }
+
+private:
+    std::vector<message> m_written;     // by the sender, in this window.
+    std::vector<message> m_handed_over; // on the last barrier.
+    std::deque<message>  m_arrived;     // delivered to the receiver.
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_island_scheduler
+//
+//  Simulates islands in parallel, synchronized conservatively.
+//
+//  The islands are elaborated one after the other, on the host thread
+//  which runs them afterwards.  The simulation then proceeds in windows of
+//  the lookahead, the smallest latency of the links between the islands.
+//  All islands simulate a window in parallel, and wait for each other on
+//  a barrier at its end.  As no value can arrive within the window it is
+//  sent in, the results do not depend on the host threads' timing.
+//  Without SC_ENABLE_PARALLEL_SIMULATION, the islands are simulated one
+//  after the other within each window.  The contexts of the islands and
+//  of their links are deleted with the scheduler.
+// ----------------------------------------------------------------------------
+
+class SC_API sc_island_scheduler
+{
+public:
+
+    sc_island_scheduler();
+    ~sc_island_scheduler();
+
+    // add an island, before the first call of start()
+    void add( sc_island& island );
+
+    // simulate all islands for the given duration
+    void start( const sc_time& duration );
+
+    // the smallest latency of the links between the islands
+    sc_time lookahead() const;
+
+    // the time all islands have reached
+    const sc_time& time_stamp() const
+        { return m_time; }
+
+    // true, if an island has stopped
+    bool stopped() const
+        { return m_stopped; }
+
+private:
+    class island_loop;
+
+    void elaborate();
+    void elaborate_island( std::size_t i );
+    void run_island( std::size_t i );
+    void destroy_island( std::size_t i );
+
+private:
+    std::vector<sc_island*> m_islands;
+    sc_simcontext*          m_simc;       // context of the caller of start().
+    sc_worker_pool*         m_pool;       // one worker per island.
+    sc_time                 m_time;       // start of the next window.
+    sc_time                 m_window_end; // end of the current window.
+    bool                    m_stopped;
+
+private:
+    // disabled
+    sc_island_scheduler( const sc_island_scheduler& );
+    sc_island_scheduler& operator = ( const sc_island_scheduler& );
+};
+
+} // namespace sc_core
+
+#endif // SC_ISLAND_H_INCLUDED_
+// Taf!
@@ -201,6 +201,14 @@ SC_DEFINE_MESSAGE(SC_ID_RESET_PROCESS_WHILE_NOT_RUNNING_  , 573,
         "a process may not be asynchronously reset while the simulation is not running" )
 SC_DEFINE_MESSAGE(SC_ID_THROW_IT_WHILE_NOT_RUNNING_  , 574,
         "throw_it not allowed unless simulation is running " )
+SC_DEFINE_MESSAGE(SC_ID_PARALLEL_EVALUATION_  , 575,
+        "parallel evaluation of thread-safe processes" )
+SC_DEFINE_MESSAGE(SC_ID_STACK_USAGE_  , 576,
+        "thread stack usage" )
+SC_DEFINE_MESSAGE(SC_ID_KERNEL_PROFILE_  , 577,
+        "kernel profiling" )
+SC_DEFINE_MESSAGE(SC_ID_ISLAND_  , 578,
+        "simulation island" )
 
 
 /*****************************************************************************
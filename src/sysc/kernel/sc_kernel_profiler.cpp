@@ -0,0 +1,427 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_kernel_profiler.cpp -- Activation counts and wall times of processes,
+                            events and the update phase.
+
+ CHANGE LOG APPEARS AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_kernel_profiler.h"
+#include "sysc/kernel/sc_event.h"
+#include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/kernel/sc_process.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#if SC_CPLUSPLUS >= 201103L
+# include <chrono>
+#elif defined(WIN32) || defined(_WIN32)
+# ifndef NOMINMAX
+#   define NOMINMAX
+# endif
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  File static functions.
+// ----------------------------------------------------------------------------
+
+static const char*
+sc_profile_kind( const sc_process_b* process_p )
+{
+    switch( process_p->proc_kind() )
+    {
+      case SC_METHOD_PROC_:  return "method";
+      case SC_THREAD_PROC_:  return "thread";
+      case SC_CTHREAD_PROC_: return "cthread";
+      default:               return "process";
+    }
+}
+
+// name prefix of kernel events
+static const char sc_profile_kernel_prefix[] = "$$$$kernel_event$$$$_";
+
+// write a string as a JSON string literal
+static void
+sc_profile_json_string( std::ostream& os, const std::string& s )
+{
+    os << '"';
+    for( std::size_t i = 0; i < s.size(); ++i )
+    {
+        char c = s[i];
+        if( c == '"' || c == '\\' )
+            os << '\\' << c;
+        else if( static_cast<unsigned char>( c ) < 0x20 )
+            os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+               << static_cast<int>( c ) << std::dec << std::setfill(' ');
+        else
+            os << c;
+    }
+    os << '"';
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_kernel_profiler
+// ----------------------------------------------------------------------------
+
+sc_kernel_profiler::sc_kernel_profiler( format_type format,
+                                        const char* file_name )
+  : m_format( format )
+  , m_file_name( file_name ? file_name : "" )
+  , m_reported( false )
+  , m_entries()
+  , m_processes()
+  , m_events()
+  , m_active_p( 0 )
+  , m_active_start( 0 )
+  , m_update_start( 0 )
+  , m_update_ticks( 0 )
+  , m_updates( 0 )
+  , m_delta_cycles( 0 )
+  , m_timesteps( 0 )
+  , m_step_deltas( 0 )
+  , m_max_step_deltas( 0 )
+{}
+
+sc_kernel_profiler::~sc_kernel_profiler()
+{}
+
+sc_kernel_profiler::ticks_type
+sc_kernel_profiler::now()
+{
+#if SC_CPLUSPLUS >= 201103L
+    return static_cast<ticks_type>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#elif defined(WIN32) || defined(_WIN32)
+    static LARGE_INTEGER frequency = { { 0, 0 } };
+    if( frequency.QuadPart == 0 )
+        QueryPerformanceFrequency( &frequency );
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter( &counter );
+    return static_cast<ticks_type>(
+      counter.QuadPart / frequency.QuadPart * 1000000000
+      + counter.QuadPart % frequency.QuadPart * 1000000000
+        / frequency.QuadPart );
+#else
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return static_cast<ticks_type>( ts.tv_sec ) * 1000000000
+         + static_cast<ticks_type>( ts.tv_nsec );
+#endif
+}
+
+sc_kernel_profiler::entry&
+sc_kernel_profiler::process_entry( const sc_process_b* process_p )
+{
+    entry* entry_p = 0;
+    if( !m_entries.lookup( process_p, &entry_p ) )
+    {
+        entry e;
+        e.name   = process_p->name();
+        e.kind   = sc_profile_kind( process_p );
+        e.count  = 0;
+        e.count2 = 0;
+        e.ticks  = 0;
+        m_processes.push_back( e );
+        entry_p = &m_processes.back();
+        m_entries.insert( process_p, entry_p );
+    }
+    return *entry_p;
+}
+
+sc_kernel_profiler::entry&
+sc_kernel_profiler::event_entry( const sc_event* event_p )
+{
+    entry* entry_p = 0;
+    if( !m_entries.lookup( event_p, &entry_p ) )
+    {
+        entry e;
+        e.name   = event_p->name();
+        e.kind   = "event";
+        e.count  = 0;
+        e.count2 = 0;
+        e.ticks  = 0;
+        // hide the prefix of kernel events (see sc_event.cpp)
+        std::string::size_type pos = e.name.find( sc_profile_kernel_prefix );
+        if( pos != std::string::npos )
+            e.name.erase( pos, std::strlen( sc_profile_kernel_prefix ) );
+        if( e.name.empty() )
+            e.name = "<unnamed>";
+        m_events.push_back( e );
+        entry_p = &m_events.back();
+        m_entries.insert( event_p, entry_p );
+    }
+    return *entry_p;
+}
+
+void
+sc_kernel_profiler::activate( const sc_process_b* process_p )
+{
+    ticks_type t = now();
+    if( m_active_p )
+        m_active_p->ticks += t - m_active_start;
+    m_active_p = &process_entry( process_p );
+    m_active_p->count++;
+    m_active_start = t;
+}
+
+void
+sc_kernel_profiler::deactivate()
+{
+    if( m_active_p )
+    {
+        m_active_p->ticks += now() - m_active_start;
+        m_active_p = 0;
+    }
+}
+
+void
+sc_kernel_profiler::add_activation( const sc_process_b* process_p,
+                                    ticks_type ticks )
+{
+    entry& e = process_entry( process_p );
+    e.count++;
+    e.ticks += ticks;
+}
+
+void
+sc_kernel_profiler::notified( const sc_event* event_p )
+{
+    event_entry( event_p ).count++;
+}
+
+void
+sc_kernel_profiler::triggered( const sc_event* event_p )
+{
+    event_entry( event_p ).count2++;
+}
+
+void
+sc_kernel_profiler::destroyed( const void* object_p )
+{
+    m_entries.remove( object_p );
+}
+
+void
+sc_kernel_profiler::update_begin()
+{
+    m_update_start = now();
+}
+
+void
+sc_kernel_profiler::update_end()
+{
+    m_update_ticks += now() - m_update_start;
+    m_updates++;
+}
+
+void
+sc_kernel_profiler::delta_cycle()
+{
+    m_delta_cycles++;
+    m_step_deltas++;
+}
+
+void
+sc_kernel_profiler::timestep()
+{
+    m_timesteps++;
+    m_max_step_deltas = std::max( m_max_step_deltas, m_step_deltas );
+    m_step_deltas = 0;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_kernel_profiler::report"
+// |
+// | This method writes the collected statistics to the file given to the
+// | constructor, or to std::cout. It only writes the report once.
+// +----------------------------------------------------------------------------
+void
+sc_kernel_profiler::report()
+{
+    if( m_reported )
+        return;
+    m_reported = true;
+    deactivate();
+    timestep(); // the current one
+
+    if( m_file_name.empty() )
+    {
+        if( m_format == JSON )
+            write_json( ::std::cout );
+        else
+            write_text( ::std::cout );
+        return;
+    }
+
+    std::ofstream os( m_file_name.c_str() );
+    if( !os )
+    {
+        std::stringstream msg;
+        msg << "cannot open '" << m_file_name << "'";
+        SC_REPORT_WARNING( SC_ID_KERNEL_PROFILE_, msg.str().c_str() );
+        return;
+    }
+    if( m_format == JSON )
+        write_json( os );
+    else
+        write_text( os );
+}
+
+bool
+sc_kernel_profiler::process_order( const entry* a, const entry* b )
+{
+    if( a->ticks != b->ticks )
+        return a->ticks > b->ticks;
+    return a->name < b->name;
+}
+
+bool
+sc_kernel_profiler::event_order( const entry* a, const entry* b )
+{
+    if( a->count2 != b->count2 )
+        return a->count2 > b->count2;
+    if( a->count != b->count )
+        return a->count > b->count;
+    return a->name < b->name;
+}
+
+void
+sc_kernel_profiler::sorted( const std::deque<entry>& entries,
+                            bool (*order)( const entry*, const entry* ),
+                            std::vector<const entry*>& result )
+{
+    result.clear();
+    result.reserve( entries.size() );
+    for( std::size_t i = 0; i < entries.size(); ++i )
+        result.push_back( &entries[i] );
+    std::sort( result.begin(), result.end(), order );
+}
+
+void
+sc_kernel_profiler::write_text( std::ostream& os ) const
+{
+    std::vector<const entry*> entries;
+    ticks_type process_ticks = 0;
+    for( std::size_t i = 0; i < m_processes.size(); ++i )
+        process_ticks += m_processes[i].ticks;
+
+    os << "Kernel profile (wall times in microseconds)\n"
+       << "\n"
+       << "  delta cycles            : " << m_delta_cycles << "\n"
+       << "  timesteps               : " << m_timesteps << "\n"
+       << "  delta cycles / timestep : "
+       << ( m_timesteps ? double( m_delta_cycles ) / m_timesteps : 0.0 )
+       << " (max " << m_max_step_deltas << ")\n"
+       << "  process activation time : " << process_ticks / 1000 << "\n"
+       << "  update phase time       : " << m_update_ticks / 1000
+       << " (" << m_updates << " phases)\n"
+       << "\n";
+
+    sorted( m_processes, &process_order, entries );
+    os << "  " << std::setw(12) << "time"
+       << "  " << std::setw(12) << "activations"
+       << "  " << std::setw(8) << "kind" << "  process\n";
+    for( std::size_t i = 0; i < entries.size(); ++i )
+    {
+        os << "  " << std::setw(12) << entries[i]->ticks / 1000
+           << "  " << std::setw(12) << entries[i]->count
+           << "  " << std::setw(8) << entries[i]->kind
+           << "  " << entries[i]->name << "\n";
+    }
+    os << "\n";
+
+    sorted( m_events, &event_order, entries );
+    os << "  " << std::setw(12) << "triggers"
+       << "  " << std::setw(12) << "notified"
+       << "  event\n";
+    for( std::size_t i = 0; i < entries.size(); ++i )
+    {
+        os << "  " << std::setw(12) << entries[i]->count2
+           << "  " << std::setw(12) << entries[i]->count
+           << "  " << entries[i]->name << "\n";
+    }
+    os.flush();
+}
+
+void
+sc_kernel_profiler::write_json( std::ostream& os ) const
+{
+    std::vector<const entry*> entries;
+
+    os << "{\n"
+       << "  \"delta_cycles\": " << m_delta_cycles << ",\n"
+       << "  \"timesteps\": " << m_timesteps << ",\n"
+       << "  \"max_delta_cycles_per_timestep\": " << m_max_step_deltas << ",\n"
+       << "  \"update_phases\": " << m_updates << ",\n"
+       << "  \"update_ns\": " << m_update_ticks << ",\n"
+       << "  \"processes\": [";
+
+    sorted( m_processes, &process_order, entries );
+    for( std::size_t i = 0; i < entries.size(); ++i )
+    {
+        os << ( i ? ",\n" : "\n" ) << "    { \"name\": ";
+        sc_profile_json_string( os, entries[i]->name );
+        os << ", \"kind\": \"" << entries[i]->kind << "\""
+           << ", \"activations\": " << entries[i]->count
+           << ", \"ns\": " << entries[i]->ticks << " }";
+    }
+    os << "\n  ],\n"
+       << "  \"events\": [";
+
+    sorted( m_events, &event_order, entries );
+    for( std::size_t i = 0; i < entries.size(); ++i )
+    {
+        os << ( i ? ",\n" : "\n" ) << "    { \"name\": ";
+        sc_profile_json_string( os, entries[i]->name );
+        os << ", \"notifications\": " << entries[i]->count
+           << ", \"triggers\": " << entries[i]->count2 << " }";
+    }
+    os << "\n  ]\n"
+       << "}\n";
+    os.flush();
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+// Taf!
@@ -0,0 +1,181 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_kernel_profiler.h -- Activation counts and wall times of processes,
+                          events and the update phase.
+
+  FOR INTERNAL USE ONLY!
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_KERNEL_PROFILER_H_INCLUDED_
+#define SC_KERNEL_PROFILER_H_INCLUDED_
+
+#include "sysc/kernel/sc_cmnhdr.h"
+#include "sysc/datatypes/int/sc_nbdefs.h" // sc_dt::uint64
+#include "sysc/utils/sc_hash.h"
+
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace sc_core {
+
+class sc_event;
+class sc_process_b;
+
+// ----------------------------------------------------------------------------
+//  MACRO : SC_KERNEL_PROFILE_(simc, call)
+//
+//  Forwards call to the kernel profiler of the simulation context simc, if
+//  profiling is enabled at run-time (SC_KERNEL_PROFILE).  Expands to nothing
+//  unless the library is built with SC_ENABLE_KERNEL_PROFILING.
+// ----------------------------------------------------------------------------
+
+#if defined(SC_ENABLE_KERNEL_PROFILING)
+# define SC_KERNEL_PROFILE_( simc, call )                                     \
+    do {                                                                      \
+        ::sc_core::sc_kernel_profiler* profiler_p_ =                          \
+            (simc)->kernel_profiler();                                        \
+        if( SC_UNLIKELY_( profiler_p_ != 0 ) )                                \
+            profiler_p_->call;                                                \
+    } while( false )
+#else
+# define SC_KERNEL_PROFILE_( simc, call ) \
+    ((void)0)
+#endif
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_kernel_profiler
+//
+//  Collects the statistics of a simulation context, which are written as a
+//  sorted text report or as a JSON document at the end of the simulation.
+//
+//  At most one process is active at a time: activate() starts the wall time
+//  measurement of a process activation, which is stopped by the next call
+//  to activate() or deactivate().  Methods evaluated in parallel are timed
+//  by the workers and added via add_activation().
+//
+//  Processes and events are identified by their address while they exist,
+//  the kernel calls destroyed() when they are deleted.
+// ----------------------------------------------------------------------------
+
+class sc_kernel_profiler
+{
+public:
+
+    typedef sc_dt::uint64 ticks_type; // nanoseconds
+
+    enum format_type { TEXT, JSON };
+
+    sc_kernel_profiler( format_type format, const char* file_name );
+    ~sc_kernel_profiler();
+
+    // current wall time
+    static ticks_type now();
+
+    // processes
+    void activate( const sc_process_b* process_p );
+    void deactivate();
+    void add_activation( const sc_process_b* process_p, ticks_type ticks );
+
+    // events
+    void notified( const sc_event* event_p );
+    void triggered( const sc_event* event_p );
+
+    // processes and events
+    void destroyed( const void* object_p );
+
+    // simulation phases
+    void update_begin();
+    void update_end();
+    void delta_cycle();
+    void timestep();
+
+    // write the report (once)
+    void report();
+
+private:
+
+    struct entry
+    {
+        std::string name;
+        const char* kind;
+        sc_dt::uint64 count;  // activations or notifications
+        sc_dt::uint64 count2; // triggers of events
+        ticks_type    ticks;  // wall time of process activations
+    };
+
+    entry& process_entry( const sc_process_b* process_p );
+    entry& event_entry( const sc_event* event_p );
+
+    static bool process_order( const entry* a, const entry* b );
+    static bool event_order( const entry* a, const entry* b );
+    static void sorted( const std::deque<entry>& entries,
+                        bool (*order)( const entry*, const entry* ),
+                        std::vector<const entry*>& result );
+
+    void write_text( std::ostream& os ) const;
+    void write_json( std::ostream& os ) const;
+
+private:
+    format_type                    m_format;
+    std::string                    m_file_name;     // empty: std::cout
+    bool                           m_reported;
+
+    sc_phash<const void*, entry*>  m_entries;       // existing objects.
+    std::deque<entry>              m_processes;
+    std::deque<entry>              m_events;
+
+    entry*                         m_active_p;      // active process.
+    ticks_type                     m_active_start;  // start of activation.
+
+    ticks_type                     m_update_start;
+    ticks_type                     m_update_ticks;  // update phases.
+    sc_dt::uint64                  m_updates;
+
+    sc_dt::uint64                  m_delta_cycles;
+    sc_dt::uint64                  m_timesteps;
+    sc_dt::uint64                  m_step_deltas;   // of current timestep.
+    sc_dt::uint64                  m_max_step_deltas;
+
+private:
+    // disabled
+    sc_kernel_profiler( const sc_kernel_profiler& );
+    sc_kernel_profiler& operator = ( const sc_kernel_profiler& );
+};
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+#endif // SC_KERNEL_PROFILER_H_INCLUDED_
+// Taf!
@@ -31,6 +31,7 @@
 #include "sysc/kernel/sc_cmnhdr.h"
 #include "sysc/kernel/sc_externs.h"
 #include "sysc/kernel/sc_except.h"
+#include "sysc/kernel/sc_simcontext.h"
 #include "sysc/kernel/sc_ver.h"
 #include "sysc/utils/sc_report.h"
 #include "sysc/utils/sc_report_handler.h"
@@ -88,6 +89,13 @@ sc_elab_and_sim( int argc, char* argv[] )
         std::vector<char*> argv_call = argv_copy;
         status = sc_main( argc, &argv_call[0] );
 
+        // write the pending output of trace files, which were not closed
+        sc_get_curr_simcontext()->flush_trace_files();
+
+        // report stack usage, unless issued at the end of simulation
+        sc_get_curr_simcontext()->report_stack_usage();
+        sc_get_curr_simcontext()->report_kernel_profile();
+
         // Perform cleanup here
         sc_in_action = false;
     }
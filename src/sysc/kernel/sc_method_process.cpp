@@ -325,6 +325,7 @@ sc_method_process::sc_method_process( const char* name_p,
     m_process_kind = SC_METHOD_PROC_;
     if (opt_p) {
         m_dont_init = opt_p->m_dont_initialize;
+        m_thread_safe = opt_p->m_thread_safe;
 
         // traverse event sensitivity list
         for (unsigned int i = 0; i < opt_p->m_sensitive_events.size(); i++) {
@@ -624,6 +625,66 @@ void sc_method_process::throw_user( const sc_throw_it_helper& helper,
 
 }
 
+//------------------------------------------------------------------------------
+//"sc_method_process::trigger_static"
+//
+// This method performs trigger_static() for the methods statically
+// sensitive to an event, in the order trigger_static() would be called for
+// them, from the last to the first one.  The methods satisfying the
+// criteria above are linked into a chain, which is appended to the queue
+// of runnable processes as a whole, and the current process is looked up
+// only once.  A suspended method is marked as ready to run as before.
+//     methods_p -> methods to trigger.
+//     size      =  number of methods.
+//------------------------------------------------------------------------------
+void
+sc_method_process::trigger_static( sc_method_handle* methods_p, int size )
+{
+    sc_simcontext*   simc_p = methods_p[0]->simcontext();
+    sc_process_b*    current_p = simc_p->get_curr_proc_info()->process_handle;
+    sc_method_handle self_p = 0;
+    sc_method_handle head_p = 0;
+    sc_method_handle tail_p = 0;
+
+    for( int i = size - 1; i >= 0; -- i )
+    {
+        sc_method_handle method_h = methods_p[i];
+        if ( (method_h->m_state & ps_bit_disabled) || method_h->is_runnable() ||
+              method_h->m_trigger_type != STATIC )
+            continue;
+
+#if ! defined( SC_ENABLE_IMMEDIATE_SELF_NOTIFICATIONS )
+        if( SC_UNLIKELY_( current_p == method_h ) )
+        {
+            self_p = method_h;
+            continue;
+        }
+#endif // SC_ENABLE_IMMEDIATE_SELF_NOTIFICATIONS
+
+        if ( method_h->m_state & ps_bit_suspended )
+        {
+            method_h->m_state = method_h->m_state | ps_bit_ready_to_run;
+            continue;
+        }
+
+        // Mark the method as queued at once, so that it is not linked twice,
+        // by a link to itself, which is replaced by the link to the next
+        // method or the end of the queue.
+
+        method_h->set_next_runnable( method_h );
+        if ( tail_p )
+            tail_p->set_next_runnable( method_h );
+        else
+            head_p = method_h;
+        tail_p = method_h;
+    }
+
+    if ( head_p )
+        simc_p->push_runnable_methods( head_p, tail_p );
+    if( SC_UNLIKELY_( self_p != 0 ) )
+        self_p->report_immediate_self_notification();
+}
+
 //------------------------------------------------------------------------------
 //"sc_method_process::trigger_dynamic"
 //
@@ -167,6 +167,7 @@ class sc_method_process : public sc_process_b {
         sc_descendant_inclusion_info descendants = SC_NO_DESCENDANTS );
     bool trigger_dynamic( sc_event* );
     inline void trigger_static();
+    static void trigger_static( sc_method_handle* methods_p, int size );
 
   protected:
     sc_cor*                          m_cor;        // Thread's coroutine.
@@ -183,7 +183,8 @@ sc_module::sc_module()
   m_port_vec(),
   m_port_index(0),
   m_name_gen(0),
-  m_module_name_p(0)
+  m_module_name_p(0),
+  m_elaboration_thread_safe(false)
 {
     /* When this form is used, we better have a fresh sc_module_name
        on the top of the stack */
@@ -210,7 +211,8 @@ sc_module::sc_module( const sc_module_name& )
   m_port_vec(),
   m_port_index(0),
   m_name_gen(0),
-  m_module_name_p(0)
+  m_module_name_p(0),
+  m_elaboration_thread_safe(false)
 {
     /* For those used to the old style of passing a name to sc_module,
        this constructor will reduce the chance of making a mistake */
@@ -243,7 +245,8 @@ sc_module::sc_module( const char* nm )
   m_port_vec(),
   m_port_index(0),
   m_name_gen(0),
-  m_module_name_p(0)
+  m_module_name_p(0),
+  m_elaboration_thread_safe(false)
 {
     SC_REPORT_WARNING( SC_ID_BAD_SC_MODULE_CONSTRUCTOR_, nm );
     sc_module_init();
@@ -258,7 +261,8 @@ sc_module::sc_module( const std::string& s )
   m_port_vec(),
   m_port_index(0),
   m_name_gen(0),
-  m_module_name_p(0)
+  m_module_name_p(0),
+  m_elaboration_thread_safe(false)
 {
     SC_REPORT_WARNING( SC_ID_BAD_SC_MODULE_CONSTRUCTOR_, s.c_str() );
     sc_module_init();
@@ -338,6 +342,15 @@ sc_module::dont_initialize()
     last_proc.dont_initialize( true );
 }
 
+// to allow the parallel evaluation of SC_METHODs
+
+void
+sc_module::thread_safe()
+{
+    sc_process_handle last_proc = sc_get_last_created_process_handle();
+    last_proc.thread_safe( true );
+}
+
 // set SC_THREAD synchronous reset sensitivity
 
 void
@@ -402,6 +415,14 @@ sc_module::end_of_elaboration()
 // the proper parent. After the call we pop the hierarchy.
 void
 sc_module::elaboration_done( bool& error_ )
+{
+    check_end_module( error_ );
+    hierarchy_scope scope(this);
+    end_of_elaboration();
+}
+
+void
+sc_module::check_end_module( bool& error_ )
 {
     if( ! m_end_module_called ) {
         std::stringstream msg;
@@ -412,8 +433,6 @@ sc_module::elaboration_done( bool& error_ )
         }
         error_ = true;
     }
-    hierarchy_scope scope(this);
-    end_of_elaboration();
 }
 
 // called by start_simulation (does nothing by default)
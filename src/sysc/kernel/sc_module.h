@@ -108,6 +108,7 @@ protected:
     virtual void end_of_elaboration();
 
     void elaboration_done( bool& );
+    void check_end_module( bool& );
 
     // called by start_simulation (does nothing by default)
     virtual void start_of_simulation();
@@ -157,6 +158,18 @@ protected:
     // to prevent initialization for SC_METHODs and SC_THREADs
     void dont_initialize();
 
+    // to allow the parallel evaluation of SC_METHODs
+    void thread_safe();
+
+    // may before_end_of_elaboration() and end_of_elaboration() be executed
+    // in parallel with those of other modules? (they must only modify the
+    // state of this module, and must not create objects or issue reports
+    // other than errors)
+    bool elaboration_thread_safe() const
+        { return m_elaboration_thread_safe; }
+    void elaboration_thread_safe( bool safe )
+        { m_elaboration_thread_safe = safe; }
+
     // positional binding code - used by operator ()
 
     void positional_bind( sc_interface& );
@@ -311,6 +324,7 @@ private:
     int                         m_port_index;
     sc_name_gen*                m_name_gen;
     sc_module_name*             m_module_name_p;
+    bool                        m_elaboration_thread_safe; // Parallel callbacks.
 
 public:
 
@@ -32,6 +32,7 @@
 #include "sysc/kernel/sc_module.h"
 #include "sysc/kernel/sc_module_registry.h"
 #include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_worker_pool.h"
 
 namespace sc_core {
 
@@ -110,8 +111,31 @@ sc_module_registry::construction_done()
         // nothing has been updated
         return true;
 
+    // the callbacks of thread-safe modules are executed in parallel, before
+    // those of the other modules (which may create further modules)
+
+    int parallel_end = m_construction_done;
+    sc_worker_pool* pool = m_simc->elaboration_pool();
+    if( pool ) {
+        std::vector<sc_module*> modules;
+        parallel_end = size();
+        for( int i = m_construction_done; i < parallel_end; ++ i ) {
+            if( m_module_vec[i]->elaboration_thread_safe() ) {
+                modules.push_back( m_module_vec[i] );
+            }
+        }
+        if( !modules.empty() ) {
+            sc_worker_member_loop<sc_module>( modules,
+              &sc_module::before_end_of_elaboration ).execute( *pool );
+        }
+    }
+
     for( ; m_construction_done < size(); ++m_construction_done ) {
-        m_module_vec[m_construction_done]->construction_done();
+        sc_module* module_p = m_module_vec[m_construction_done];
+        if( m_construction_done >= parallel_end ||
+            !module_p->elaboration_thread_safe() ) {
+            module_p->construction_done();
+        }
     }
     return false;
 }
@@ -122,8 +146,29 @@ void
 sc_module_registry::elaboration_done()
 {
     bool error = false;
+
+    // the callbacks of thread-safe modules are executed in parallel, before
+    // those of the other modules
+
+    sc_worker_pool* pool = m_simc->elaboration_pool();
+    if( pool ) {
+        std::vector<sc_module*> modules;
+        for( int i = 0; i < size(); ++ i ) {
+            if( m_module_vec[i]->elaboration_thread_safe() ) {
+                m_module_vec[i]->check_end_module( error );
+                modules.push_back( m_module_vec[i] );
+            }
+        }
+        if( !modules.empty() ) {
+            sc_worker_member_loop<sc_module>( modules,
+              &sc_module::end_of_elaboration ).execute( *pool );
+        }
+    }
+
     for( int i = 0; i < size(); ++ i ) {
-	m_module_vec[i]->elaboration_done( error );
+        if( !pool || !m_module_vec[i]->elaboration_thread_safe() ) {
+            m_module_vec[i]->elaboration_done( error );
+        }
     }
 }
 
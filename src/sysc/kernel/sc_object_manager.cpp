@@ -33,6 +33,7 @@
 #include <cctype>
 #include <cstddef>
 #include <cctype>
+#include <cstring>
 #include <algorithm> // pick up std::sort.
 
 #include "sysc/kernel/sc_object.h"
@@ -55,12 +56,36 @@ namespace sc_core {
 //  Manager of objects.
 // ----------------------------------------------------------------------------
 
+// Hash of a hierarchical name (FNV-1a). The names of an elaborated design
+// share long prefixes, which defeats hashes that look at a few characters
+// only.
+
+static inline unsigned
+name_hash(const char* name, std::size_t len)
+{
+    unsigned hash = 2166136261u;
+    for (std::size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Orders table entries by name, for walking the objects.
+
+struct entry_name_less
+{
+    template<class Entry>
+    bool operator()(const Entry* entry1_p, const Entry* entry2_p) const
+        { return entry1_p->m_name < entry2_p->m_name; }
+};
+
 sc_object_manager::sc_object_manager() :
-    m_event_it(),
-    m_event_walk_ok(0),
+    m_instance_index(),
     m_instance_table(),
     m_module_name_stack(0),
-    m_object_it(),
+    m_object_it(0),
+    m_object_order(),
     m_object_stack(),
     m_object_walk_ok()
 {
@@ -79,13 +104,100 @@ sc_object_manager::~sc_object_manager()
 
     for ( it = m_instance_table.begin(); it != m_instance_table.end(); it++) 
     {
-        if(it->second.m_name_origin == SC_NAME_OBJECT) {
-            sc_object* obj_p = static_cast<sc_object*>(it->second.m_element_p);
+        if(it->m_name_origin == SC_NAME_OBJECT) {
+            sc_object* obj_p = static_cast<sc_object*>(it->m_element_p);
             obj_p->m_simc = 0;
         }
     }
 }
 
+// +----------------------------------------------------------------------------
+// |"sc_object_manager::find_entry"
+// |
+// | This method returns the instance table entry with the supplied name, or
+// | NULL if the name has never been entered in the table.
+// |
+// | Arguments:
+// |     name = name of the entry
+// |     len  = length of the name
+// +----------------------------------------------------------------------------
+sc_object_manager::table_entry*
+sc_object_manager::find_entry(const char* name, std::size_t len)
+{
+    if ( m_instance_index.empty() ) return NULL;
+
+    unsigned    hash = name_hash(name, len);
+    std::size_t mask = m_instance_index.size() - 1;
+    for ( std::size_t i = hash & mask; ; i = (i + 1) & mask )
+    {
+        const index_slot& slot = m_instance_index[i];
+        if ( slot.m_entry_p == NULL ) return NULL;
+        if ( slot.m_hash == hash && slot.m_entry_p->m_name.size() == len &&
+             std::memcmp(slot.m_entry_p->m_name.data(), name, len) == 0 )
+        {
+            return slot.m_entry_p;
+        }
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_object_manager::grow_index"
+// |
+// | This method doubles the size of the instance index and enters the
+// | instance table entries again.
+// +----------------------------------------------------------------------------
+void
+sc_object_manager::grow_index()
+{
+    instance_index_t index( m_instance_index.empty()
+                            ? 1024 : 2 * m_instance_index.size() );
+    std::size_t      mask = index.size() - 1;
+
+    for ( std::size_t s = 0; s < m_instance_index.size(); ++s )
+    {
+        const index_slot& slot = m_instance_index[s];
+        if ( slot.m_entry_p == NULL ) continue;
+        std::size_t i = slot.m_hash & mask;
+        while ( index[i].m_entry_p != NULL ) i = (i + 1) & mask;
+        index[i] = slot;
+    }
+    m_instance_index.swap(index);
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_object_manager::lookup_entry"
+// |
+// | This method returns the instance table entry with the supplied name,
+// | entering the name in the table if it is not there yet. Entries are
+// | never taken out of the table, so the names they hold stay in place.
+// |
+// | Arguments:
+// |     name = name of the entry
+// +----------------------------------------------------------------------------
+sc_object_manager::table_entry&
+sc_object_manager::lookup_entry(const std::string& name)
+{
+    table_entry* entry_p = find_entry(name);
+    if ( entry_p ) return *entry_p;
+
+    // Keep the index at most half full.
+
+    if ( 2 * (m_instance_table.size() + 1) > m_instance_index.size() )
+        grow_index();
+
+    m_instance_table.push_back(table_entry());
+    entry_p = &m_instance_table.back();
+    entry_p->m_name = name;
+    entry_p->m_hash = name_hash(name.data(), name.size());
+
+    std::size_t mask = m_instance_index.size() - 1;
+    std::size_t i = entry_p->m_hash & mask;
+    while ( m_instance_index[i].m_entry_p != NULL ) i = (i + 1) & mask;
+    m_instance_index[i].m_hash = entry_p->m_hash;
+    m_instance_index[i].m_entry_p = entry_p;
+    return *entry_p;
+}
+
 // +----------------------------------------------------------------------------
 // |"sc_object_manager::create_name"
 // | 
@@ -169,9 +281,8 @@ std::string sc_object_manager::create_name(const char* leaf_name)
 bool
 sc_object_manager::name_exists(const std::string& name)
 {
-    instance_table_t::const_iterator it = m_instance_table.find(name);
-    return (it != m_instance_table.end()) &&
-           (it->second.m_name_origin != SC_NAME_NONE);
+    table_entry* entry_p = find_entry(name);
+    return entry_p && entry_p->m_name_origin != SC_NAME_NONE;
 }
 
 // +----------------------------------------------------------------------------
@@ -187,10 +298,9 @@ sc_object_manager::name_exists(const std::string& name)
 const char*
 sc_object_manager::get_name(const std::string& name)
 {
-    instance_table_t::iterator it = m_instance_table.find(name);
-    if (it != m_instance_table.end() &&
-        it->second.m_name_origin != SC_NAME_NONE) {
-        return it->first.c_str();
+    table_entry* entry_p = find_entry(name);
+    if (entry_p && entry_p->m_name_origin != SC_NAME_NONE) {
+        return entry_p->m_name.c_str();
     } else {
         return NULL;
     }
@@ -209,12 +319,10 @@ sc_object_manager::get_name(const std::string& name)
 sc_event*
 sc_object_manager::find_event(const char* name)
 {
-    instance_table_t::iterator it;
-    it = m_instance_table.find(name);
-    if(it != m_instance_table.end()
-       && it->second.m_name_origin == SC_NAME_EVENT)
+    table_entry* entry_p = find_entry(name, std::strlen(name));
+    if(entry_p && entry_p->m_name_origin == SC_NAME_EVENT)
     {
-        return static_cast<sc_event*>(it->second.m_element_p);
+        return static_cast<sc_event*>(entry_p->m_element_p);
     } else {
         return NULL;
     }
@@ -233,12 +341,10 @@ sc_object_manager::find_event(const char* name)
 sc_object*
 sc_object_manager::find_object(const char* name)
 {
-    instance_table_t::iterator it;
-    it = m_instance_table.find(name);
-    if(it != m_instance_table.end()
-       && it->second.m_name_origin == SC_NAME_OBJECT)
+    table_entry* entry_p = find_entry(name, std::strlen(name));
+    if(entry_p && entry_p->m_name_origin == SC_NAME_OBJECT)
     {
-        return static_cast<sc_object*>(it->second.m_element_p);
+        return static_cast<sc_object*>(entry_p->m_element_p);
     } else {
         return NULL;
     }
@@ -250,24 +356,34 @@ sc_object_manager::find_object(const char* name)
 // | 
 // | This method initializes the object iterator to point to the first object
 // | in the instance table, and returns its address. If there are no objects
-// | in the table a NULL value is returned.
+// | in the table a NULL value is returned. The objects are walked in the
+// | order of their names; objects that are deleted during the walk are
+// | skipped.
 // +----------------------------------------------------------------------------
 sc_object*
 sc_object_manager::first_object()
 {
-    sc_object* result_p; // result to return.
+    instance_table_t::iterator it; // instance table iterator.
+
+    m_object_order.clear();
+    for ( it = m_instance_table.begin(); it != m_instance_table.end(); it++ )
+    {
+        if(it->m_name_origin == SC_NAME_OBJECT) {
+            m_object_order.push_back(&*it);
+        }
+    }
+    std::sort(m_object_order.begin(), m_object_order.end(), entry_name_less());
 
     m_object_walk_ok = true;
-    result_p = NULL;
-    for ( m_object_it = m_instance_table.begin(); 
-          m_object_it != m_instance_table.end(); 
-	  m_object_it++ )
+    m_object_it = 0;
+    for ( ; m_object_it < m_object_order.size(); ++m_object_it )
     {
-        if(m_object_it->second.m_name_origin == SC_NAME_OBJECT) {
-            return static_cast<sc_object*>(m_object_it->second.m_element_p);
+        if(m_object_order[m_object_it]->m_name_origin == SC_NAME_OBJECT) {
+            return static_cast<sc_object*>(
+                m_object_order[m_object_it]->m_element_p);
         }
     }
-    return result_p;
+    return NULL;
 }
 
 // +----------------------------------------------------------------------------
@@ -344,12 +460,12 @@ sc_object_manager::hierarchy_size()
 bool
 sc_object_manager::insert_external_name(const std::string& name)
 {
-    if(!name_exists(name)) {
-        m_instance_table[name].m_element_p = NULL;
-        m_instance_table[name].m_name_origin = SC_NAME_EXTERNAL;
+    table_entry& element = lookup_entry(name);
+    if(element.m_name_origin == SC_NAME_NONE) {
+        element.m_element_p = NULL;
+        element.m_name_origin = SC_NAME_EXTERNAL;
         return true;
     } else {
-        table_entry element = m_instance_table[name];
         std::stringstream msg;
         msg << name << " ("
             << ((element.m_name_origin == SC_NAME_OBJECT)
@@ -375,8 +491,9 @@ sc_object_manager::insert_external_name(const std::string& name)
 void
 sc_object_manager::insert_event(const std::string& name, sc_event* event_p)
 {
-    m_instance_table[name].m_element_p = static_cast<void*>(event_p);
-    m_instance_table[name].m_name_origin = SC_NAME_EVENT;
+    table_entry& element = lookup_entry(name);
+    element.m_element_p = static_cast<void*>(event_p);
+    element.m_name_origin = SC_NAME_EVENT;
 }
 
 // +----------------------------------------------------------------------------
@@ -392,8 +509,9 @@ sc_object_manager::insert_event(const std::string& name, sc_event* event_p)
 void
 sc_object_manager::insert_object(const std::string& name, sc_object* object_p)
 {
-    m_instance_table[name].m_element_p = static_cast<void*>(object_p);
-    m_instance_table[name].m_name_origin = SC_NAME_OBJECT;
+    table_entry& element = lookup_entry(name);
+    element.m_element_p = static_cast<void*>(object_p);
+    element.m_name_origin = SC_NAME_OBJECT;
 }
 
 // +----------------------------------------------------------------------------
@@ -408,14 +526,15 @@ sc_object_manager::next_object()
 
     sc_assert( m_object_walk_ok );
 
-    if ( m_object_it == m_instance_table.end() ) return NULL;
+    if ( m_object_it >= m_object_order.size() ) return NULL;
     m_object_it++;
 
-    for ( result_p = NULL; m_object_it != m_instance_table.end(); 
+    for ( result_p = NULL; m_object_it < m_object_order.size(); 
 	  m_object_it++ )
     {
-        if(m_object_it->second.m_name_origin == SC_NAME_OBJECT) {
-            return static_cast<sc_object*>(m_object_it->second.m_element_p);
+        if(m_object_order[m_object_it]->m_name_origin == SC_NAME_OBJECT) {
+            return static_cast<sc_object*>(
+                m_object_order[m_object_it]->m_element_p);
         }
     }
     return result_p;
@@ -477,13 +596,11 @@ sc_object_manager::top_of_module_name_stack()
 void
 sc_object_manager::remove_event(const std::string& name)
 {
-    instance_table_t::iterator it;     // instance table iterator.
-    it = m_instance_table.find(name);
-    if(it != m_instance_table.end()
-       && it->second.m_name_origin == SC_NAME_EVENT)
+    table_entry* entry_p = find_entry(name);
+    if(entry_p && entry_p->m_name_origin == SC_NAME_EVENT)
     {
-        it->second.m_element_p = NULL;
-        it->second.m_name_origin = SC_NAME_NONE;
+        entry_p->m_element_p = NULL;
+        entry_p->m_name_origin = SC_NAME_NONE;
     }
 }
 
@@ -499,13 +616,11 @@ sc_object_manager::remove_event(const std::string& name)
 void
 sc_object_manager::remove_object(const std::string& name)
 {
-    instance_table_t::iterator it;     // instance table iterator.
-    it = m_instance_table.find(name);
-    if(it != m_instance_table.end()
-       && it->second.m_name_origin == SC_NAME_OBJECT)
+    table_entry* entry_p = find_entry(name);
+    if(entry_p && entry_p->m_name_origin == SC_NAME_OBJECT)
     {
-        it->second.m_element_p = NULL;
-        it->second.m_name_origin = SC_NAME_NONE;
+        entry_p->m_element_p = NULL;
+        entry_p->m_name_origin = SC_NAME_NONE;
     }
 }
 
@@ -521,13 +636,11 @@ sc_object_manager::remove_object(const std::string& name)
 bool
 sc_object_manager::remove_external_name(const std::string& name)
 {
-    instance_table_t::iterator it;     // instance table iterator.
-    it = m_instance_table.find(name);
-    if(it != m_instance_table.end()
-       && it->second.m_name_origin == SC_NAME_EXTERNAL)
+    table_entry* entry_p = find_entry(name);
+    if(entry_p && entry_p->m_name_origin == SC_NAME_EXTERNAL)
     {
-        it->second.m_element_p = NULL;
-        it->second.m_name_origin = SC_NAME_NONE;
+        entry_p->m_element_p = NULL;
+        entry_p->m_name_origin = SC_NAME_NONE;
         return true;
     } else {
         return false;
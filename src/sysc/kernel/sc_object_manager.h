@@ -30,7 +30,8 @@
 #ifndef SC_OBJECT_MANAGER_H
 #define SC_OBJECT_MANAGER_H
 
-#include <map>
+#include <deque>
+#include <string>
 #include <vector>
 
 namespace sc_core {
@@ -63,15 +64,32 @@ protected:
 
     struct table_entry
     {
-        table_entry() : m_element_p(NULL), m_name_origin(SC_NAME_NONE) {}
+        table_entry() : m_name(), m_hash(0), m_element_p(NULL),
+                        m_name_origin(SC_NAME_NONE) {}
 
+        std::string    m_name;      // hierarchical name.
+        unsigned       m_hash;      // hash of m_name.
 	    void*          m_element_p; // can be an sc_object or an sc_event
         sc_name_origin m_name_origin;
     };
 
+    // Slot of the instance index, an open addressing hash table over the
+    // entries of the instance table. The hash is kept in the slot, so
+    // that probing does not touch the entries of other names.
+
+    struct index_slot
+    {
+        index_slot() : m_hash(0), m_entry_p(NULL) {}
+
+        unsigned     m_hash;    // hash of the entry's name.
+        table_entry* m_entry_p; // entry or NULL if the slot is empty.
+    };
+
 public:
-    typedef std::map<std::string,table_entry> instance_table_t;
-    typedef std::vector<sc_object*>           object_vector_t;
+    typedef std::deque<table_entry>   instance_table_t;
+    typedef std::vector<index_slot>   instance_index_t;
+    typedef std::vector<table_entry*> entry_vector_t;
+    typedef std::vector<sc_object*>   object_vector_t;
 
     sc_object_manager();
     ~sc_object_manager();
@@ -104,13 +122,19 @@ private:
     void remove_object(const std::string& name);
     bool remove_external_name(const std::string& name);
 
+    table_entry* find_entry(const char* name, std::size_t len);
+    table_entry* find_entry(const std::string& name)
+        { return find_entry(name.data(), name.size()); }
+    table_entry& lookup_entry(const std::string& name);
+    void grow_index();
+
 private:
 
-    instance_table_t::iterator m_event_it;          // event instance iterator.
-    bool                       m_event_walk_ok;     // true if can walk events.
+    instance_index_t           m_instance_index;    // index of instances.
     instance_table_t           m_instance_table;    // table of instances.
     sc_module_name*            m_module_name_stack; // sc_module_name stack.
-    instance_table_t::iterator m_object_it;         // object instance iterator.
+    std::size_t                m_object_it;         // object walk position.
+    entry_vector_t             m_object_order;      // objects in name order.
     object_vector_t            m_object_stack;      // sc_object stack.
     bool                       m_object_walk_ok;    // true if can walk objects.
 };
@@ -36,6 +36,7 @@
 #include "sysc/kernel/sc_sensitive.h"
 #include "sysc/kernel/sc_process_handle.h"
 #include "sysc/kernel/sc_event.h"
+#include "sysc/kernel/sc_kernel_profiler.h"
 #include <sstream>
 
 namespace sc_core {
@@ -580,6 +581,7 @@ sc_process_b::sc_process_b( const char* name_p, bool is_thread, bool free_host,
     m_throw_status( THROW_NONE ),
     m_timed_out(false),
     m_timeout_event_p(0),
+    m_thread_safe(false),
     m_trigger_type(STATIC),
     m_unwinding(false)
 {
@@ -602,6 +604,7 @@ sc_process_b::sc_process_b( const char* name_p, bool is_thread, bool free_host,
 //------------------------------------------------------------------------------
 sc_process_b::~sc_process_b()
 {
+    SC_KERNEL_PROFILE_( simcontext(), destroyed( this ) );
 
     // REDIRECT ANY CHILDREN AS CHILDREN OF THE SIMULATION CONTEXT:
 
@@ -351,6 +351,8 @@ class SC_API sc_process_b : public sc_object {
     inline int current_state() { return m_state; }
     bool dont_initialize() const { return m_dont_init; }
     virtual void dont_initialize( bool dont );
+    bool thread_safe() const { return m_thread_safe; }
+    void thread_safe( bool safe ) { m_thread_safe = safe; }
     std::string dump_state() const;
     const ::std::vector<sc_object*>& get_child_objects() const;
     inline sc_curr_proc_kind proc_kind() const;
@@ -452,6 +454,7 @@ class SC_API sc_process_b : public sc_object {
     process_throw_type           m_throw_status;    // exception throwing status
     bool                         m_timed_out;       // true if we timed out.
     sc_event*                    m_timeout_event_p; // timeout event.
+    bool                         m_thread_safe;     // may run in parallel.
     trigger_t                    m_trigger_type;    // type of trigger using.
     bool                         m_unwinding;       // true if unwinding stack.
 
@@ -130,6 +130,9 @@ class SC_API sc_process_handle {
 
   public: // implementation specific methods:
     inline std::string dump_state() const;
+    inline bool thread_safe() const
+        { return m_target_p ? m_target_p->thread_safe() : false; }
+    inline void thread_safe( bool safe );
 
   protected:
     inline bool dont_initialize() const
@@ -284,6 +287,16 @@ inline void sc_process_handle::dont_initialize( bool dont )
         SC_REPORT_WARNING( SC_ID_EMPTY_PROCESS_HANDLE_, "dont_initialize()");
 }
 
+// mark this object instance's target as safe for parallel evaluation.
+
+inline void sc_process_handle::thread_safe( bool safe )
+{
+    if ( m_target_p )
+        m_target_p->thread_safe( safe );
+    else
+        SC_REPORT_WARNING( SC_ID_EMPTY_PROCESS_HANDLE_, "thread_safe()");
+}
+
 // dump the status of this object instance's target:
 
 inline std::string sc_process_handle::dump_state() const
@@ -59,6 +59,7 @@ class SC_API sc_runnable
     inline void execute_thread_next( sc_thread_handle );
 
     inline void push_back_method( sc_method_handle );
+    inline void push_back_methods( sc_method_handle, sc_method_handle );
     inline void push_back_thread( sc_thread_handle );
     inline void push_front_method( sc_method_handle );
     inline void push_front_thread( sc_thread_handle );
@@ -200,6 +200,25 @@ inline void sc_runnable::push_back_method( sc_method_handle method_h )
 }
 
 
+//------------------------------------------------------------------------------
+//"sc_runnable::push_back_methods"
+//
+// This method appends a chain of method processes, already linked through
+// their next_runnable() pointers, to the back of the queue of runnable
+// method processes.
+//     head_p -> first method process of the chain.
+//     tail_p -> last method process of the chain.
+//------------------------------------------------------------------------------
+inline void sc_runnable::push_back_methods( sc_method_handle head_p,
+                                            sc_method_handle tail_p )
+{
+    DEBUG_MSG(DEBUG_NAME,head_p,"pushing back methods");
+    tail_p->set_next_runnable(SC_NO_METHODS);
+    m_methods_push_tail->set_next_runnable(head_p);
+    m_methods_push_tail = tail_p;
+}
+
+
 //------------------------------------------------------------------------------
 //"sc_runnable::push_back_thread"
 //
@@ -36,6 +36,7 @@
 #include "sysc/kernel/sc_cor_qt.h"
 #include "sysc/kernel/sc_event.h"
 #include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/kernel/sc_kernel_profiler.h"
 #include "sysc/kernel/sc_module.h"
 #include "sysc/kernel/sc_module_registry.h"
 #include "sysc/kernel/sc_name_gen.h"
@@ -48,10 +49,14 @@
 #include "sysc/kernel/sc_ver.h"
 #include "sysc/kernel/sc_dynamic_processes.h"
 #include "sysc/kernel/sc_phase_callback_registry.h"
+#include "sysc/kernel/sc_worker_pool.h"
 #include "sysc/communication/sc_port.h"
 #include "sysc/communication/sc_export.h"
 #include "sysc/communication/sc_prim_channel.h"
+#include "sysc/communication/sc_signal.h"
+#include "sysc/communication/sc_host_mutex.h"
 #include "sysc/tracing/sc_trace.h"
+#include "sysc/tracing/sc_trace_file_base.h"
 #include "sysc/utils/sc_mempool.h"
 #include "sysc/utils/sc_list.h"
 #include "sysc/utils/sc_string_view.h"
@@ -186,6 +191,127 @@ sc_process_table::queue<ProcessHandle>::remove( ProcessHandle handle )
     return NULL;
 }
 
+// ----------------------------------------------------------------------------
+//  CLASS : sc_parallel_evaluator
+//
+//  State of the parallel evaluation of thread-safe method processes.
+//
+//  A batch of thread-safe methods taken from the front of the runnable queue
+//  is distributed in chunks over the workers of a sc_worker_pool.  Kernel
+//  actions issued by the methods (event notifications and cancellations,
+//  update requests, and dynamic sensitivity) are not executed immediately,
+//  but appended to the action log of the executing worker.  Once the batch is
+//  complete, the simulator thread applies the logged actions in the order of
+//  the batch, i.e., in the same order as a sequential evaluation would have
+//  issued them.  Therefore, the results do not depend on the number of
+//  workers or on the scheduling of the host threads.
+//
+//  Optionally, the update phase is performed the same way: the update list
+//  is distributed over the workers, and the kernel actions of each channel
+//  (event notifications, value change callbacks of trace files, and resets)
+//  are applied afterwards in the order of the update list.
+// ----------------------------------------------------------------------------
+
+class sc_parallel_evaluator : public sc_worker_task
+{
+  public:
+    struct action
+    {
+        enum kind_t { NOTIFY, NOTIFY_DELAYED, CANCEL, REQUEST_UPDATE,
+                      NEXT_TRIGGER, NOTIFY_NEXT_DELTA, VALUE_CHANGED, RESET,
+                      NOTIFY_DELAYED_DEPRECATED };
+
+        kind_t                   m_kind;
+        bool                     m_timeout;    // next_trigger with timeout.
+        sc_event*                m_event_p;
+        const sc_event_or_list*  m_or_list_p;
+        const sc_event_and_list* m_and_list_p;
+        sc_prim_channel*         m_channel_p;
+        sc_signal_trace_hook*    m_hook_p;
+        sc_reset*                m_reset_p;
+        sc_time                  m_time;
+    };
+
+    struct slice // the actions of a single method (or channel) of the batch
+    {
+        int                      m_worker;     // worker executing the method.
+        std::size_t              m_begin;      // first action in worker log.
+        std::size_t              m_end;        // end of actions in worker log.
+        sc_report*               m_error_p;    // error raised by the method.
+        sc_dt::uint64            m_ticks;      // its wall time, if profiled.
+    };
+
+    struct worker
+    {
+        sc_curr_proc_info        m_curr_proc_info; // method being executed.
+        slice*                   m_slice_p;        // its slice of the batch.
+        std::vector<action>      m_log;            // deferred actions.
+    };
+
+  public:
+    sc_parallel_evaluator( sc_simcontext* simc_p, int num_workers )
+      : m_simc_p( simc_p ), m_pool( num_workers ), m_workers(), m_batch()
+      , m_slices(), m_mutex(), m_next( 0 ), m_chunk( 1 ), m_stop( false )
+      , m_min_batch( 0 ), m_updates(), m_update_enabled( false )
+      , m_updating( false ), m_min_updates( 0 )
+      , m_elaboration_enabled( false )
+    {
+        m_workers.resize( m_pool.size() );
+        m_min_batch = 8 * m_pool.size();
+        m_min_updates = 1024 * m_pool.size();
+    }
+
+    virtual void run( int worker )
+    {
+        if ( m_updating )
+            m_simc_p->update_worker( worker );
+        else
+            m_simc_p->crunch_worker( worker );
+    }
+
+    worker& current()
+    {
+        int worker_index = sc_worker_pool::current_worker();
+        sc_assert( worker_index >= 0 );
+        return m_workers[ worker_index ];
+    }
+
+    action& defer( action::kind_t kind )
+    {
+        std::vector<action>& log = current().m_log;
+        log.push_back( action() );
+        action& a = log.back();
+        a.m_kind       = kind;
+        a.m_timeout    = false;
+        a.m_event_p    = 0;
+        a.m_or_list_p  = 0;
+        a.m_and_list_p = 0;
+        a.m_channel_p  = 0;
+        a.m_hook_p     = 0;
+        a.m_reset_p    = 0;
+        return a;
+    }
+
+  public:
+    sc_simcontext*                m_simc_p;    // the simulation context.
+    sc_worker_pool                m_pool;      // the host threads.
+    std::vector<worker>           m_workers;   // per-worker state.
+    std::vector<sc_method_handle> m_batch;     // methods to execute.
+    std::vector<slice>            m_slices;    // per-method action slices.
+    sc_host_mutex                 m_mutex;     // protects m_next and m_stop.
+    std::size_t                   m_next;      // next method to hand out.
+    std::size_t                   m_chunk;     // methods per hand out.
+    bool                          m_stop;      // an error has occurred.
+    std::size_t                   m_min_batch; // smaller batches run serially.
+
+    std::vector<sc_prim_channel*> m_updates;        // channels to update.
+    bool                          m_update_enabled; // SC_PARALLEL_UPDATE.
+    bool                          m_updating;       // update in progress.
+    std::size_t                   m_min_updates;    // shorter lists serially.
+
+    bool                          m_elaboration_enabled; // SC_PARALLEL_ELABORATION.
+};
+
 // IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
 
 sc_method_handle
@@ -334,11 +460,19 @@ sc_simcontext::init()
     else
         m_write_check = SC_SIGNAL_WRITE_CHECK_DEFAULT_;
 
+    const char* timed_queue = std::getenv("SC_TIMED_EVENT_QUEUE");
+    sc_string_view timed_queue_s = (timed_queue != NULL) ? timed_queue : "";
+    bool calendar_queue = ( timed_queue_s == "CALENDAR" );
+
+    const char* stack_report = std::getenv("SC_STACK_USAGE_REPORT");
+    sc_string_view stack_report_s = (stack_report != NULL) ? stack_report : "";
+    m_stack_usage_report = ( stack_report_s == "ENABLE" );
+
     // FINISH INITIALIZATIONS:
 
     reset_curr_proc();
     m_next_proc_id = -1;
-    m_timed_events = new sc_ppq<sc_event_timed*>( 128, sc_notify_time_compare );
+    m_timed_events = new sc_calendar_queue( calendar_queue );
     m_something_to_trace = false;
     m_runnable = new sc_runnable;
     m_collectable = new sc_process_list;
@@ -358,18 +492,29 @@ sc_simcontext::init()
     m_method_invoker_p = NULL;
     m_cor = 0;
     m_reset_finder_q = 0;
+    m_parallel_evaluator = 0;
+    m_parallel_evaluation = false;
+    m_kernel_profiler = 0;
     m_in_simulator_control = false;
     m_start_of_simulation_called = false;
     m_end_of_simulation_called = false;
     m_simulation_status = SC_ELABORATION;
+    m_stack_usage_reported = false;
+    m_deleted_stacks.clear();
+    m_spawned_stacks = 0;
+    m_spawned_stack_usage = 0;
+    m_spawned_stack_size = 0;
 }
 
 void
 sc_simcontext::clean()
 {
+    flush_trace_files();
+
     // remove remaining zombie processes
     do_collect_processes();
 
+    delete m_parallel_evaluator;
     delete m_method_invoker_p;
     delete m_error;
     delete m_cor_pkg;
@@ -395,6 +540,9 @@ sc_simcontext::clean()
         m_reset_finder_q = rf->m_next_p;
         delete rf;
     }
+
+    delete m_kernel_profiler;
+    m_kernel_profiler = 0;
 }
 
 
@@ -413,7 +561,12 @@ sc_simcontext::sc_simcontext() :
     m_execution_phase(phase_initialize), m_error(0),
     m_in_simulator_control(false), m_end_of_simulation_called(false),
     m_simulation_status(SC_ELABORATION), m_start_of_simulation_called(false),
-    m_cor_pkg(0), m_cor(0), m_reset_finder_q(0)
+    m_cor_pkg(0), m_cor(0), m_reset_finder_q(0),
+    m_parallel_evaluator(0), m_parallel_evaluation(false),
+    m_kernel_profiler(0),
+    m_stack_usage_report(false), m_stack_usage_reported(false),
+    m_deleted_stacks(), m_spawned_stacks(0), m_spawned_stack_usage(0),
+    m_spawned_stack_size(0)
 {
     init();
 }
@@ -483,9 +636,19 @@ sc_simcontext::crunch( bool once )
 	    sc_method_handle method_h = pop_runnable_method();
 	    while( method_h != 0 ) {
 		empty_eval_phase = false;
-		if ( !method_h->run_process() )
+		if ( m_parallel_evaluator && method_h->thread_safe() )
+		{
+		    if ( !crunch_thread_safe_methods( method_h ) )
+		    {
+			goto out;
+		    }
+		}
+		else
 		{
-		    goto out;
+		    SC_KERNEL_PROFILE_( this, activate( method_h ) );
+		    bool ok = method_h->run_process();
+		    SC_KERNEL_PROFILE_( this, deactivate() );
+		    if ( !ok ) goto out;
 		}
 		method_h = pop_runnable_method();
 	    }
@@ -501,7 +664,9 @@ sc_simcontext::crunch( bool once )
 
 	    if( thread_h != 0 ) {
 	        empty_eval_phase = false;
+		SC_KERNEL_PROFILE_( this, activate( thread_h ) );
 		m_cor_pkg->yield( thread_h->m_cor_p );
+		SC_KERNEL_PROFILE_( this, deactivate() );
 	    }
 	    if( m_error ) {
 		goto out;
@@ -534,7 +699,9 @@ sc_simcontext::crunch( bool once )
 //	    SC_DO_PHASE_CALLBACK_(evaluation_done);
 	    m_change_stamp++;
 	}
+	SC_KERNEL_PROFILE_( this, update_begin() );
 	m_prim_channel_registry->perform_update();
+	SC_KERNEL_PROFILE_( this, update_end() );
 	SC_DO_PHASE_CALLBACK_(update_done);
 	m_execution_phase = phase_notify;
 
@@ -578,8 +745,10 @@ sc_simcontext::crunch( bool once )
 	    m_delta_events.clear();
 	}
 
-	if ( !empty_eval_phase )
+	if ( !empty_eval_phase ) {
 		m_delta_count ++;
+		SC_KERNEL_PROFILE_( this, delta_cycle() );
+	}
 
 	if( m_runnable->is_empty() ) {
 	    // no more runnable processes
@@ -604,6 +773,542 @@ out:
     if( m_error ) throw *m_error; // re-throw propagated error
 }
 
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::crunch_thread_safe_methods"
+// |
+// | This method executes the given thread-safe method together with all
+// | thread-safe methods immediately following it in the runnable queue. If
+// | the batch is large enough, its methods are evaluated in parallel by the
+// | workers of the parallel evaluator. The kernel actions deferred by the
+// | methods are applied afterwards, in the order of the batch.
+// |
+// | As in a serial evaluation, a method of the batch stays marked runnable
+// | until it has run, or until its actions are applied, so that it is not
+// | queued again by a notification of a method preceding it in the batch.
+// |
+// | Arguments:
+// |     method_h -> first method of the batch, popped by the caller.
+// | Result is false if an unfielded exception occurred, true if not.
+// +----------------------------------------------------------------------------
+// A non-zero, non-legal queue link marking a method of a batch as runnable,
+// like the queue empty indicator of sc_runnable.
+static const sc_method_handle batched_method_mark =
+    reinterpret_cast<sc_method_handle>( 0xdb );
+
+bool
+sc_simcontext::crunch_thread_safe_methods( sc_method_handle method_h )
+{
+    sc_parallel_evaluator&         pe = *m_parallel_evaluator;
+    std::vector<sc_method_handle>& batch = pe.m_batch;
+
+    // COLLECT THE BATCH, STOPPING AT THE FIRST NON-THREAD-SAFE METHOD:
+
+    batch.clear();
+    batch.push_back( method_h );
+    method_h->set_next_runnable( batched_method_mark );
+    for ( ;; )
+    {
+        sc_method_handle next_h = m_runnable->pop_method();
+        if ( next_h == 0 ) break;
+        if ( !next_h->thread_safe() )
+        {
+            m_runnable->execute_method_next( next_h );
+            break;
+        }
+        next_h->set_next_runnable( batched_method_mark );
+        batch.push_back( next_h );
+    }
+
+    // SMALL BATCHES ARE NOT WORTH THE SYNCHRONIZATION OVERHEAD:
+
+    if ( batch.size() < pe.m_min_batch )
+    {
+        for ( std::size_t i = 0; i < batch.size(); ++i )
+        {
+            batch[i]->set_next_runnable( 0 );
+            set_curr_proc( batch[i] );
+            SC_KERNEL_PROFILE_( this, activate( batch[i] ) );
+            bool ok = batch[i]->run_process();
+            SC_KERNEL_PROFILE_( this, deactivate() );
+            if ( !ok )
+            {
+                while ( ++i < batch.size() )
+                    batch[i]->set_next_runnable( 0 );
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // EVALUATE THE BATCH ON ALL WORKERS:
+
+    pe.m_slices.resize( batch.size() );
+    for ( std::size_t i = 0; i < batch.size(); ++i )
+    {
+        pe.m_slices[i].m_worker  = -1;
+        pe.m_slices[i].m_error_p = 0;
+        pe.m_slices[i].m_ticks   = 0;
+    }
+    for ( std::size_t w = 0; w < pe.m_workers.size(); ++w )
+        pe.m_workers[w].m_log.clear();
+    pe.m_next  = 0;
+    pe.m_chunk = batch.size() / ( 4 * pe.m_workers.size() ) + 1;
+    pe.m_stop  = false;
+
+    reset_curr_proc();
+    m_parallel_evaluation = true;
+    pe.m_pool.run( pe );
+    m_parallel_evaluation = false;
+
+    // APPLY THE DEFERRED ACTIONS IN BATCH ORDER:
+
+    bool result = true;
+    for ( std::size_t i = 0; i < batch.size(); ++i )
+    {
+        const sc_parallel_evaluator::slice& s = pe.m_slices[i];
+        sc_method_handle method_p = batch[i];
+        method_p->set_next_runnable( 0 );
+        if ( !result || s.m_worker < 0 )
+        {
+            delete s.m_error_p;
+            continue;
+        }
+
+        set_curr_proc( method_p );
+        SC_KERNEL_PROFILE_( this, add_activation( method_p, s.m_ticks ) );
+        const std::vector<sc_parallel_evaluator::action>& log =
+            pe.m_workers[s.m_worker].m_log;
+        for ( std::size_t a = s.m_begin; a < s.m_end; ++a )
+        {
+            const sc_parallel_evaluator::action& act = log[a];
+            switch ( act.m_kind )
+            {
+              case sc_parallel_evaluator::action::NOTIFY:
+                act.m_event_p->notify();
+                break;
+              case sc_parallel_evaluator::action::NOTIFY_DELAYED:
+                act.m_event_p->notify( act.m_time );
+                break;
+              case sc_parallel_evaluator::action::NOTIFY_DELAYED_DEPRECATED:
+                act.m_event_p->notify_delayed( act.m_time );
+                break;
+              case sc_parallel_evaluator::action::CANCEL:
+                act.m_event_p->cancel();
+                break;
+              case sc_parallel_evaluator::action::REQUEST_UPDATE:
+                act.m_channel_p->request_update();
+                break;
+              case sc_parallel_evaluator::action::NOTIFY_NEXT_DELTA:
+                act.m_event_p->notify_next_delta();
+                break;
+              case sc_parallel_evaluator::action::VALUE_CHANGED:
+                act.m_hook_p->value_changed();
+                break;
+              case sc_parallel_evaluator::action::RESET:
+                act.m_reset_p->notify_processes();
+                break;
+              case sc_parallel_evaluator::action::NEXT_TRIGGER:
+                if ( act.m_event_p ) {
+                    if ( act.m_timeout )
+                        method_p->next_trigger( act.m_time, *act.m_event_p );
+                    else
+                        method_p->next_trigger( *act.m_event_p );
+                } else if ( act.m_or_list_p ) {
+                    if ( act.m_timeout )
+                        method_p->next_trigger( act.m_time, *act.m_or_list_p );
+                    else
+                        method_p->next_trigger( *act.m_or_list_p );
+                } else if ( act.m_and_list_p ) {
+                    if ( act.m_timeout )
+                        method_p->next_trigger( act.m_time, *act.m_and_list_p);
+                    else
+                        method_p->next_trigger( *act.m_and_list_p );
+                } else if ( act.m_timeout ) {
+                    method_p->next_trigger( act.m_time );
+                } else {
+                    method_p->clear_trigger();
+                }
+                break;
+            }
+        }
+        if ( s.m_error_p )
+        {
+            set_error( s.m_error_p );
+            result = false;
+        }
+    }
+    if ( result ) reset_curr_proc();
+    return result;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::crunch_worker"
+// |
+// | This method is executed by each worker of the parallel evaluator. It
+// | takes chunks of methods from the current batch until the batch is
+// | exhausted or a method raised an error.
+// |
+// | Arguments:
+// |     worker = index of the worker executing this method.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::crunch_worker( int worker )
+{
+    sc_parallel_evaluator&         pe = *m_parallel_evaluator;
+    sc_parallel_evaluator::worker& ws = pe.m_workers[worker];
+
+    ws.m_curr_proc_info.kind = SC_METHOD_PROC_;
+    for ( ;; )
+    {
+        std::size_t begin, end;
+        pe.m_mutex.lock();
+        begin = pe.m_stop ? pe.m_batch.size() : pe.m_next;
+        end = std::min( begin + pe.m_chunk, pe.m_batch.size() );
+        pe.m_next = end;
+        pe.m_mutex.unlock();
+        if ( begin >= end ) break;
+
+        for ( std::size_t i = begin; i < end; ++i )
+        {
+            sc_parallel_evaluator::slice& s = pe.m_slices[i];
+            sc_method_handle method_h = pe.m_batch[i];
+            ws.m_curr_proc_info.process_handle = method_h;
+            ws.m_slice_p = &s;
+            s.m_worker = worker;
+            s.m_begin = ws.m_log.size();
+#         if defined(SC_ENABLE_KERNEL_PROFILING)
+            sc_kernel_profiler::ticks_type start =
+              m_kernel_profiler ? sc_kernel_profiler::now() : 0;
+            bool ok = method_h->run_process();
+            if ( m_kernel_profiler )
+                s.m_ticks = sc_kernel_profiler::now() - start;
+#         else
+            bool ok = method_h->run_process();
+#         endif
+            s.m_end = ws.m_log.size();
+            if ( !ok )
+            {
+                pe.m_mutex.lock();
+                pe.m_stop = true;
+                pe.m_mutex.unlock();
+                break;
+            }
+        }
+    }
+    ws.m_curr_proc_info = sc_curr_proc_info();
+    ws.m_slice_p = 0;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::perform_parallel_update"
+// |
+// | This method performs the update phase for the given update list, if the
+// | parallel update phase is enabled. The channels of the list are
+// | distributed in chunks over the workers of the parallel evaluator, which
+// | skip channels whose update() is not thread-safe. Afterwards, the
+// | deferred kernel actions of each updated channel are applied, and the
+// | skipped channels are updated, in the order of the update list. So the
+// | results are the same as those of the serial update phase.
+// |
+// | Arguments:
+// |     update_list_p -> first channel of the update list.
+// | Result is true if the update phase has been performed, false if the
+// | caller needs to perform it.
+// +----------------------------------------------------------------------------
+bool
+sc_simcontext::perform_parallel_update( sc_prim_channel* update_list_p )
+{
+    if ( m_parallel_evaluator == 0 || !m_parallel_evaluator->m_update_enabled )
+        return false;
+
+    sc_parallel_evaluator&         pe = *m_parallel_evaluator;
+    std::vector<sc_prim_channel*>& updates = pe.m_updates;
+
+    // COLLECT THE UPDATE LIST:
+
+    updates.clear();
+    for ( sc_prim_channel* now_p = update_list_p;
+          now_p != (sc_prim_channel*)sc_prim_channel::list_end;
+          now_p = now_p->m_update_next_p )
+    {
+        updates.push_back( now_p );
+    }
+
+    // SHORT LISTS ARE NOT WORTH THE SYNCHRONIZATION OVERHEAD:
+
+    if ( updates.size() < pe.m_min_updates )
+    {
+        for ( std::size_t i = 0; i < updates.size(); ++i )
+            updates[i]->perform_update();
+        return true;
+    }
+
+    // UPDATE THE THREAD-SAFE CHANNELS ON ALL WORKERS:
+
+    pe.m_slices.resize( updates.size() );
+    for ( std::size_t i = 0; i < updates.size(); ++i )
+    {
+        pe.m_slices[i].m_worker  = -1;
+        pe.m_slices[i].m_error_p = 0;
+    }
+    for ( std::size_t w = 0; w < pe.m_workers.size(); ++w )
+        pe.m_workers[w].m_log.clear();
+    pe.m_next  = 0;
+    pe.m_chunk = updates.size() / ( 4 * pe.m_workers.size() ) + 1;
+    pe.m_stop  = false;
+
+    pe.m_updating = true;
+    m_parallel_evaluation = true;
+    pe.m_pool.run( pe );
+    m_parallel_evaluation = false;
+    pe.m_updating = false;
+
+    // APPLY THE DEFERRED ACTIONS IN LIST ORDER, UPDATE THE SKIPPED CHANNELS:
+
+    sc_report* error_p = 0;
+    for ( std::size_t i = 0; i < updates.size(); ++i )
+    {
+        const sc_parallel_evaluator::slice& s = pe.m_slices[i];
+        if ( error_p )
+        {
+            delete s.m_error_p;
+            continue;
+        }
+        if ( s.m_worker < 0 )
+        {
+            try {
+                updates[i]->perform_update();
+            }
+            catch( ... ) {
+                for ( std::size_t j = i + 1; j < updates.size(); ++j )
+                    delete pe.m_slices[j].m_error_p;
+                throw;
+            }
+            continue;
+        }
+
+        const std::vector<sc_parallel_evaluator::action>& log =
+            pe.m_workers[s.m_worker].m_log;
+        for ( std::size_t a = s.m_begin; a < s.m_end; ++a )
+        {
+            const sc_parallel_evaluator::action& act = log[a];
+            switch ( act.m_kind )
+            {
+              case sc_parallel_evaluator::action::NOTIFY:
+                act.m_event_p->notify();
+                break;
+              case sc_parallel_evaluator::action::NOTIFY_DELAYED:
+                act.m_event_p->notify( act.m_time );
+                break;
+              case sc_parallel_evaluator::action::NOTIFY_DELAYED_DEPRECATED:
+                act.m_event_p->notify_delayed( act.m_time );
+                break;
+              case sc_parallel_evaluator::action::CANCEL:
+                act.m_event_p->cancel();
+                break;
+              case sc_parallel_evaluator::action::REQUEST_UPDATE:
+                act.m_channel_p->request_update();
+                break;
+              case sc_parallel_evaluator::action::NOTIFY_NEXT_DELTA:
+                act.m_event_p->notify_next_delta();
+                break;
+              case sc_parallel_evaluator::action::VALUE_CHANGED:
+                act.m_hook_p->value_changed();
+                break;
+              case sc_parallel_evaluator::action::RESET:
+                act.m_reset_p->notify_processes();
+                break;
+              case sc_parallel_evaluator::action::NEXT_TRIGGER:
+                sc_assert( false && "next_trigger() during update phase" );
+                break;
+            }
+        }
+        error_p = s.m_error_p;
+    }
+
+    if ( error_p )
+    {
+        sc_report error( *error_p );
+        delete error_p;
+        throw error;
+    }
+    return true;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::update_worker"
+// |
+// | This method is executed by each worker during a parallel update phase.
+// | It takes chunks of channels from the update list until the list is
+// | exhausted, and updates the thread-safe channels among them.
+// |
+// | Arguments:
+// |     worker = index of the worker executing this method.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::update_worker( int worker )
+{
+    sc_parallel_evaluator&         pe = *m_parallel_evaluator;
+    sc_parallel_evaluator::worker& ws = pe.m_workers[worker];
+
+    for ( ;; )
+    {
+        std::size_t begin, end;
+        pe.m_mutex.lock();
+        begin = pe.m_next;
+        end = std::min( begin + pe.m_chunk, pe.m_updates.size() );
+        pe.m_next = end;
+        pe.m_mutex.unlock();
+        if ( begin >= end ) break;
+
+        for ( std::size_t i = begin; i < end; ++i )
+        {
+            sc_prim_channel* channel_p = pe.m_updates[i];
+            if ( !channel_p->update_thread_safe() )
+                continue;
+
+            sc_parallel_evaluator::slice& s = pe.m_slices[i];
+            ws.m_slice_p = &s;
+            s.m_worker = worker;
+            s.m_begin = ws.m_log.size();
+            try {
+                channel_p->perform_update();
+            }
+            catch( ... ) {
+                s.m_error_p = sc_handle_exception();
+            }
+            s.m_end = ws.m_log.size();
+        }
+    }
+    ws.m_slice_p = 0;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::parallel_curr_proc_info"
+// |
+// | This method returns the process information of the method executed by
+// | the calling worker during a parallel evaluation.
+// +----------------------------------------------------------------------------
+sc_curr_proc_handle
+sc_simcontext::parallel_curr_proc_info()
+{
+    return &m_parallel_evaluator->current().m_curr_proc_info;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::set_parallel_error"
+// |
+// | This method records an error raised by a method during a parallel
+// | evaluation. It is propagated after the actions preceding it in batch
+// | order have been applied.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::set_parallel_error( sc_report* err )
+{
+    sc_parallel_evaluator::slice* slice_p =
+        m_parallel_evaluator->current().m_slice_p;
+    delete slice_p->m_error_p;
+    slice_p->m_error_p = err;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::elaboration_pool"
+// |
+// | This method returns the pool of host threads, on which the elaboration
+// | callbacks of thread-safe modules and the resolution of port bindings
+// | are executed, or NULL if the parallel elaboration is disabled.
+// +----------------------------------------------------------------------------
+sc_worker_pool*
+sc_simcontext::elaboration_pool() const
+{
+    return ( m_parallel_evaluator &&
+             m_parallel_evaluator->m_elaboration_enabled )
+           ? &m_parallel_evaluator->m_pool : 0;
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::defer_XXXX"
+// |
+// | These methods append a kernel action issued by a thread-safe method to
+// | the log of the calling worker during a parallel evaluation.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::defer_notify( sc_event& e )
+{
+    m_parallel_evaluator->defer( sc_parallel_evaluator::action::NOTIFY )
+        .m_event_p = &e;
+}
+
+void
+sc_simcontext::defer_notify( sc_event& e, const sc_time& t )
+{
+    sc_parallel_evaluator::action& a =
+        m_parallel_evaluator->defer(sc_parallel_evaluator::action::NOTIFY_DELAYED);
+    a.m_event_p = &e;
+    a.m_time = t;
+}
+
+void
+sc_simcontext::defer_notify_delayed( sc_event& e, const sc_time& t )
+{
+    sc_parallel_evaluator::action& a = m_parallel_evaluator->defer(
+        sc_parallel_evaluator::action::NOTIFY_DELAYED_DEPRECATED );
+    a.m_event_p = &e;
+    a.m_time = t;
+}
+
+void
+sc_simcontext::defer_cancel( sc_event& e )
+{
+    m_parallel_evaluator->defer( sc_parallel_evaluator::action::CANCEL )
+        .m_event_p = &e;
+}
+
+void
+sc_simcontext::defer_request_update( sc_prim_channel& prim_channel_ )
+{
+    m_parallel_evaluator->defer( sc_parallel_evaluator::action::REQUEST_UPDATE )
+        .m_channel_p = &prim_channel_;
+}
+
+void
+sc_simcontext::defer_notify_next_delta( sc_event& e )
+{
+    m_parallel_evaluator->defer(sc_parallel_evaluator::action::NOTIFY_NEXT_DELTA)
+        .m_event_p = &e;
+}
+
+void
+sc_simcontext::defer_value_changed( sc_signal_trace_hook& hook )
+{
+    m_parallel_evaluator->defer( sc_parallel_evaluator::action::VALUE_CHANGED )
+        .m_hook_p = &hook;
+}
+
+void
+sc_simcontext::defer_reset( sc_reset& reset )
+{
+    m_parallel_evaluator->defer( sc_parallel_evaluator::action::RESET )
+        .m_reset_p = &reset;
+}
+
+void
+sc_simcontext::defer_next_trigger( const sc_time* t_p, const sc_event* e_p,
+                                   const sc_event_or_list* or_list_p,
+                                   const sc_event_and_list* and_list_p )
+{
+    sc_parallel_evaluator::action& a =
+        m_parallel_evaluator->defer( sc_parallel_evaluator::action::NEXT_TRIGGER );
+    a.m_event_p = const_cast<sc_event*>( e_p );
+    a.m_or_list_p = or_list_p;
+    a.m_and_list_p = and_list_p;
+    if ( t_p )
+    {
+        a.m_timeout = true;
+        a.m_time = *t_p;
+    }
+}
+
 inline
 void
 sc_simcontext::cycle( const sc_time& t)
@@ -627,6 +1332,26 @@ sc_simcontext::elaborate()
         return;
     }
 
+    // start the workers for the parallel evaluation of thread-safe methods
+    // (and, optionally, of the elaboration callbacks of thread-safe modules)
+    const char* workers = std::getenv("SC_PARALLEL_WORKERS");
+    int num_workers = (workers != NULL) ? std::atoi( workers ) : 0;
+    if( num_workers > 1 ) {
+#     if defined(SC_ENABLE_PARALLEL_SIMULATION)
+        m_parallel_evaluator = new sc_parallel_evaluator( this, num_workers );
+        const char* update = std::getenv("SC_PARALLEL_UPDATE");
+        sc_string_view update_s = (update != NULL) ? update : "";
+        m_parallel_evaluator->m_update_enabled = ( update_s == "ENABLE" );
+        const char* elab = std::getenv("SC_PARALLEL_ELABORATION");
+        sc_string_view elab_s = (elab != NULL) ? elab : "";
+        m_parallel_evaluator->m_elaboration_enabled = ( elab_s == "ENABLE" );
+#     else
+        SC_REPORT_WARNING( SC_ID_PARALLEL_EVALUATION_,
+                           "not supported by this SystemC library build, "
+                           "SC_PARALLEL_WORKERS ignored" );
+#     endif
+    }
+
     // Instantiate the method invocation module
     // (not added to public object hierarchy)
 
@@ -687,6 +1412,22 @@ sc_simcontext::prepare_to_simulate()
     m_cor_pkg = new sc_cor_pkg_t( this );
     m_cor = m_cor_pkg->get_main();
 
+    // collect the kernel profile, if requested
+    const char* profile = std::getenv("SC_KERNEL_PROFILE");
+    sc_string_view profile_s = (profile != NULL) ? profile : "";
+    if( profile_s == "TEXT" || profile_s == "JSON" ) {
+#     if defined(SC_ENABLE_KERNEL_PROFILING)
+        m_kernel_profiler = new sc_kernel_profiler(
+          ( profile_s == "JSON" ) ? sc_kernel_profiler::JSON
+                                  : sc_kernel_profiler::TEXT,
+          std::getenv("SC_KERNEL_PROFILE_FILE") );
+#     else
+        SC_REPORT_WARNING( SC_ID_KERNEL_PROFILE_,
+                           "not supported by this SystemC library build, "
+                           "SC_KERNEL_PROFILE ignored" );
+#     endif
+    }
+
     // NOTIFY ALL OBJECTS THAT SIMULATION IS ABOUT TO START:
 
     m_simulation_status = SC_START_OF_SIMULATION;
@@ -918,7 +1659,7 @@ sc_simcontext::simulate( const sc_time& duration )
 	    do {
 		sc_event_timed* et = m_timed_events->extract_top();
 		sc_event* e = et->event();
-		delete et;
+		m_timed_events->release( et );
 		if( e != 0 ) {
 		    e->trigger();
 		}
@@ -953,6 +1694,7 @@ sc_simcontext::do_timestep(const sc_time& t)
     m_curr_time = t;
     m_change_stamp++;
     m_initial_delta_count_at_current_time = m_delta_count;
+    SC_KERNEL_PROFILE_( this, timestep() );
 }
 
 void
@@ -1038,6 +1780,119 @@ sc_simcontext::end()
     m_module_registry->simulation_done();
     SC_DO_PHASE_CALLBACK_(simulation_done);
     m_end_of_simulation_called = true;
+    flush_trace_files();
+    report_stack_usage();
+    report_kernel_profile();
+}
+
+// stack usage of a thread, as reported by sc_simcontext::report_stack_usage
+
+static std::string
+sc_stack_usage_message( const char* name, std::size_t usage, std::size_t size )
+{
+    std::stringstream msg;
+    msg << name << ": ";
+    if ( usage )
+        msg << usage;
+    else
+        msg << "unknown";
+    msg << " of " << size << " bytes";
+    return msg.str();
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::record_stack_usage"
+// | 
+// | This method records the stack usage of a thread process, before its
+// | coroutine is deleted. Terminated threads are deleted during simulation,
+// | and are no longer in the process table when the report is issued.
+// | Threads spawned during simulation are only summarised.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::record_stack_usage( sc_thread_handle thread_p )
+{
+    if ( !m_stack_usage_report || m_stack_usage_reported )
+        return;
+
+    std::size_t usage = thread_p->m_cor_p->stack_usage();
+    if ( thread_p->m_dynamic_proc == sc_process_b::SPAWN_SIM )
+    {
+        m_spawned_stacks++;
+        m_spawned_stack_usage = std::max( m_spawned_stack_usage, usage );
+        m_spawned_stack_size = std::max( m_spawned_stack_size,
+                                         thread_p->m_stack_size );
+    }
+    else
+    {
+        m_deleted_stacks.push_back( std::make_pair( thread_p->proc_id,
+          sc_stack_usage_message( thread_p->name(), usage,
+                                  thread_p->m_stack_size ) ) );
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::report_stack_usage"
+// | 
+// | This method issues an info message with the stack usage of each thread
+// | process, in the order of their creation, followed by a summary of the
+// | threads spawned during simulation. It does nothing unless enabled by
+// | SC_STACK_USAGE_REPORT=ENABLE, and only issues the report once: at the
+// | end of simulation, or when sc_main returns.
+// |
+// | The usage is the number of bytes from the top of the stack to the
+// | deepest page touched so far (or "unknown", if the coroutine package
+// | cannot determine it), and may help to choose set_stack_size() values.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::report_stack_usage()
+{
+    if ( !m_stack_usage_report || m_stack_usage_reported )
+        return;
+    m_stack_usage_reported = true;
+
+    std::vector<std::pair<int,std::string> > messages;
+    messages.swap( m_deleted_stacks );
+    for ( sc_thread_handle thread_p = m_process_table->thread_q_head();
+          thread_p; thread_p = thread_p->next_exist() )
+    {
+        if ( thread_p->m_cor_p == NULL )
+            continue;
+        messages.push_back( std::make_pair( thread_p->proc_id,
+          sc_stack_usage_message( thread_p->name(),
+                                  thread_p->m_cor_p->stack_usage(),
+                                  thread_p->m_stack_size ) ) );
+    }
+    std::sort( messages.begin(), messages.end() );
+
+    for ( std::size_t i = 0; i < messages.size(); ++i )
+        SC_REPORT_INFO( SC_ID_STACK_USAGE_, messages[i].second.c_str() );
+
+    if ( m_spawned_stacks )
+    {
+        std::stringstream msg;
+        msg << m_spawned_stacks << " threads spawned during simulation: ";
+        if ( m_spawned_stack_usage )
+            msg << "at most " << m_spawned_stack_usage;
+        else
+            msg << "unknown";
+        msg << " of " << m_spawned_stack_size << " bytes";
+        SC_REPORT_INFO( SC_ID_STACK_USAGE_, msg.str().c_str() );
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::report_kernel_profile"
+// | 
+// | This method writes the statistics collected by the kernel profiler, if
+// | enabled by SC_KERNEL_PROFILE=TEXT or SC_KERNEL_PROFILE=JSON. Like the
+// | stack usage report, it is written once: at the end of simulation, or
+// | when sc_main returns.
+// +----------------------------------------------------------------------------
+void
+sc_simcontext::report_kernel_profile()
+{
+    if ( m_kernel_profiler )
+        m_kernel_profiler->report();
 }
 
 void
@@ -1251,6 +2106,7 @@ sc_simcontext::remove_trace_file( sc_trace_file* tf )
 sc_cor*
 sc_simcontext::next_cor()
 {
+    SC_KERNEL_PROFILE_( this, deactivate() );
     if( m_error ) {
 	return m_cor;
     }
@@ -1262,6 +2118,7 @@ sc_simcontext::next_cor()
     }
 
     if( thread_h != 0 ) {
+	SC_KERNEL_PROFILE_( this, activate( thread_h ) );
 	return thread_h->m_cor_p;
     } else {
 	return m_cor;
@@ -1377,7 +2234,7 @@ sc_simcontext::next_time( sc_time& result ) const
 	    result = et->notify_time();
 	    return true;
 	}
-	delete m_timed_events->extract_top();
+	m_timed_events->release( m_timed_events->extract_top() );
     }
     return false;
 }
@@ -1517,6 +2374,19 @@ void sc_simcontext::suspend_current_process()
     }
 }
 
+// Trace files, which are not closed explicitly, are never destroyed, so
+// their output is written at the end of the simulation.
+
+void
+sc_simcontext::flush_trace_files()
+{
+    for( std::size_t i = 0; i < m_trace_files.size(); ++i )
+        m_trace_files[i]->flush();
+
+    // trace files using phase callbacks are not registered in the context
+    sc_trace_file_base::flush_open_files( this );
+}
+
 void
 sc_simcontext::trace_cycle( bool delta_cycle )
 {
@@ -1532,7 +2402,7 @@ sc_simcontext::trace_cycle( bool delta_cycle )
 
 // ----------------------------------------------------------------------------
 
-#if 1
+#if !defined(SC_ENABLE_PARALLEL_SIMULATION)
 #ifdef PURIFY
 	static sc_simcontext sc_default_global_context;
 	sc_simcontext* sc_curr_simcontext = &sc_default_global_context;
@@ -1541,25 +2411,30 @@ sc_simcontext::trace_cycle( bool delta_cycle )
 	SC_API sc_simcontext* sc_default_global_context = 0;
 #endif
 #else
-// Not MT-safe!
-static sc_simcontext* sc_curr_simcontext = 0;
+// Each host thread has a current context of its own.  Threads, which have
+// not been assigned a context, use the default global context.  It is
+// created by the main thread before any further host threads are started.
 
+static SC_HOST_THREAD_LOCAL_ sc_simcontext* sc_curr_simcontext = 0;
+SC_API sc_simcontext* sc_default_global_context = 0;
 
 SC_API sc_simcontext*
 sc_get_curr_simcontext()
 {
     if( sc_curr_simcontext == 0 ) {
-#ifdef PURIFY
-        static sc_simcontext sc_default_global_context;
-        sc_curr_simcontext = &sc_default_global_context;
-#else
-        static sc_simcontext* sc_default_global_context = new sc_simcontext;
+        if( sc_default_global_context == 0 )
+            sc_default_global_context = new sc_simcontext;
         sc_curr_simcontext = sc_default_global_context;
-#endif
     }
     return sc_curr_simcontext;
 }
-#endif // 0
+#endif // SC_ENABLE_PARALLEL_SIMULATION
+
+void
+sc_set_curr_simcontext( sc_simcontext* simc )
+{
+    sc_curr_simcontext = simc;
+}
 
 // Generates unique names within each module.
 
@@ -1687,9 +2562,10 @@ sc_start( const sc_time& duration, sc_starvation_policy p )
     if ( p == SC_RUN_TO_TIME )
         exit_time = context_p->m_curr_time + duration;
 
-    // called with duration = SC_ZERO_TIME for the first time
-    static bool init_delta_or_pending_updates =
-         ( starting_delta == 0 && exit_time == SC_ZERO_TIME );
+    // called with duration = SC_ZERO_TIME for the first time (per context)
+    bool init_delta_or_pending_updates =
+         ( context_p->m_simulation_status == SC_ELABORATION
+           && starting_delta == 0 && exit_time == SC_ZERO_TIME );
 
     // If the simulation status is bad issue the appropriate message:
 
@@ -1741,9 +2617,6 @@ sc_start( const sc_time& duration, sc_starvation_policy p )
     {
         SC_REPORT_WARNING(SC_ID_NO_SC_START_ACTIVITY_, "");
     }
-
-    // reset init/update flag for subsequent calls
-    init_delta_or_pending_updates = false;
 }
 
 SC_API void
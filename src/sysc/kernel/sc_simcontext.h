@@ -31,6 +31,7 @@
 #define SC_SIMCONTEXT_H
 
 #include "sysc/kernel/sc_cmnhdr.h"
+#include "sysc/kernel/sc_calendar_queue.h"
 #include "sysc/kernel/sc_process.h"
 #include "sysc/kernel/sc_status.h"
 #include "sysc/kernel/sc_time.h"
@@ -49,20 +50,28 @@ namespace sc_core {
 class sc_cor;
 class sc_cor_pkg;
 class sc_event;
+class sc_event_and_list;
+class sc_event_or_list;
 class sc_event_timed;
 class sc_export_registry;
+class sc_kernel_profiler;
 class sc_module;
 class sc_module_name;
 class sc_module_registry;
 class sc_name_gen;
 class sc_object;
 class sc_object_manager;
+class sc_parallel_evaluator;
+class sc_worker_pool;
 class sc_phase_callback_registry;
 class sc_process_handle;
 class sc_port_registry;
+class sc_prim_channel;
 class sc_prim_channel_registry;
 class sc_process_table;
+class sc_reset;
 class sc_signal_bool_deval;
+class sc_signal_trace_hook;
 class sc_trace_file;
 class sc_runnable;
 class sc_process_host;
@@ -145,6 +154,8 @@ struct sc_invoke_method;
 class SC_API sc_simcontext
 {
     friend struct sc_invoke_method; 
+    friend class sc_parallel_evaluator;
+    friend class sc_island_scheduler;
     friend class sc_event;
     friend class sc_module;
     friend class sc_object;
@@ -194,6 +205,13 @@ public:
     void simulate( const sc_time& duration );
     void stop();
     void end();
+
+    // report the stack usage of all threads (SC_STACK_USAGE_REPORT)
+    void report_stack_usage();
+    // write the kernel profile (SC_KERNEL_PROFILE)
+    void report_kernel_profile();
+    // write the pending output of all trace files
+    void flush_trace_files();
     void reset();
 
     int sim_status() const;
@@ -271,6 +289,8 @@ public:
     sc_dt::uint64 change_stamp() const;
     sc_dt::uint64 delta_count() const;
     sc_dt::uint64 delta_count_at_current_time() const;
+    int timed_events_live() const;
+    int timed_events_cancelled() const;
     bool event_occurred( sc_dt::uint64 last_change_count ) const;
     bool evaluation_phase() const;
     bool is_running() const;
@@ -287,6 +307,32 @@ public:
 
     const ::std::vector<sc_object*>& get_child_objects() const;
 
+    // statistics of processes, events and phases (or NULL if disabled)
+    sc_kernel_profiler* kernel_profiler() const;
+
+    // kernel actions issued by thread-safe method processes, which are
+    // evaluated in parallel, are deferred until the end of their batch
+    bool in_parallel_evaluation() const;
+    void defer_notify( sc_event& );
+    void defer_notify( sc_event&, const sc_time& );
+    void defer_notify_delayed( sc_event&, const sc_time& );
+    void defer_cancel( sc_event& );
+    void defer_request_update( sc_prim_channel& );
+    void defer_next_trigger( const sc_time*, const sc_event*,
+                             const sc_event_or_list*,
+                             const sc_event_and_list* );
+
+    // the update phase of thread-safe primitive channels is performed in
+    // parallel as well, if enabled (SC_PARALLEL_UPDATE)
+    bool perform_parallel_update( sc_prim_channel* update_list_p );
+    void defer_notify_next_delta( sc_event& );
+    void defer_value_changed( sc_signal_trace_hook& );
+    void defer_reset( sc_reset& );
+
+    // the elaboration callbacks of thread-safe modules and the resolution
+    // of port bindings run on this pool, if enabled (SC_PARALLEL_ELABORATION)
+    sc_worker_pool* elaboration_pool() const;
+
     void elaborate();
     void prepare_to_simulate();
     inline void initial_crunch( bool no_crunch );
@@ -301,10 +347,17 @@ private:
     void remove_child_object( sc_object* );
 
     void crunch( bool once=false );
+    bool crunch_thread_safe_methods( sc_method_handle );
+    void crunch_worker( int worker );
+    void update_worker( int worker );
+    sc_curr_proc_handle parallel_curr_proc_info();
+    void set_parallel_error( sc_report* );
 
     int add_delta_event( sc_event* );
     void remove_delta_event( sc_event* );
-    void add_timed_event( sc_event_timed* );
+    sc_event_timed* add_timed_event( sc_event*, const sc_time& );
+    void remove_timed_event( sc_event_timed* );
+    sc_event_timed* reschedule_timed_event( sc_event_timed*, const sc_time& );
 
     void trace_cycle( bool delta_cycle );
 
@@ -318,6 +371,7 @@ private:
     inline void preempt_with( sc_thread_handle );
 
     void push_runnable_method( sc_method_handle );
+    void push_runnable_methods( sc_method_handle, sc_method_handle );
     void push_runnable_thread( sc_thread_handle );
 
     void push_runnable_method_front( sc_method_handle );
@@ -337,6 +391,8 @@ private:
     sc_method_handle remove_process( sc_method_handle );
     sc_thread_handle remove_process( sc_thread_handle );
 
+    void record_stack_usage( sc_thread_handle );
+
 private:
 
     enum execution_phases {
@@ -367,7 +423,7 @@ private:
     std::vector<sc_object*>     m_child_objects;
 
     std::vector<sc_event*>      m_delta_events;
-    sc_ppq<sc_event_timed*>*    m_timed_events;
+    sc_calendar_queue*          m_timed_events;
 
     std::vector<sc_trace_file*> m_trace_files;
     bool                        m_something_to_trace;
@@ -399,6 +455,19 @@ private:
 
     sc_reset_finder*            m_reset_finder_q; // Q of reset finders to reconcile.
 
+    sc_parallel_evaluator*      m_parallel_evaluator;  // (or NULL if disabled)
+    bool                        m_parallel_evaluation; // batch in progress.
+
+    sc_kernel_profiler*         m_kernel_profiler; // (or NULL if disabled)
+
+    bool                        m_stack_usage_report;   // report enabled?
+    bool                        m_stack_usage_reported; // report issued?
+    std::vector<std::pair<int,std::string> >
+                                m_deleted_stacks;       // (id, usage) of threads.
+    std::size_t                 m_spawned_stacks;       // of spawned threads,
+    std::size_t                 m_spawned_stack_usage;  // their max. usage,
+    std::size_t                 m_spawned_stack_size;   // and max. size.
+
 private:
 
     // disabled
@@ -408,9 +477,9 @@ private:
 
 // IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
 
-// Not MT safe.
+// Not MT safe, unless SC_ENABLE_PARALLEL_SIMULATION is defined.
 
-#if 1
+#if !defined(SC_ENABLE_PARALLEL_SIMULATION)
 extern SC_API sc_simcontext* sc_curr_simcontext;
 extern SC_API sc_simcontext* sc_default_global_context;
 
@@ -424,8 +493,9 @@ sc_get_curr_simcontext()
     return sc_curr_simcontext;
 }
 #else
+    // the current context of the calling host thread (see sc_island)
     extern SC_API sc_simcontext* sc_get_curr_simcontext();
-#endif // 0
+#endif // SC_ENABLE_PARALLEL_SIMULATION
 inline sc_status sc_get_status()
 {
     return sc_get_curr_simcontext()->get_status();
@@ -503,6 +573,9 @@ inline
 sc_curr_proc_handle
 sc_simcontext::get_curr_proc_info()
 {
+    if( SC_UNLIKELY_( m_parallel_evaluation ) ) {
+        return parallel_curr_proc_info();
+    }
     return &m_curr_proc_info;
 }
 
@@ -539,6 +612,20 @@ sc_simcontext::delta_count_at_current_time() const
     return m_delta_count - m_initial_delta_count_at_current_time;
 }
 
+// pending timed notifications, and cancelled ones still to be dropped
+
+inline int
+sc_simcontext::timed_events_live() const
+{
+    return m_timed_events->live();
+}
+
+inline int
+sc_simcontext::timed_events_cancelled() const
+{
+    return m_timed_events->cancelled();
+}
+
 inline
 const sc_time&
 sc_simcontext::time_stamp() const
@@ -562,6 +649,20 @@ sc_simcontext::evaluation_phase() const
            m_ready_to_simulate;
 }
 
+inline
+bool
+sc_simcontext::in_parallel_evaluation() const
+{
+    return m_parallel_evaluation;
+}
+
+inline
+sc_kernel_profiler*
+sc_simcontext::kernel_profiler() const
+{
+    return m_kernel_profiler;
+}
+
 inline
 bool
 sc_simcontext::update_phase() const
@@ -580,6 +681,10 @@ inline
 void
 sc_simcontext::set_error( sc_report* err )
 {
+    if( SC_UNLIKELY_( m_parallel_evaluation ) ) {
+        set_parallel_error( err );
+        return;
+    }
     delete m_error;
     m_error = err;
 }
@@ -600,11 +705,25 @@ sc_simcontext::add_delta_event( sc_event* e )
     return static_cast<int>( m_delta_events.size() - 1 );
 }
 
+inline
+sc_event_timed*
+sc_simcontext::add_timed_event( sc_event* e, const sc_time& t )
+{
+    return m_timed_events->insert( e, t );
+}
+
 inline
 void
-sc_simcontext::add_timed_event( sc_event_timed* et )
+sc_simcontext::remove_timed_event( sc_event_timed* et )
+{
+    m_timed_events->cancel( et );
+}
+
+inline
+sc_event_timed*
+sc_simcontext::reschedule_timed_event( sc_event_timed* et, const sc_time& t )
 {
-    m_timed_events->insert( et );
+    return m_timed_events->reschedule( et, t );
 }
 
 // ----------------------------------------------------------------------------
@@ -61,6 +61,9 @@
 
 namespace sc_core {
 
+// sets the current simulation context of the calling host thread
+void sc_set_curr_simcontext( sc_simcontext* );
+
 inline
 const char*
 sc_get_current_process_name( const char * if_empty = NULL )
@@ -146,7 +149,7 @@ sc_simcontext::preempt_with( sc_thread_handle thread_h )
     if ( thread_h->next_runnable() != NULL )
 	remove_runnable_thread( thread_h );
 
-    // THE CALLER IS A METHOD:
+    // THE CALLER IS A METHOD (OR THE SIMULATOR):
     //
     //   (a) Set the current process information to our thread.
     //   (b) If the method was called by an invoker thread push that thread
@@ -178,7 +181,7 @@ sc_simcontext::preempt_with( sc_thread_handle thread_h )
 	m_cor_pkg->yield( thread_h->m_cor_p );
 	m_curr_proc_info = caller_info;
         DEBUG_MSG(DEBUG_NAME, thread_h, "back from preempting method w/thread");
-	method_p->check_for_throws();
+	if ( method_p ) method_p->check_for_throws();
     }
 
     // CALLER IS A THREAD, BUT NOT THE THREAD TO BE RUN:
@@ -220,6 +223,14 @@ sc_simcontext::push_runnable_method( sc_method_handle method_h )
     m_runnable->push_back_method( method_h );
 }
 
+inline
+void
+sc_simcontext::push_runnable_methods( sc_method_handle head_p,
+                                      sc_method_handle tail_p )
+{
+    m_runnable->push_back_methods( head_p, tail_p );
+}
+
 inline
 void
 sc_simcontext::push_runnable_method_front( sc_method_handle method_h )
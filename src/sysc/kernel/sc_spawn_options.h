@@ -64,7 +64,8 @@ class SC_API sc_spawn_options {
     sc_spawn_options() :                  
         m_dont_initialize(false), m_resets(), m_sensitive_events(),
         m_sensitive_event_finders(), m_sensitive_interfaces(),
-        m_sensitive_port_bases(), m_spawn_method(false), m_stack_size(0)
+        m_sensitive_port_bases(), m_spawn_method(false), m_stack_size(0),
+        m_thread_safe(false)
         { }
 
     ~sc_spawn_options();
@@ -102,6 +103,8 @@ class SC_API sc_spawn_options {
 
     void spawn_method()                 { m_spawn_method = true; }
 
+    void thread_safe()                  { m_thread_safe = true; }
+
   protected:
     void specify_resets() const;
 
@@ -118,6 +121,7 @@ class SC_API sc_spawn_options {
     std::vector<sc_port_base*>         m_sensitive_port_bases;
     bool                               m_spawn_method; // Method not thread.
     int                                m_stack_size;   // Thread stack size.
+    bool                               m_thread_safe;  // Parallel method.
 };
 
 } // namespace sc_core
@@ -476,6 +476,7 @@ sc_thread_process::~sc_thread_process()
     // DESTROY THE COROUTINE FOR THIS THREAD:
 
     if( m_cor_p != 0 ) {
+        simcontext()->record_stack_usage( this );
         m_cor_p->stack_protect( false );
         delete m_cor_p;
         m_cor_p = 0;
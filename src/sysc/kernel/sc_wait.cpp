@@ -274,6 +274,10 @@ next_trigger( sc_simcontext* simc )
 {
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( 0, 0, 0, 0 );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->clear_trigger();
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -289,6 +293,10 @@ next_trigger( const sc_event& e, sc_simcontext* simc )
 {
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( 0, &e, 0, 0 );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( e );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -307,6 +315,10 @@ next_trigger( const sc_event_or_list& el, sc_simcontext* simc )
 
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( 0, 0, &el, 0 );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( el );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -325,6 +337,10 @@ next_trigger( const sc_event_and_list& el, sc_simcontext* simc )
 
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( 0, 0, 0, &el );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( el );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -337,6 +353,10 @@ next_trigger( const sc_time& t, sc_simcontext* simc )
 {
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( &t, 0, 0, 0 );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( t );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -349,6 +369,10 @@ next_trigger( const sc_time& t, const sc_event& e, sc_simcontext* simc )
 {
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( &t, &e, 0, 0 );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( t, e );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -367,6 +391,10 @@ next_trigger( const sc_time& t, const sc_event_or_list& el, sc_simcontext* simc)
 
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( &t, 0, &el, 0 );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( t, el );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -385,6 +413,10 @@ next_trigger(const sc_time& t, const sc_event_and_list& el, sc_simcontext* simc)
 
     sc_curr_proc_handle cpi = simc->get_curr_proc_info();
     if( cpi->kind == SC_METHOD_PROC_ ) {
+        if( SC_UNLIKELY_( simc->in_parallel_evaluation() ) ) {
+            simc->defer_next_trigger( &t, 0, 0, &el );
+            return;
+        }
 	reinterpret_cast<sc_method_handle>( cpi->process_handle )->next_trigger( t, el );
     } else {
 	SC_REPORT_ERROR( SC_ID_NEXT_TRIGGER_NOT_ALLOWED_, "\n        "
@@ -0,0 +1,294 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_worker_pool.cpp -- Pool of host threads executing kernel-internal tasks.
+
+ CHANGE LOG APPEARS AT THE END OF THE FILE
+ *****************************************************************************/
+
+#include "sysc/kernel/sc_worker_pool.h"
+#include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/kernel/sc_simcontext_int.h"
+
+#include <exception>
+
+// Without SC_ENABLE_PARALLEL_SIMULATION, no host threads are created and
+// the calling thread executes all tasks as the only worker of the pool.
+
+#if !defined(SC_ENABLE_PARALLEL_SIMULATION)
+#elif SC_CPLUSPLUS >= 201103L
+# include <thread>
+#elif !defined(WIN32) && !defined(_WIN32)
+# include <pthread.h>
+#endif
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  File static variables.
+//
+//  The index of the worker executed by the current host thread. It is set
+//  once for the threads owned by a pool and for the duration of run() on
+//  the calling thread.
+// ----------------------------------------------------------------------------
+
+static SC_HOST_THREAD_LOCAL_ int current_worker_index = -1;
+
+// ----------------------------------------------------------------------------
+//  STRUCT : sc_worker_pool::worker
+//
+//  A host thread owned by the pool.
+// ----------------------------------------------------------------------------
+
+struct sc_worker_pool::worker
+{
+    worker( sc_worker_pool* pool_p, int index )
+      : m_pool_p( pool_p ), m_index( index ), m_start(), m_stop( false )
+      , m_thread()
+    {}
+
+    sc_worker_pool*   m_pool_p; // the owning pool.
+    int               m_index;  // index of this worker (> 0).
+    sc_host_semaphore m_start;  // posted to start the current task.
+    bool              m_stop;   // true: leave worker_loop().
+#if !defined(SC_ENABLE_PARALLEL_SIMULATION)
+    int               m_thread; // unused
+#elif SC_CPLUSPLUS >= 201103L
+    std::thread       m_thread;
+#elif defined(WIN32) || defined(_WIN32)
+    HANDLE            m_thread;
+#else
+    pthread_t         m_thread;
+#endif
+};
+
+#if defined(SC_ENABLE_PARALLEL_SIMULATION) && SC_CPLUSPLUS < 201103L
+extern "C" {
+# if defined(WIN32) || defined(_WIN32)
+static DWORD WINAPI sc_worker_thread_fn( LPVOID arg )
+# else
+static void* sc_worker_thread_fn( void* arg )
+# endif
+{
+    sc_worker_pool::worker_loop( static_cast<sc_worker_pool::worker*>(arg) );
+    return 0;
+}
+} // extern "C"
+#endif // SC_ENABLE_PARALLEL_SIMULATION && SC_CPLUSPLUS < 201103L
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_worker_pool
+//
+//  A fixed set of host threads, which execute a sc_worker_task in parallel.
+// ----------------------------------------------------------------------------
+
+sc_worker_pool::sc_worker_pool( int num_workers )
+  : m_workers(), m_done( 0 ), m_task( 0 ), m_simc( 0 )
+{
+    sc_assert( num_workers > 0 );
+#if defined(SC_ENABLE_PARALLEL_SIMULATION)
+    for( int i = 1; i < num_workers; ++i )
+    {
+        worker* w = new worker( this, i );
+#     if SC_CPLUSPLUS >= 201103L
+        w->m_thread = std::thread( &sc_worker_pool::worker_loop, w );
+#     elif defined(WIN32) || defined(_WIN32)
+        w->m_thread = CreateThread( NULL, 0, &sc_worker_thread_fn, w, 0, NULL );
+        sc_assert( w->m_thread != NULL );
+#     else
+        int created = pthread_create( &w->m_thread, NULL,
+                                      &sc_worker_thread_fn, w );
+        sc_assert( created == 0 );
+#     endif
+        m_workers.push_back( w );
+    }
+#endif // SC_ENABLE_PARALLEL_SIMULATION
+}
+
+sc_worker_pool::~sc_worker_pool()
+{
+#if defined(SC_ENABLE_PARALLEL_SIMULATION)
+    for( std::size_t i = 0; i < m_workers.size(); ++i )
+    {
+        worker* w = m_workers[i];
+        w->m_stop = true;
+        w->m_start.post();
+#     if SC_CPLUSPLUS >= 201103L
+        w->m_thread.join();
+#     elif defined(WIN32) || defined(_WIN32)
+        WaitForSingleObject( w->m_thread, INFINITE );
+        CloseHandle( w->m_thread );
+#     else
+        pthread_join( w->m_thread, NULL );
+#     endif
+        delete w;
+    }
+#endif // SC_ENABLE_PARALLEL_SIMULATION
+}
+
+void
+sc_worker_pool::run( sc_worker_task& task )
+{
+    sc_assert( m_task == 0 );
+    m_task = &task;
+    m_simc = sc_get_curr_simcontext();
+
+    for( std::size_t i = 0; i < m_workers.size(); ++i )
+        m_workers[i]->m_start.post();
+
+    int caller_index = current_worker_index;
+    current_worker_index = 0;
+    task.run( 0 );
+    current_worker_index = caller_index;
+
+    for( std::size_t i = 0; i < m_workers.size(); ++i )
+        m_done.wait();
+
+    m_task = 0;
+}
+
+int
+sc_worker_pool::current_worker()
+{
+    return current_worker_index;
+}
+
+void
+sc_worker_pool::worker_loop( worker* w )
+{
+    current_worker_index = w->m_index;
+    for( ;; )
+    {
+        w->m_start.wait();
+        if( w->m_stop )
+            break;
+        sc_set_curr_simcontext( w->m_pool_p->m_simc );
+        w->m_pool_p->m_task->run( w->m_index );
+        w->m_pool_p->m_done.post();
+    }
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_worker_loop
+//
+//  A task calling body( i ) for 0 <= i < size(), in parallel.
+// ----------------------------------------------------------------------------
+
+sc_worker_loop::sc_worker_loop( std::size_t size, bool affinity )
+  : m_size( size ), m_affinity( affinity ), m_workers( 1 ), m_chunk( 1 )
+  , m_next( 0 ), m_mutex()
+  , m_error_index( size ), m_error_p( 0 ), m_error_msg()
+{}
+
+sc_worker_loop::~sc_worker_loop()
+{
+    delete m_error_p;
+}
+
+void
+sc_worker_loop::execute( sc_worker_pool& pool )
+{
+    m_workers = pool.size();
+    m_chunk = m_size / ( 4 * pool.size() ) + 1;
+    m_next = 0;
+    pool.run( *this );
+
+    if( m_error_index == m_size )
+        return;
+    if( m_error_p ) {
+        sc_report err( *m_error_p );
+        delete m_error_p;
+        m_error_p = 0;
+        throw err;
+    }
+    SC_REPORT_ERROR( SC_ID_SIMULATION_UNCAUGHT_EXCEPTION_,
+                     m_error_msg.c_str() );
+}
+
+void
+sc_worker_loop::run( int worker )
+{
+    if( m_affinity ) {
+        for( std::size_t i = worker; i < m_size; i += m_workers )
+        {
+            if( !run_body( i ) )
+                break;
+        }
+        return;
+    }
+
+    for( ;; )
+    {
+        std::size_t begin, end;
+        m_mutex.lock();
+        begin = ( m_error_index < m_size ) ? m_size : m_next;
+        end = ( begin + m_chunk < m_size ) ? begin + m_chunk : m_size;
+        m_next = end;
+        m_mutex.unlock();
+        if( begin >= end )
+            break;
+
+        for( std::size_t i = begin; i < end; ++i )
+        {
+            if( !run_body( i ) )
+                break;
+        }
+    }
+}
+
+bool
+sc_worker_loop::run_body( std::size_t i )
+{
+    try {
+        body( i );
+        return true;
+    }
+    catch( const sc_report& x ) {
+        set_error( i, new sc_report( x ), 0 );
+    }
+    catch( const std::exception& x ) {
+        set_error( i, 0, x.what() );
+    }
+    catch( ... ) {
+        set_error( i, 0, "UNKNOWN EXCEPTION" );
+    }
+    return false;
+}
+
+void
+sc_worker_loop::set_error( std::size_t i, sc_report* report_p,
+                           const char* msg )
+{
+    m_mutex.lock();
+    if( i < m_error_index ) {
+        m_error_index = i;
+        delete m_error_p;
+        m_error_p = report_p;
+        m_error_msg = msg ? msg : "";
+    } else {
+        delete report_p;
+    }
+    m_mutex.unlock();
+}
+
+} // namespace sc_core
+
+// Taf!
@@ -0,0 +1,201 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_worker_pool.h -- Pool of host threads executing kernel-internal tasks.
+
+  FOR INTERNAL USE ONLY!
+
+ CHANGE LOG AT THE END OF THE FILE
+ *****************************************************************************/
+
+#ifndef SC_WORKER_POOL_H_INCLUDED_
+#define SC_WORKER_POOL_H_INCLUDED_
+
+#include "sysc/kernel/sc_cmnhdr.h"
+#include "sysc/utils/sc_report.h" // sc_assert
+#include "sysc/communication/sc_host_mutex.h"
+#include "sysc/communication/sc_host_semaphore.h"
+
+#include <string>
+#include <vector>
+
+// Storage class of variables with a value per host thread.  Without
+// SC_ENABLE_PARALLEL_SIMULATION, the simulation uses a single host thread.
+
+#if !defined(SC_ENABLE_PARALLEL_SIMULATION)
+# define SC_HOST_THREAD_LOCAL_ /* single-threaded */
+#elif SC_CPLUSPLUS >= 201103L
+# define SC_HOST_THREAD_LOCAL_ thread_local
+#elif defined(WIN32) || defined(_WIN32)
+# define SC_HOST_THREAD_LOCAL_ __declspec(thread)
+#else
+# define SC_HOST_THREAD_LOCAL_ __thread
+#endif
+
+namespace sc_core {
+
+class sc_simcontext;
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_worker_task
+//
+//  A task to be executed by all workers of a sc_worker_pool.
+// ----------------------------------------------------------------------------
+
+class sc_worker_task
+{
+public:
+    // called once on each worker, 0 <= worker < sc_worker_pool::size()
+    virtual void run( int worker ) = 0;
+
+protected:
+    virtual ~sc_worker_task() {}
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_worker_pool
+//
+//  A fixed set of host threads, which execute a sc_worker_task in parallel.
+//
+//  The thread calling run() participates as worker 0, the remaining
+//  size()-1 workers are host threads owned by the pool.  These threads are
+//  started in the constructor and block on a host semaphore between two
+//  calls to run().  During run(), they use the current simulation context
+//  of the calling thread.  All memory accesses performed by the workers
+//  during run() are visible to the calling thread after run() has returned.
+// ----------------------------------------------------------------------------
+
+class sc_worker_pool
+{
+public:
+
+    explicit sc_worker_pool( int num_workers );
+    ~sc_worker_pool();
+
+    int size() const
+        { return static_cast<int>( m_workers.size() ) + 1; }
+
+    // execute the task on all workers, returns when all of them are done
+    void run( sc_worker_task& task );
+
+    // index of the calling worker within a running pool, or -1
+    static int current_worker();
+
+public: // implementation details, used by the host thread entry function
+    struct worker;
+    static void worker_loop( worker* );
+
+private:
+    std::vector<worker*> m_workers;
+    sc_host_semaphore    m_done;
+    sc_worker_task*      m_task;
+    sc_simcontext*       m_simc; // context of the calling thread.
+
+private:
+    // disabled
+    sc_worker_pool( const sc_worker_pool& );
+    sc_worker_pool& operator = ( const sc_worker_pool& );
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_worker_loop
+//
+//  A task calling body( i ) for 0 <= i < size(), in parallel.
+//
+//  The workers take chunks of consecutive indices from a shared counter.
+//  An exception thrown by body( i ) is caught on the worker and makes the
+//  workers stop taking further chunks.  With affinity, index i is always
+//  executed by worker i % pool.size() instead, i.e., by the same host
+//  thread for a given pool, and a worker stops at its first exception
+//  without affecting the others.  Once all workers are done,
+//  execute() rethrows the exception of the smallest failing index on the
+//  calling thread; exceptions other than sc_report are turned into an
+//  error report there.
+// ----------------------------------------------------------------------------
+
+class sc_worker_loop : public sc_worker_task
+{
+public:
+
+    explicit sc_worker_loop( std::size_t size, bool affinity = false );
+    virtual ~sc_worker_loop();
+
+    std::size_t size() const
+        { return m_size; }
+
+    // execute body( i ) for all indices on the workers of the pool
+    void execute( sc_worker_pool& pool );
+
+protected:
+    virtual void body( std::size_t i ) = 0;
+
+private:
+    virtual void run( int worker );
+    bool run_body( std::size_t i );
+    void set_error( std::size_t i, sc_report* report_p, const char* msg );
+
+private:
+    std::size_t   m_size;        // number of indices.
+    bool          m_affinity;    // fixed assignment of indices to workers?
+    std::size_t   m_workers;     // number of workers of the pool.
+    std::size_t   m_chunk;       // indices per hand out.
+    std::size_t   m_next;        // next index to hand out.
+    sc_host_mutex m_mutex;       // protects m_next and the error.
+    std::size_t   m_error_index; // smallest failing index (or m_size).
+    sc_report*    m_error_p;     // its sc_report (or NULL).
+    std::string   m_error_msg;   // otherwise, the message of its exception.
+
+private:
+    // disabled
+    sc_worker_loop( const sc_worker_loop& );
+    sc_worker_loop& operator = ( const sc_worker_loop& );
+};
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_worker_member_loop<T>
+//
+//  Calls a member function of each object of a vector, in parallel.
+// ----------------------------------------------------------------------------
+
+template< class T >
+class sc_worker_member_loop : public sc_worker_loop
+{
+public:
+    typedef void (T::*member_type)();
+
+    sc_worker_member_loop( const std::vector<T*>& objects, member_type member )
+      : sc_worker_loop( objects.size() ), m_objects( objects )
+      , m_member( member )
+    {}
+
+protected:
+    virtual void body( std::size_t i )
+        { (m_objects[i]->*m_member)(); }
+
+private:
+    const std::vector<T*>& m_objects;
+    member_type            m_member;
+};
+
+} // namespace sc_core
+
+#endif // SC_WORKER_POOL_H_INCLUDED_
+// Taf!
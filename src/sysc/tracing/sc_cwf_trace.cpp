@@ -0,0 +1,935 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_cwf_trace.cpp - Implementation of compressed waveform (CWF) tracing.
+
+  The file format is described in sc_cwf_trace.h.
+
+  CHANGE LOG AT END OF FILE
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "sysc/kernel/sc_simcontext.h"
+#include "sysc/kernel/sc_ver.h"
+#include "sysc/kernel/sc_event.h"
+#include "sysc/communication/sc_signal.h"
+#include "sysc/tracing/sc_cwf_trace.h"
+#include "sysc/tracing/sc_trace_buffer.h"
+#include "sysc/datatypes/bit/sc_bit.h"
+#include "sysc/datatypes/bit/sc_logic.h"
+#include "sysc/datatypes/bit/sc_lv_base.h"
+#include "sysc/datatypes/int/sc_signed.h"
+#include "sysc/datatypes/int/sc_unsigned.h"
+#include "sysc/datatypes/int/sc_int_base.h"
+#include "sysc/datatypes/int/sc_uint_base.h"
+#include "sysc/datatypes/fx/fx.h"
+#include "sysc/utils/sc_report.h" // sc_assert
+
+namespace sc_core {
+
+static const char          cwf_magic[8]       = { 'S','C','C','W','F',0,0,1 };
+static const char          cwf_trailer_tag[8] = { 'S','C','C','W','F','I','D','X' };
+static const std::size_t   cwf_block_size     = 256 * 1024; // raw bytes
+static const int           cwf_hash_bits      = 14;
+static const std::size_t   cwf_max_distance   = 65535;
+
+typedef std::vector<unsigned char> cwf_bytes;
+
+// unsigned LEB128
+static inline void
+cwf_put_number( cwf_bytes& buf, sc_dt::uint64 v )
+{
+    while( v >= 0x80 ) {
+        buf.push_back( static_cast<unsigned char>( v | 0x80 ) );
+        v >>= 7;
+    }
+    buf.push_back( static_cast<unsigned char>( v ) );
+}
+
+// ----------------------------------------------------------------------------
+//  Value encodings, return false for values not representable in the
+//  traced width
+// ----------------------------------------------------------------------------
+
+static void
+cwf_put_bits( unsigned char* p, sc_dt::uint64 v, int width, unsigned char fill )
+{
+    int bytes = ( width + 7 ) / 8;
+    for( int i = 0; i < bytes; ++i )
+        p[i] = ( i < 8 ) ? static_cast<unsigned char>( v >> ( 8 * i ) ) : fill;
+    if( width % 8 )
+        p[bytes - 1] &= static_cast<unsigned char>( ( 1u << ( width % 8 ) ) - 1 );
+}
+
+static bool
+cwf_encode_integer( sc_dt::int64 v, int width, unsigned char* p )
+{
+    if( width < 64 ) {
+        sc_dt::int64 high = ( width > 0 ) ? ( v >> ( width - 1 ) ) : v;
+        if( high != 0 && high != -1 )
+            return false;
+    }
+    cwf_put_bits( p, static_cast<sc_dt::uint64>( v ), width, v < 0 ? 0xff : 0 );
+    return true;
+}
+
+static bool
+cwf_encode_integer( sc_dt::uint64 v, int width, unsigned char* p )
+{
+    if( width < 64 && ( v >> width ) != 0 )
+        return false;
+    cwf_put_bits( p, v, width, 0 );
+    return true;
+}
+
+static bool
+cwf_encode_real( double v, unsigned char* p )
+{
+    sc_dt::uint64 bits;
+    std::memcpy( &bits, &v, sizeof(bits) );
+    cwf_put_bits( p, bits, 64, 0 );
+    return true;
+}
+
+// bits of objects with indexed access (LSB first)
+template <class T>
+static bool
+cwf_encode_bit_vector( const T& object, int width, unsigned char* p )
+{
+    std::memset( p, 0, ( width + 7 ) / 8 );
+    for( int i = 0; i < width; ++i )
+        if( object.test( i ) )
+            p[i / 8] |= static_cast<unsigned char>( 1u << ( i % 8 ) );
+    return true;
+}
+
+template <class T>
+static bool
+cwf_encode_fx_bits( const T& object, int width, unsigned char* p )
+{
+    std::memset( p, 0, ( width + 7 ) / 8 );
+    for( int i = 0; i < width; ++i )
+        if( object[i] )
+            p[i / 8] |= static_cast<unsigned char>( 1u << ( i % 8 ) );
+    return true;
+}
+
+#define DEFN_ENCODE_INTEGER(tp, itp)                                          \
+static bool                                                                   \
+cwf_encode( const tp& object, int width, unsigned char* p )                   \
+    { return cwf_encode_integer( static_cast<itp>( object ), width, p ); }
+
+DEFN_ENCODE_INTEGER( short,          sc_dt::int64 )
+DEFN_ENCODE_INTEGER( int,            sc_dt::int64 )
+DEFN_ENCODE_INTEGER( long,           sc_dt::int64 )
+DEFN_ENCODE_INTEGER( sc_dt::int64,   sc_dt::int64 )
+DEFN_ENCODE_INTEGER( unsigned char,  sc_dt::uint64 )
+DEFN_ENCODE_INTEGER( unsigned short, sc_dt::uint64 )
+DEFN_ENCODE_INTEGER( unsigned int,   sc_dt::uint64 )
+DEFN_ENCODE_INTEGER( unsigned long,  sc_dt::uint64 )
+DEFN_ENCODE_INTEGER( sc_dt::uint64,  sc_dt::uint64 )
+
+#undef DEFN_ENCODE_INTEGER
+
+// char is traced as a signed value, like in VCD files
+static bool
+cwf_encode( const char& object, int width, unsigned char* p )
+{
+    return cwf_encode_integer(
+             static_cast<sc_dt::int64>( static_cast<signed char>( object ) ),
+             width, p );
+}
+
+static bool
+cwf_encode( const bool& object, int, unsigned char* p )
+    { p[0] = object; return true; }
+
+static bool
+cwf_encode( const sc_dt::sc_bit& object, int, unsigned char* p )
+    { p[0] = object.to_bool(); return true; }
+
+static bool
+cwf_encode( const sc_dt::sc_logic& object, int, unsigned char* p )
+    { p[0] = static_cast<unsigned char>( object.value() ); return true; }
+
+static bool
+cwf_encode( const sc_time& object, int width, unsigned char* p )
+    { return cwf_encode_integer( object.value(), width, p ); }
+
+static bool
+cwf_encode( const float& object, int, unsigned char* p )
+    { return cwf_encode_real( object, p ); }
+
+static bool
+cwf_encode( const double& object, int, unsigned char* p )
+    { return cwf_encode_real( object, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_fxval& object, int, unsigned char* p )
+    { return cwf_encode_real( object.to_double(), p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_fxval_fast& object, int, unsigned char* p )
+    { return cwf_encode_real( object.to_double(), p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_int_base& object, int width, unsigned char* p )
+    { return cwf_encode_integer( object.value(), width, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_uint_base& object, int width, unsigned char* p )
+    { return cwf_encode_integer( object.value(), width, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_signed& object, int width, unsigned char* p )
+    { return cwf_encode_bit_vector( object, width, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_unsigned& object, int width, unsigned char* p )
+    { return cwf_encode_bit_vector( object, width, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_fxnum& object, int width, unsigned char* p )
+    { return cwf_encode_fx_bits( object, width, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_fxnum_fast& object, int width, unsigned char* p )
+    { return cwf_encode_fx_bits( object, width, p ); }
+
+static bool
+cwf_encode( const sc_dt::sc_bv_base& object, int width, unsigned char* p )
+{
+    std::memset( p, 0, ( width + 7 ) / 8 );
+    for( int i = 0; i < width; ++i )
+        if( object.get_bit( i ) )
+            p[i / 8] |= static_cast<unsigned char>( 1u << ( i % 8 ) );
+    return true;
+}
+
+static bool
+cwf_encode( const sc_dt::sc_lv_base& object, int width, unsigned char* p )
+{
+    std::memset( p, 0, ( width + 3 ) / 4 );
+    for( int i = 0; i < width; ++i )
+        p[i / 4] |= static_cast<unsigned char>(
+                      ( object.get_bit( i ) & 3 ) << ( 2 * ( i % 4 ) ) );
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : cwf_trace
+//
+//  Base class for CWF traces.
+//
+//  Each trace keeps the encoded bytes of the last value written to the
+//  file.  Traces of signal values are attached to the signal channel and
+//  only checked for changes, after the channel has reported a value change.
+// ----------------------------------------------------------------------------
+
+class cwf_trace : public sc_signal_trace_hook
+{
+public:
+
+    cwf_trace( const std::string& name_,
+               cwf_trace_file::cwf_enum type_, int width_ );
+
+    virtual ~cwf_trace();
+
+    // encode the current value, returns false if it is unknown
+    virtual bool encode( unsigned char* p ) = 0;
+
+    // update the stored value, returns true if it has changed
+    virtual bool changed( unsigned char* scratch );
+
+    // store the initial value
+    virtual void initialize();
+
+    // number of bytes of an encoded value
+    int size() const;
+
+    // mark this trace for the next cycle
+    void value_changed();
+
+    const std::string name;
+    const cwf_trace_file::cwf_enum type;
+    const int width;
+    std::vector<std::string> literals;      // enumeration literals
+
+    cwf_bytes value;                        // last value written
+    bool known;                             // value representable?
+
+    const void* source;                     // address of the traced object
+    int index;                              // position in the trace file
+    bool marked;                            // in changed_list?
+    std::vector<cwf_trace*>* changed_list;  // changed traces of the file
+};
+
+cwf_trace::cwf_trace( const std::string& name_,
+                      cwf_trace_file::cwf_enum type_, int width_ )
+  : name( name_ )
+  , type( type_ )
+  , width( width_ )
+  , literals()
+  , value()
+  , known( false )
+  , source( 0 )
+  , index( 0 )
+  , marked( false )
+  , changed_list( 0 )
+{}
+
+cwf_trace::~cwf_trace()
+{}
+
+int
+cwf_trace::size() const
+{
+    switch( type ) {
+      case cwf_trace_file::CWF_BITS:  return ( width + 7 ) / 8;
+      case cwf_trace_file::CWF_LOGIC: return ( width + 3 ) / 4;
+      case cwf_trace_file::CWF_REAL:  return 8;
+      default:                        return 0;
+    }
+}
+
+void
+cwf_trace::initialize()
+{
+    value.resize( size() + 1 ); // avoid empty vectors
+    known = encode( &value[0] );
+}
+
+bool
+cwf_trace::changed( unsigned char* scratch )
+{
+    bool now_known = encode( scratch );
+    std::size_t n = value.size() - 1;
+    if( now_known == known
+        && ( !known || std::memcmp( scratch, &value[0], n ) == 0 ) )
+        return false;
+
+    known = now_known;
+    if( known )
+        std::memcpy( &value[0], scratch, n );
+    return true;
+}
+
+void
+cwf_trace::value_changed()
+{
+    if( !marked ) {
+        marked = true;
+        changed_list->push_back( this );
+    }
+}
+
+static bool
+cwf_trace_less( const cwf_trace* t1, const cwf_trace* t2 )
+{
+    return t1->index < t2->index;
+}
+
+// ----------------------------------------------------------------------------
+
+template <class T>
+class cwf_T_trace : public cwf_trace
+{
+public:
+
+    cwf_T_trace( const T& object_, const std::string& name_,
+                 cwf_trace_file::cwf_enum type_, int width_ )
+      : cwf_trace( name_, type_, width_ ), object( object_ )
+    {}
+
+    bool encode( unsigned char* p )
+        { return cwf_encode( object, width, p ); }
+
+protected:
+
+    const T& object;
+};
+
+// ----------------------------------------------------------------------------
+
+class cwf_sc_event_trace : public cwf_trace
+{
+public:
+
+    cwf_sc_event_trace( const sc_dt::uint64& trigger_stamp_,
+                        const std::string& name_ )
+      : cwf_trace( name_, cwf_trace_file::CWF_EVENT, 1 )
+      , trigger_stamp( trigger_stamp_ ), old_trigger_stamp( trigger_stamp_ )
+    {}
+
+    bool encode( unsigned char* )
+        { return true; }
+
+    void initialize()
+    {
+        cwf_trace::initialize();
+        old_trigger_stamp = trigger_stamp;
+    }
+
+    bool changed( unsigned char* )
+    {
+        if( trigger_stamp == old_trigger_stamp )
+            return false;
+        old_trigger_stamp = trigger_stamp;
+        return true;
+    }
+
+protected:
+
+    const sc_dt::uint64& trigger_stamp;
+    sc_dt::uint64 old_trigger_stamp;
+};
+
+// ----------------------------------------------------------------------------
+
+class cwf_enum_trace : public cwf_trace
+{
+public:
+
+    cwf_enum_trace( const unsigned& object_, const std::string& name_,
+                    const char** enum_literals_, int width_ )
+      : cwf_trace( name_, cwf_trace_file::CWF_BITS, width_ ), object( object_ )
+    {
+        for( int i = 0; enum_literals_[i]; ++i )
+            literals.push_back( enum_literals_[i] );
+    }
+
+    bool encode( unsigned char* p )
+    {
+        // values outside of the literals are unknown
+        return object < literals.size()
+            && cwf_encode_integer( sc_dt::uint64( object ), width, p );
+    }
+
+protected:
+
+    const unsigned& object;
+};
+
+// ----------------------------------------------------------------------------
+//  Compression of blocks
+// ----------------------------------------------------------------------------
+
+static void
+cwf_put_literals( cwf_bytes& out, const unsigned char* p, std::size_t n )
+{
+    cwf_put_number( out, n );
+    out.insert( out.end(), p, p + n );
+}
+
+static void
+cwf_compress( const cwf_bytes& in, cwf_bytes& out, std::vector<int>& table )
+{
+    const unsigned char* data = in.empty() ? 0 : &in[0];
+    const std::size_t    n    = in.size();
+
+    table.assign( std::size_t(1) << cwf_hash_bits, -1 );
+    out.clear();
+
+    std::size_t literal = 0; // start of pending literals
+    std::size_t i       = 0;
+    while( i + 4 <= n ) {
+        unsigned word;
+        std::memcpy( &word, data + i, 4 );
+        unsigned hash = static_cast<unsigned>( ( word * 2654435761u ) & 0xffffffffu )
+                        >> ( 32 - cwf_hash_bits );
+
+        int candidate = table[hash];
+        table[hash] = static_cast<int>( i );
+
+        if( candidate < 0 || i - candidate > cwf_max_distance
+            || std::memcmp( data + candidate, data + i, 4 ) != 0 ) {
+            ++i;
+            continue;
+        }
+
+        std::size_t length = 4;
+        while( i + length < n && data[candidate + length] == data[i + length] )
+            ++length;
+
+        cwf_put_literals( out, data + literal, i - literal );
+        cwf_put_number( out, length );
+        cwf_put_number( out, i - candidate );
+        i      += length;
+        literal = i;
+    }
+    cwf_put_literals( out, data + literal, n - literal );
+    cwf_put_number( out, 0 );
+}
+
+// ----------------------------------------------------------------------------
+//  CLASS : cwf_trace_file
+//
+//  Trace file in the compressed waveform format.
+// ----------------------------------------------------------------------------
+
+cwf_trace_file::cwf_trace_file( const char* name )
+  : sc_trace_file_base( name, "cwf" )
+  , traces()
+  , polled_traces()
+  , changed_traces()
+  , cycle_traces()
+  , block()
+  , step()
+  , packed()
+  , hash_table()
+  , index()
+  , scratch()
+  , comments()
+  , previous_time( 0 )
+  , block_start( 0 )
+  , block_end( 0 )
+  , offset( 0 )
+  , index_offset( 0 )
+  , block_open( false )
+  , index_written( false )
+{}
+
+cwf_trace_file::~cwf_trace_file()
+{
+    if( is_initialized() && !index_written )
+        write_index();
+
+    for( int i = 0; i < (int)traces.size(); i++ )
+        delete traces[i];
+}
+
+void
+cwf_trace_file::flush()
+{
+    // the file is complete at the end of simulation, also if not closed
+    if( is_initialized() && !index_written )
+        write_index();
+    sc_trace_file_base::flush();
+}
+
+void
+cwf_trace_file::write_index()
+{
+    // extend the trace up to the current time
+    unit_type now = time_stamp();
+    if( !block_open )
+        begin_block( now );
+    if( now > block_end )
+        block_end = now;
+    end_block();
+
+    index_offset = offset;
+    cwf_bytes idx;
+    idx.push_back( 'I' );
+    cwf_put_number( idx, index.size() / 3 );
+    for( std::size_t i = 0; i < index.size(); ++i )
+        cwf_put_number( idx, index[i] );
+    write_bytes( &idx[0], idx.size() );
+
+    unsigned char trailer[16];
+    cwf_put_bits( trailer, index_offset, 64, 0 );
+    std::memcpy( trailer + 8, cwf_trailer_tag, 8 );
+    write_bytes( trailer, sizeof(trailer) );
+    index_written = true;
+}
+
+void
+cwf_trace_file::remove_index()
+{
+    if( !index_written )
+        return;
+
+    // further records overwrite the index, which is written again later
+    out->flush();
+    std::fseek( fp, static_cast<long>( index_offset ), SEEK_SET );
+    offset = index_offset;
+    index_written = false;
+}
+
+void
+cwf_trace_file::do_initialize()
+{
+    if( !out ) open_buffer();
+
+    cwf_bytes header( cwf_magic, cwf_magic + sizeof(cwf_magic) );
+    cwf_put_number( header, trace_unit_fs );
+    write_bytes( &header[0], header.size() );
+    write_string( localtime_string() );
+    write_string( sc_version() );
+    write_number( traces.size() );
+
+    std::size_t max_size = 1;
+    for( int i = 0; i < (int)traces.size(); i++ ) {
+        cwf_trace* t = traces[i];
+        t->index = i;
+        t->initialize();
+        max_size = std::max( max_size, t->value.size() );
+
+        // traces not attached to a signal channel are checked in each cycle
+        if( !t->attached() )
+            polled_traces.push_back( t );
+
+        write_string( t->name );
+        unsigned char tp = static_cast<unsigned char>( t->type );
+        write_bytes( &tp, 1 );
+        write_number( t->width );
+        write_number( t->literals.size() );
+        for( std::size_t j = 0; j < t->literals.size(); ++j )
+            write_string( t->literals[j] );
+    }
+    scratch.resize( max_size );
+
+    // comments written before the initialization
+    for( std::size_t i = 0; i < comments.size(); ++i )
+        write_comment( comments[i] );
+    comments.clear();
+
+    // all values are up to date
+    for( int i = 0; i < (int)changed_traces.size(); i++ )
+        changed_traces[i]->marked = false;
+    changed_traces.clear();
+
+    // the first block starts with the initial values
+    previous_time = time_stamp();
+    begin_block( previous_time );
+}
+
+void
+cwf_trace_file::push_trace( cwf_trace* t, const void* source )
+{
+    t->source = source;
+    t->changed_list = &changed_traces;
+    traces.push_back( t );
+}
+
+void
+cwf_trace_file::link_last_trace( const sc_signal_channel& ch, const void* value )
+{
+    // only link the trace, if it refers to the value stored in the channel
+    if( !traces.empty() && traces.back()->source == value && !is_initialized() )
+        traces.back()->attach( ch );
+}
+
+#if SC_TRACING_PHASE_CALLBACKS_
+void cwf_trace_file::trace( sc_trace_file* ) const {
+    SC_REPORT_ERROR( sc_core::SC_ID_INTERNAL_ERROR_
+                   , "invalid call to cwf_trace_file::trace(sc_trace_file*)" );
+}
+#endif // SC_TRACING_PHASE_CALLBACKS_
+
+// ----------------------------------------------------------------------------
+
+#define DEFN_TRACE_METHOD(tp, type, width)                                    \
+void                                                                          \
+cwf_trace_file::trace( const tp& object_, const std::string& name_ )          \
+{                                                                             \
+    if( add_trace_check(name_) )                                              \
+        push_trace( new cwf_T_trace<tp>( object_, name_, type, width ),       \
+                    &object_ );                                               \
+}
+
+DEFN_TRACE_METHOD( sc_time,               CWF_BITS,  64 )
+DEFN_TRACE_METHOD( bool,                  CWF_BITS,  1 )
+DEFN_TRACE_METHOD( sc_dt::sc_bit,         CWF_BITS,  1 )
+DEFN_TRACE_METHOD( sc_dt::sc_logic,       CWF_LOGIC, 1 )
+DEFN_TRACE_METHOD( float,                 CWF_REAL,  64 )
+DEFN_TRACE_METHOD( double,                CWF_REAL,  64 )
+DEFN_TRACE_METHOD( sc_dt::sc_fxval,       CWF_REAL,  64 )
+DEFN_TRACE_METHOD( sc_dt::sc_fxval_fast,  CWF_REAL,  64 )
+DEFN_TRACE_METHOD( sc_dt::sc_int_base,    CWF_BITS,  object_.length() )
+DEFN_TRACE_METHOD( sc_dt::sc_uint_base,   CWF_BITS,  object_.length() )
+DEFN_TRACE_METHOD( sc_dt::sc_signed,      CWF_BITS,  object_.length() )
+DEFN_TRACE_METHOD( sc_dt::sc_unsigned,    CWF_BITS,  object_.length() )
+DEFN_TRACE_METHOD( sc_dt::sc_fxnum,       CWF_BITS,  object_.wl() )
+DEFN_TRACE_METHOD( sc_dt::sc_fxnum_fast,  CWF_BITS,  object_.wl() )
+DEFN_TRACE_METHOD( sc_dt::sc_bv_base,     CWF_BITS,  object_.length() )
+DEFN_TRACE_METHOD( sc_dt::sc_lv_base,     CWF_LOGIC, object_.length() )
+
+#undef DEFN_TRACE_METHOD
+
+#define DEFN_TRACE_METHOD_WIDTH(tp)                                           \
+void                                                                          \
+cwf_trace_file::trace( const tp&          object_,                            \
+                       const std::string& name_,                              \
+                       int                width_ )                            \
+{                                                                             \
+    if( add_trace_check(name_) )                                              \
+        push_trace( new cwf_T_trace<tp>( object_, name_, CWF_BITS, width_ ),  \
+                    &object_ );                                               \
+}
+
+DEFN_TRACE_METHOD_WIDTH( char )
+DEFN_TRACE_METHOD_WIDTH( short )
+DEFN_TRACE_METHOD_WIDTH( int )
+DEFN_TRACE_METHOD_WIDTH( long )
+DEFN_TRACE_METHOD_WIDTH( sc_dt::int64 )
+DEFN_TRACE_METHOD_WIDTH( unsigned char )
+DEFN_TRACE_METHOD_WIDTH( unsigned short )
+DEFN_TRACE_METHOD_WIDTH( unsigned int )
+DEFN_TRACE_METHOD_WIDTH( unsigned long )
+DEFN_TRACE_METHOD_WIDTH( sc_dt::uint64 )
+
+#undef DEFN_TRACE_METHOD_WIDTH
+
+void
+cwf_trace_file::trace( const sc_event& object_, const std::string& name_ )
+{
+    if( add_trace_check(name_) )
+        push_trace( new cwf_sc_event_trace( event_trigger_stamp(object_),
+                                            name_ ),
+                    &object_ );
+}
+
+void
+cwf_trace_file::trace( const unsigned&    object_,
+                       const std::string& name_,
+                       const char**       enum_literals_ )
+{
+    if( !add_trace_check(name_) )
+        return;
+
+    // number of bits required to represent the index of each literal
+    int nliterals = 0;
+    while( enum_literals_[nliterals] )
+        ++nliterals;
+    int width = 0;
+    for( unsigned max_index = nliterals - 1; max_index != 0; max_index >>= 1 )
+        ++width;
+
+    push_trace( new cwf_enum_trace( object_, name_, enum_literals_, width ),
+                &object_ );
+}
+
+// ----------------------------------------------------------------------------
+
+void
+cwf_trace_file::write_comment( const std::string& comment )
+{
+    // comments are written after the header
+    if( !is_initialized() ) {
+        comments.push_back( comment );
+        return;
+    }
+
+    // keep the blocks in order of time
+    end_block();
+    remove_index();
+
+    cwf_bytes record( 1, 'C' );
+    cwf_put_number( record, comment.size() );
+    write_bytes( &record[0], record.size() );
+    write_bytes( comment.data(), comment.size() );
+}
+
+void
+cwf_trace_file::cycle( bool this_is_a_delta_cycle )
+{
+    // Trace delta cycles only when enabled
+    if( !delta_cycles() && this_is_a_delta_cycle ) return;
+
+    // Check for initialization
+    if( initialize() )
+        return;
+
+    unit_type now = time_stamp();
+    bool time_advanced = ( now > previous_time );
+
+    if( !has_low_units() && sc_time_stamp().value()
+                              % ( trace_unit_fs / kernel_unit_fs ) != 0 ) {
+        std::stringstream ss;
+        ss << "\n\tCurrent kernel time is " << sc_time_stamp();
+        ss << "\n\tCWF trace time unit is " << fs_unit_to_str(trace_unit_fs);
+        ss << "\n\tUse 'tracefile->set_time_unit(double, sc_time_unit);' to increase the time resolution.";
+        SC_REPORT_WARNING( SC_ID_TRACING_CWF_TIME_RESOLUTION_, ss.str().c_str() );
+    }
+
+    if( delta_cycles() ) {
+        if( this_is_a_delta_cycle && sc_delta_count_at_current_time() == 0
+            && !time_advanced ) {
+            std::stringstream ss;
+            ss << "\n\tThis can occur when delta cycle tracing is activated."
+               << "\n\tSome delta cycles at " << sc_time_stamp()
+               << " are not shown in the trace."
+               << "\n\tUse 'tracefile->set_time_unit(double, sc_time_unit);'"
+                  " to increase the time resolution.";
+            SC_REPORT_WARNING( SC_ID_TRACING_CWF_DELTA_CYCLE_, ss.str().c_str() );
+            return;
+        }
+
+        if( !this_is_a_delta_cycle ) {
+            if( time_advanced )
+                previous_time = now;
+            // Value updates can't happen during timed notification
+            return;
+        }
+    }
+
+    // Collect the traces to check in order of declaration: the polled ones
+    // and those attached to signals, which have been updated.
+    std::vector<cwf_trace*>* check_traces = &polled_traces;
+    if( !changed_traces.empty() ) {
+        std::sort( changed_traces.begin(), changed_traces.end(), cwf_trace_less );
+        cycle_traces.resize( polled_traces.size() + changed_traces.size() );
+        std::merge( polled_traces.begin(), polled_traces.end(),
+                    changed_traces.begin(), changed_traces.end(),
+                    cycle_traces.begin(), cwf_trace_less );
+        for( int i = 0; i < (int)changed_traces.size(); i++ )
+            changed_traces[i]->marked = false;
+        changed_traces.clear();
+        check_traces = &cycle_traces;
+    }
+
+    // The frame of a new block holds the values before this cycle
+    if( !block_open )
+        begin_block( now );
+
+    step.clear();
+    int count = 0;
+    int previous_index = -1;
+    for( int i = 0; i < (int)check_traces->size(); i++ ) {
+        cwf_trace* t = (*check_traces)[i];
+        if( !t->changed( &scratch[0] ) )
+            continue;
+
+        cwf_put_number( step, ( t->index - previous_index - 1 ) * 2
+                              + ( t->known ? 0 : 1 ) );
+        if( t->known )
+            step.insert( step.end(), t->value.begin(), t->value.end() - 1 );
+        previous_index = t->index;
+        ++count;
+    }
+    if( count == 0 )
+        return;
+
+    cwf_put_number( block, now - block_end );
+    cwf_put_number( block, count );
+    block.insert( block.end(), step.begin(), step.end() );
+    block_end = now;
+
+    if( block.size() >= cwf_block_size )
+        end_block();
+}
+
+sc_trace_file_base::unit_type
+cwf_trace_file::time_stamp() const
+{
+    unit_type high, low;
+    timestamp_in_trace_units( high, low );
+    if( has_low_units() )
+        return high * ( kernel_unit_fs / trace_unit_fs ) + low;
+    return high;
+}
+
+void
+cwf_trace_file::begin_block( unit_type now )
+{
+    sc_assert( !block_open );
+
+    block.clear();
+    for( int i = 0; i < (int)traces.size(); i++ ) {
+        cwf_trace* t = traces[i];
+        block.push_back( t->known ? 1 : 0 );
+        if( t->known )
+            block.insert( block.end(), t->value.begin(), t->value.end() - 1 );
+    }
+    block_start = now;
+    block_end   = now;
+    block_open  = true;
+}
+
+void
+cwf_trace_file::end_block()
+{
+    if( !block_open )
+        return;
+
+    remove_index();
+    cwf_compress( block, packed, hash_table );
+
+    index.push_back( block_start );
+    index.push_back( block_end );
+    index.push_back( offset );
+
+    cwf_bytes record( 1, 'B' );
+    cwf_put_number( record, block_start );
+    cwf_put_number( record, block_end );
+    cwf_put_number( record, block.size() );
+    cwf_put_number( record, packed.size() );
+    write_bytes( &record[0], record.size() );
+    write_bytes( &packed[0], packed.size() );
+
+    block_open = false;
+}
+
+void
+cwf_trace_file::write_bytes( const void* data, std::size_t n )
+{
+    out->write( static_cast<const char*>( data ), n );
+    offset += n;
+}
+
+void
+cwf_trace_file::write_number( unit_type v )
+{
+    cwf_bytes buf;
+    cwf_put_number( buf, v );
+    write_bytes( &buf[0], buf.size() );
+}
+
+void
+cwf_trace_file::write_string( const std::string& s )
+{
+    write_number( s.size() );
+    write_bytes( s.data(), s.size() );
+}
+
+// ----------------------------------------------------------------------------
+
+SC_API sc_trace_file*
+sc_create_cwf_trace_file( const char* name )
+{
+    sc_trace_file* tf = new cwf_trace_file( name );
+    return tf;
+}
+
+SC_API void
+sc_close_cwf_trace_file( sc_trace_file* tf )
+{
+    cwf_trace_file* cwf_tf = static_cast<cwf_trace_file*>( tf );
+    delete cwf_tf;
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+// Taf!
@@ -0,0 +1,264 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_cwf_trace.h - Implementation of compressed waveform (CWF) tracing.
+
+  CHANGE LOG AT END OF FILE
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  CWF file format, version 1
+
+  A CWF file stores the value changes of all traced objects in compressed
+  blocks, followed by an index of the time range covered by each block.
+  Readers can locate the index via the fixed-size trailer at the end of the
+  file and only need to decompress the blocks of the time window of
+  interest.
+
+  All integers are unsigned LEB128 numbers (7 bits per byte, least
+  significant group first, bit 7 set in all but the last byte), unless
+  stated otherwise.  Strings are stored as their length and their bytes.
+  Times are given in trace time units.
+
+    file      := header record* index trailer
+    header    := "SCCWF" 0x00 0x00 0x01   -- magic and format version
+                 unit                     -- trace time unit in fs
+                 string string            -- date, SystemC version
+                 count variable*
+    variable  := string                   -- hierarchical name
+                 byte                     -- type: 0 bits, 1 logic,
+                                          --       2 real, 3 event
+                 width
+                 count string*            -- enumeration literals
+    record    := 'C' string               -- comment
+               | 'B' start end raw_size size byte[size]
+    index     := 'I' count ( start end offset )*
+    trailer   := 8 byte index offset (little endian) "SCCWFIDX"
+
+  The content of a block 'B' is compressed by the scheme described
+  below.  Its raw_size bytes contain
+
+    block     := frame step*
+    frame     := ( known value? )*        -- value of each variable
+    step      := time_delta count change*
+    change    := id_delta value?
+
+  The frame holds the values of all variables at the start time of the
+  block in their order of declaration, each preceded by a byte 1, or a
+  byte 0 instead of the value, if the value is unknown.  The time of the
+  first step is relative to the start time of the block, each further
+  step is relative to the previous step.  A change refers to variable
+  (previous id + 1 + id_delta / 2), starting with previous id -1 in each
+  step.  The lowest bit of id_delta is set, if the new value is unknown,
+  in which case the value is omitted.
+
+  Values of type bits are stored in (width + 7) / 8 bytes, starting with
+  the least significant bit.  Logic values use 2 bits per bit (0, 1, Z,
+  X as 0, 1, 2, 3) in (width + 3) / 4 bytes.  Real values are stored as
+  8 byte IEEE-754 double precision numbers (little endian).  Events have
+  no value, a change marks a notification of the event.  Unknown values
+  are shown as all X.
+
+  Compression is a byte-oriented LZ77 scheme.  The compressed data is a
+  sequence of
+
+    sequence  := literal_count byte[literal_count] match_length distance?
+
+  where match_length bytes are copied from distance bytes before the end
+  of the output produced so far.  The distance is only present for a
+  non-zero match length.
+
+ *****************************************************************************/
+
+#ifndef SC_CWF_TRACE_H_INCLUDED_
+#define SC_CWF_TRACE_H_INCLUDED_
+
+#include "sysc/tracing/sc_trace_file_base.h"
+
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(SC_WIN_DLL_WARN)
+#pragma warning(push)
+#pragma warning(disable: 4251) // DLL import for std::vector
+#endif
+
+namespace sc_core {
+
+class cwf_trace;  // defined in sc_cwf_trace.cpp
+
+// ----------------------------------------------------------------------------
+//  CLASS : cwf_trace_file
+//
+//  Trace file in the compressed waveform format.
+// ----------------------------------------------------------------------------
+
+class cwf_trace_file
+  : public sc_trace_file_base
+{
+public:
+
+    enum cwf_enum { CWF_BITS = 0, CWF_LOGIC, CWF_REAL, CWF_EVENT };
+
+    // Create a CWF trace file.
+    // `Name' forms the base of the name to which `.cwf' is added.
+    explicit cwf_trace_file( const char* name );
+
+    // Flush results and close file.
+    ~cwf_trace_file();
+
+protected:
+
+    // These are all virtual functions in sc_trace_file and
+    // they need to be defined here.
+
+#   define DECL_TRACE_METHOD_A(tp)                                            \
+    virtual void trace( const tp& object, const std::string& name );
+
+#   define DECL_TRACE_METHOD_B(tp)                                            \
+    virtual void trace( const tp& object, const std::string& name,           \
+                        int width );
+
+    DECL_TRACE_METHOD_A( sc_event )
+    DECL_TRACE_METHOD_A( sc_time )
+
+    DECL_TRACE_METHOD_A( bool )
+    DECL_TRACE_METHOD_A( sc_dt::sc_bit )
+    DECL_TRACE_METHOD_A( sc_dt::sc_logic )
+
+    DECL_TRACE_METHOD_B( unsigned char )
+    DECL_TRACE_METHOD_B( unsigned short )
+    DECL_TRACE_METHOD_B( unsigned int )
+    DECL_TRACE_METHOD_B( unsigned long )
+    DECL_TRACE_METHOD_B( char )
+    DECL_TRACE_METHOD_B( short )
+    DECL_TRACE_METHOD_B( int )
+    DECL_TRACE_METHOD_B( long )
+    DECL_TRACE_METHOD_B( sc_dt::int64 )
+    DECL_TRACE_METHOD_B( sc_dt::uint64 )
+
+    DECL_TRACE_METHOD_A( float )
+    DECL_TRACE_METHOD_A( double )
+    DECL_TRACE_METHOD_A( sc_dt::sc_int_base )
+    DECL_TRACE_METHOD_A( sc_dt::sc_uint_base )
+    DECL_TRACE_METHOD_A( sc_dt::sc_signed )
+    DECL_TRACE_METHOD_A( sc_dt::sc_unsigned )
+
+    DECL_TRACE_METHOD_A( sc_dt::sc_fxval )
+    DECL_TRACE_METHOD_A( sc_dt::sc_fxval_fast )
+    DECL_TRACE_METHOD_A( sc_dt::sc_fxnum )
+    DECL_TRACE_METHOD_A( sc_dt::sc_fxnum_fast )
+
+    DECL_TRACE_METHOD_A( sc_dt::sc_bv_base )
+    DECL_TRACE_METHOD_A( sc_dt::sc_lv_base )
+
+#   undef DECL_TRACE_METHOD_A
+#   undef DECL_TRACE_METHOD_B
+
+    // Trace an enumerated object, the literals are stored in the file
+    virtual void trace( const unsigned int& object, const std::string& name,
+                        const char** enum_literals );
+
+    // Output a comment to the trace file
+    virtual void write_comment( const std::string& comment );
+
+    // Write trace info for cycle
+    virtual void cycle( bool delta_cycle );
+
+    // Write the index and all pending output, at the end of simulation
+    virtual void flush();
+
+    // Check the last trace only after updates of the given channel
+    virtual void link_last_trace( const sc_signal_channel& ch,
+                                  const void* value );
+
+private:
+
+#if SC_TRACING_PHASE_CALLBACKS_
+    // avoid hidden overload warnings
+    virtual void trace( sc_trace_file* ) const;
+#endif // SC_TRACING_PHASE_CALLBACKS_
+
+    // Initialize the CWF tracing
+    virtual void do_initialize();
+
+    // Add a trace of the object at the given address
+    void push_trace( cwf_trace* t, const void* source );
+
+    // current time in trace units
+    unit_type time_stamp() const;
+
+    // start a new block with the current values of all traces
+    void begin_block( unit_type now );
+    // compress the current block and write it to the file
+    void end_block();
+    // complete the file with the current block, the index and the trailer
+    void write_index();
+    // continue a completed file before writing a further record
+    void remove_index();
+
+    // unbuffered output of the header, records, and index
+    void write_bytes( const void* data, std::size_t n );
+    void write_number( unit_type v );
+    void write_string( const std::string& s );
+
+private:
+
+    std::vector<cwf_trace*>     traces;          // all traces
+    std::vector<cwf_trace*>     polled_traces;   // traces checked each cycle
+    std::vector<cwf_trace*>     changed_traces;  // traces of updated signals
+    std::vector<cwf_trace*>     cycle_traces;    // traces checked this cycle
+
+    std::vector<unsigned char>  block;           // raw data of current block
+    std::vector<unsigned char>  step;            // changes of current cycle
+    std::vector<unsigned char>  packed;          // compressed block
+    std::vector<int>            hash_table;      // used by the compression
+    std::vector<unit_type>      index;           // start, end, offset
+    std::vector<unsigned char>  scratch;         // encoded value to compare
+    std::vector<std::string>    comments;        // written before the header
+
+    unit_type                   previous_time;   // time of last cycle
+    unit_type                   block_start;     // start time of block
+    unit_type                   block_end;       // time of last step
+    unit_type                   offset;          // bytes written to file
+    unit_type                   index_offset;    // position of the index
+    bool                        block_open;      // block contains data?
+    bool                        index_written;   // file complete?
+};
+
+} // namespace sc_core
+
+#if defined(_MSC_VER) && !defined(SC_WIN_DLL_WARN)
+#pragma warning(pop)
+#endif
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+#endif // SC_CWF_TRACE_H_INCLUDED_
+// Taf!
@@ -50,9 +50,10 @@
 #include <cstdio>
 
 #include "sysc/tracing/sc_trace.h"
+#include "sysc/tracing/sc_trace_file_base.h"
 #include "sysc/tracing/sc_tracing_ids.h"
 
-#include "sysc/communication/sc_signal_ifs.h"
+#include "sysc/communication/sc_signal.h"
 #include "sysc/kernel/sc_event.h"
 #include "sysc/utils/sc_report.h"
 #include "sysc/utils/sc_utils_ids.h"
@@ -86,12 +87,30 @@ void sc_trace_file::delta_cycles(bool)
   /* Intentionally blank */
 }
 
+void sc_trace_file::flush()
+{
+  /* Intentionally blank */
+}
+
 const sc_dt::uint64&
 sc_trace_file::event_trigger_stamp(const sc_event& ev) const
 {
     return ev.m_trigger_stamp;
 }
 
+SC_API void
+sc_trace_link_channel( sc_trace_file* tf,
+                       const sc_interface& object,
+                       const void* value )
+{
+    sc_trace_file_base* tfb = dynamic_cast<sc_trace_file_base*>( tf );
+    const sc_signal_channel* ch =
+      dynamic_cast<const sc_signal_channel*>( &object );
+    if( tfb && ch ) {
+        tfb->link_last_trace( *ch, value );
+    }
+}
+
 SC_API void
 sc_trace( sc_trace_file* tf,
 	  const sc_signal_in_if<char>& object,
@@ -100,6 +119,7 @@ sc_trace( sc_trace_file* tf,
 {
     if( tf ) {
 	tf->trace( object.read(), name, width );
+	sc_trace_link_channel( tf, object, &object.read() );
     }
 }
 
@@ -111,6 +131,7 @@ sc_trace( sc_trace_file* tf,
 {
     if( tf ) {
 	tf->trace( object.read(), name, width );
+	sc_trace_link_channel( tf, object, &object.read() );
     }
 }
 
@@ -122,6 +143,7 @@ sc_trace( sc_trace_file* tf,
 {
     if( tf ) {
 	tf->trace( object.read(), name, width );
+	sc_trace_link_channel( tf, object, &object.read() );
     }
 }
 
@@ -133,6 +155,7 @@ sc_trace( sc_trace_file* tf,
 {
     if( tf ) {
 	tf->trace( object.read(), name, width );
+	sc_trace_link_channel( tf, object, &object.read() );
     }
 }
 
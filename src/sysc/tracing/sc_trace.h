@@ -74,6 +74,7 @@ namespace sc_dt
 namespace sc_core {
 
 class sc_event;
+class sc_interface;
 class sc_time;
 
 template <class T> class sc_signal_in_if;
@@ -165,6 +166,9 @@ protected:
     // Write trace info for cycle
     virtual void cycle( bool delta_cycle ) = 0;
 
+    // Write all pending output to the file, at the end of simulation
+    virtual void flush();
+
     // Helper for event tracing
     const sc_dt::uint64& event_trigger_stamp( const sc_event& event ) const;
 
@@ -259,6 +263,13 @@ DECL_TRACE_FUNC_A( sc_dt::sc_fxnum_fast )
 #undef DECL_TRACE_FUNC_B
 
 
+// Implementation-defined: inform the trace file about the channel, which
+// stores the value traced last, to only check it after updates of the channel
+
+SC_API void sc_trace_link_channel( sc_trace_file* tf,
+                                   const sc_interface& object,
+                                   const void* value );
+
 template <class T> 
 inline
 void
@@ -267,6 +278,7 @@ sc_trace( sc_trace_file* tf,
 	  const std::string& name )
 {
     sc_trace( tf, object.read(), name );
+    sc_trace_link_channel( tf, object, &object.read() );
 }
 
 template< class T >
@@ -277,6 +289,7 @@ sc_trace( sc_trace_file* tf,
 	  const char* name )
 {
     sc_trace( tf, object.read(), name );
+    sc_trace_link_channel( tf, object, &object.read() );
 }
 
 
@@ -362,6 +375,12 @@ extern SC_API void sc_close_vcd_trace_file( sc_trace_file* tf );
 extern SC_API sc_trace_file *sc_create_wif_trace_file(const char *name);
 extern SC_API void sc_close_wif_trace_file( sc_trace_file* tf );
 
+
+// ----------------------------------------------------------------------------
+// Create compressed waveform (CWF) file
+extern SC_API sc_trace_file *sc_create_cwf_trace_file(const char *name);
+extern SC_API void sc_close_cwf_trace_file( sc_trace_file* tf );
+
 } // namespace sc_core
 
 #endif // SC_TRACE_H
@@ -0,0 +1,268 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_trace_buffer.cpp - Buffered output of trace files
+
+  CHANGE LOG AT END OF FILE
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "sysc/tracing/sc_trace_buffer.h"
+#include "sysc/utils/sc_report.h" // sc_assert
+#include "sysc/communication/sc_host_semaphore.h"
+#include "sysc/utils/sc_string_view.h"
+
+// Host threads are available, unless the library has been built without
+// any thread support (no async_request_update() and QuickThreads only).
+
+#if defined(SC_DISABLE_ASYNC_UPDATES) && !defined(SC_USE_PTHREADS) && \
+    !defined(SC_ENABLE_PARALLEL_SIMULATION) && \
+    !defined(WIN32) && !defined(_WIN32)
+# define SC_TRACE_BUFFER_NO_THREAD_
+#elif SC_CPLUSPLUS >= 201103L
+# include <thread>
+#elif !defined(WIN32) && !defined(_WIN32)
+# include <pthread.h>
+#endif
+
+namespace sc_core {
+
+static const std::size_t SC_TRACE_BUFFER_SIZE = 1 << 20;
+
+// ----------------------------------------------------------------------------
+//  STRUCT : sc_trace_buffer::writer
+//
+//  The host thread writing full buffers to the file.
+// ----------------------------------------------------------------------------
+
+struct sc_trace_buffer::writer
+{
+    explicit writer( std::FILE* fp )
+      : m_fp( fp ), m_data( new char[SC_TRACE_BUFFER_SIZE] ), m_size( 0 )
+      , m_stop( false ), m_start(), m_idle( 1 ), m_thread()
+    {}
+
+    ~writer()
+      { delete [] m_data; }
+
+    std::FILE*        m_fp;     // the trace file
+    char*             m_data;   // buffer written by the thread
+    std::size_t       m_size;   // number of characters in m_data
+    bool              m_stop;   // true: leave writer_loop()
+    sc_host_semaphore m_start;  // posted, when m_data is to be written
+    sc_host_semaphore m_idle;   // posted, when m_data has been written
+#if defined(SC_TRACE_BUFFER_NO_THREAD_)
+    int               m_thread; // unused
+#elif SC_CPLUSPLUS >= 201103L
+    std::thread       m_thread;
+#elif defined(WIN32) || defined(_WIN32)
+    HANDLE            m_thread;
+#else
+    pthread_t         m_thread;
+#endif
+};
+
+#if !defined(SC_TRACE_BUFFER_NO_THREAD_) && SC_CPLUSPLUS < 201103L
+extern "C" {
+# if defined(WIN32) || defined(_WIN32)
+static DWORD WINAPI sc_trace_writer_thread_fn( LPVOID arg )
+# else
+static void* sc_trace_writer_thread_fn( void* arg )
+# endif
+{
+    sc_trace_buffer::writer_loop( static_cast<sc_trace_buffer::writer*>(arg) );
+    return 0;
+}
+} // extern "C"
+#endif // !SC_TRACE_BUFFER_NO_THREAD_ && SC_CPLUSPLUS < 201103L
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_trace_buffer
+//
+//  Output buffer of a trace file.
+// ----------------------------------------------------------------------------
+
+sc_trace_buffer::sc_trace_buffer( std::FILE* fp )
+  : m_fp( fp )
+  , m_data( new char[SC_TRACE_BUFFER_SIZE] )
+  , m_pos( m_data )
+  , m_end( m_data + SC_TRACE_BUFFER_SIZE )
+  , m_writer( 0 )
+{
+    sc_assert( m_fp );
+
+#if !defined(SC_TRACE_BUFFER_NO_THREAD_)
+    const char*    thread_p = std::getenv( "SC_TRACE_WRITER_THREAD" );
+    sc_string_view thread_s = ( thread_p ) ? thread_p : "";
+    if( thread_s == "DISABLE" )
+        return;
+
+    m_writer = new writer( m_fp );
+#   if SC_CPLUSPLUS >= 201103L
+    m_writer->m_thread = std::thread( &sc_trace_buffer::writer_loop, m_writer );
+#   elif defined(WIN32) || defined(_WIN32)
+    m_writer->m_thread =
+        CreateThread( NULL, 0, &sc_trace_writer_thread_fn, m_writer, 0, NULL );
+    sc_assert( m_writer->m_thread != NULL );
+#   else
+    int created = pthread_create( &m_writer->m_thread, NULL,
+                                  &sc_trace_writer_thread_fn, m_writer );
+    sc_assert( created == 0 );
+#   endif
+#endif // !SC_TRACE_BUFFER_NO_THREAD_
+}
+
+sc_trace_buffer::~sc_trace_buffer()
+{
+    finish();
+    delete [] m_data;
+}
+
+void
+sc_trace_buffer::write_dec( sc_dt::uint64 v, int width )
+{
+    char  digits[32];
+    char* end = digits + sizeof(digits);
+    char* p   = end;
+    do {
+        *--p = static_cast<char>( '0' + v % 10 );
+        v /= 10;
+    } while( v != 0 );
+
+    for( int len = static_cast<int>( end - p ); len < width; ++len )
+        put( '0' );
+    write( p, static_cast<std::size_t>( end - p ) );
+}
+
+void
+sc_trace_buffer::flush()
+{
+    swap_buffers();
+    if( m_writer ) {
+        // wait for the writer to finish, but keep it idle
+        m_writer->m_idle.wait();
+        std::fflush( m_fp );
+        m_writer->m_idle.post();
+    } else {
+        std::fflush( m_fp );
+    }
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_trace_buffer::finish"
+// |
+// | This method writes all pending data and joins the writer thread.  It is
+// | called at the end of the simulation, as the buffer of a trace file that
+// | is never closed is not destroyed.  The buffer remains usable.
+// +----------------------------------------------------------------------------
+void
+sc_trace_buffer::finish()
+{
+    flush();
+
+#if !defined(SC_TRACE_BUFFER_NO_THREAD_)
+    if( m_writer ) {
+        m_writer->m_idle.wait();
+        m_writer->m_stop = true;
+        m_writer->m_start.post();
+#     if SC_CPLUSPLUS >= 201103L
+        m_writer->m_thread.join();
+#     elif defined(WIN32) || defined(_WIN32)
+        WaitForSingleObject( m_writer->m_thread, INFINITE );
+        CloseHandle( m_writer->m_thread );
+#     else
+        pthread_join( m_writer->m_thread, NULL );
+#     endif
+        delete m_writer;
+        m_writer = 0;
+    }
+#endif // !SC_TRACE_BUFFER_NO_THREAD_
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_trace_buffer::swap_buffers"
+// |
+// | This method hands the buffered data to the writer thread, as soon as it
+// | has finished writing the previous buffer, and continues with the buffer
+// | released by the writer.  Without a writer thread, the data is written
+// | directly.
+// +----------------------------------------------------------------------------
+void
+sc_trace_buffer::swap_buffers()
+{
+    std::size_t size = static_cast<std::size_t>( m_pos - m_data );
+    if( size == 0 )
+        return;
+
+    if( m_writer ) {
+        m_writer->m_idle.wait();
+        std::swap( m_data, m_writer->m_data );
+        m_writer->m_size = size;
+        m_writer->m_start.post();
+    } else {
+        std::fwrite( m_data, 1, size, m_fp );
+    }
+    m_pos = m_data;
+    m_end = m_data + SC_TRACE_BUFFER_SIZE;
+}
+
+void
+sc_trace_buffer::write_slow( const char* s, std::size_t n )
+{
+    while( n > 0 ) {
+        if( m_pos == m_end )
+            swap_buffers();
+        std::size_t chunk = static_cast<std::size_t>( m_end - m_pos );
+        if( chunk > n )
+            chunk = n;
+        std::memcpy( m_pos, s, chunk );
+        m_pos += chunk;
+        s     += chunk;
+        n     -= chunk;
+    }
+}
+
+void
+sc_trace_buffer::writer_loop( writer* w )
+{
+    for( ;; ) {
+        w->m_start.wait();
+        if( w->m_stop )
+            break;
+        std::fwrite( w->m_data, 1, w->m_size, w->m_fp );
+        w->m_idle.post();
+    }
+}
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+// Taf!
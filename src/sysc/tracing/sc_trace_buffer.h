@@ -0,0 +1,132 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+/*****************************************************************************
+
+  sc_trace_buffer.h - Buffered output of trace files
+
+  FOR INTERNAL USE ONLY!
+
+  CHANGE LOG AT END OF FILE
+ *****************************************************************************/
+
+#ifndef SC_TRACE_BUFFER_H_INCLUDED_
+#define SC_TRACE_BUFFER_H_INCLUDED_
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "sysc/datatypes/int/sc_nbdefs.h" // sc_dt::uint64
+
+namespace sc_core {
+
+// ----------------------------------------------------------------------------
+//  CLASS : sc_trace_buffer
+//
+//  Output buffer of a trace file.
+//
+//  The data is collected in one of two large buffers.  When it is full,
+//  the buffer is handed to a background host thread, which writes it to
+//  the file, while the simulation continues to fill the other buffer.
+//  The simulation only blocks, if the previous buffer has not been
+//  written yet.  Without support for host threads in the library, or if
+//  the environment variable SC_TRACE_WRITER_THREAD is set to DISABLE,
+//  full buffers are written directly.
+//
+//  All pending data is written, when the buffer is finished or destroyed.
+//  The file itself is not closed.
+// ----------------------------------------------------------------------------
+
+class sc_trace_buffer
+{
+public:
+
+    explicit sc_trace_buffer( std::FILE* fp );
+    ~sc_trace_buffer();
+
+    void put( char c )
+    {
+        if( m_pos == m_end )
+            swap_buffers();
+        *m_pos++ = c;
+    }
+
+    void write( const char* s, std::size_t n )
+    {
+        if( n <= static_cast<std::size_t>( m_end - m_pos ) ) {
+            std::memcpy( m_pos, s, n );
+            m_pos += n;
+        } else {
+            write_slow( s, n );
+        }
+    }
+
+    void write( const char* s )
+        { write( s, std::strlen( s ) ); }
+
+    void write( const std::string& s )
+        { write( s.data(), s.size() ); }
+
+    // decimal number, padded with leading zeros to at least width digits
+    void write_dec( sc_dt::uint64 v, int width = 0 );
+
+    // write all pending data and flush the file
+    void flush();
+
+    // flush and stop the writer thread, later data is written directly
+    void finish();
+
+public: // implementation details, used by the host thread entry function
+    struct writer;
+    static void writer_loop( writer* );
+
+private:
+
+    void swap_buffers();
+    void write_slow( const char* s, std::size_t n );
+
+private:
+
+    std::FILE* m_fp;       // the trace file
+    char*      m_data;     // buffer filled by the simulation
+    char*      m_pos;      // next character in m_data
+    char*      m_end;      // end of m_data
+    writer*    m_writer;   // background writer, if any
+
+private:
+    // disabled
+    sc_trace_buffer( const sc_trace_buffer& );
+    sc_trace_buffer& operator = ( const sc_trace_buffer& );
+};
+
+} // namespace sc_core
+
+/*****************************************************************************
+
+  MODIFICATION LOG - modifiers, enter your name, affiliation, date and
+  changes you are making here.
+
+      Name, Affiliation, Date:
+  Description of Modification:
+
+ *****************************************************************************/
+
+#endif // SC_TRACE_BUFFER_H_INCLUDED_
+// Taf!
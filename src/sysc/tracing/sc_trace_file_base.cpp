@@ -37,12 +37,17 @@
 
  *****************************************************************************/
 
+#include <algorithm>
+#include <cstdlib>
 #include <ctime>
 #include <sstream>
+#include <vector>
 
 #include "sysc/tracing/sc_trace_file_base.h"
+#include "sysc/tracing/sc_trace_buffer.h"
 #include "sysc/kernel/sc_simcontext.h"
 #include "sysc/kernel/sc_simcontext_int.h"
+#include "sysc/communication/sc_host_mutex.h"
 
 #if SC_TRACING_PHASE_CALLBACKS_
 #  include "sysc/kernel/sc_object_int.h"
@@ -60,6 +65,35 @@ namespace sc_core {
 
 bool sc_trace_file_base::tracing_initialized_ = false;
 
+// The trace files, which have not been deleted yet, are flushed at exit, as
+// the simulation may end without sc_simcontext::end(), and the default
+// context is never destroyed.
+
+static std::vector<sc_trace_file_base*> sc_open_trace_files;
+static sc_host_mutex                    sc_open_trace_files_mutex;
+
+void
+sc_trace_file_base::flush_at_exit()
+{
+    flush_open_files( 0 );
+}
+
+void
+sc_trace_file_base::flush_open_files( sc_simcontext* simc )
+{
+    sc_scoped_lock lock( sc_open_trace_files_mutex );
+    for( std::size_t i = 0; i < sc_open_trace_files.size(); ++i ) {
+        sc_trace_file_base* tf = sc_open_trace_files[i];
+#if SC_TRACING_PHASE_CALLBACKS_
+        if( simc && tf->simcontext() != simc )
+            continue;
+#else
+        if( simc ) // registered in and flushed by the context
+            continue;
+#endif
+        tf->flush();
+    }
+}
 
 sc_trace_file_base::sc_trace_file_base( const char* name, const char* extension )
   : sc_trace_file()
@@ -67,6 +101,7 @@ sc_trace_file_base::sc_trace_file_base( const char* name, const char* extension
   , sc_object( sc_gen_unique_name("$$$$kernel_tracefile$$$$") )
 #endif
   , fp(0)
+  , out(0)
   , trace_unit_fs()
   , kernel_unit_fs()
   , timescale_set_by_user(false)
@@ -74,6 +109,16 @@ sc_trace_file_base::sc_trace_file_base( const char* name, const char* extension
   , initialized_(false)
   , trace_delta_cycles_(false)
 {
+    {
+        sc_scoped_lock lock( sc_open_trace_files_mutex );
+        static bool at_exit_registered = false;
+        if( !at_exit_registered ) {
+            at_exit_registered = true;
+            std::atexit( &sc_trace_file_base::flush_at_exit );
+        }
+        sc_open_trace_files.push_back( this );
+    }
+
     if( !name || !*name ) {
         SC_REPORT_ERROR( SC_ID_TRACING_FOPEN_FAILED_, "no name given" );
         return;
@@ -98,6 +143,15 @@ sc_trace_file_base::~sc_trace_file_base()
     if( !is_initialized() )
         SC_REPORT_WARNING( SC_ID_TRACING_CLOSE_EMPTY_FILE_, filename() );
 
+    {
+        sc_scoped_lock lock( sc_open_trace_files_mutex );
+        sc_open_trace_files.erase( std::find( sc_open_trace_files.begin(),
+                                              sc_open_trace_files.end(),
+                                              this ) );
+    }
+
+    delete out; // writes pending output
+
     if( fp )
         fclose(fp);
 
@@ -107,6 +161,15 @@ sc_trace_file_base::~sc_trace_file_base()
 #endif
 }
 
+void
+sc_trace_file_base::flush()
+{
+    if( out )
+        out->finish();
+    else if( fp )
+        fflush( fp );
+}
+
 /*****************************************************************************/
 // simulation phase callback based trigger
 //
@@ -185,6 +248,14 @@ sc_trace_file_base::open_fp()
     }
 }
 
+void
+sc_trace_file_base::open_buffer()
+{
+    sc_assert( !out );
+    if( !fp ) open_fp();
+    out = new sc_trace_buffer( fp );
+}
+
 void
 sc_trace_file_base::delta_cycles( bool flag )
 {
@@ -224,6 +295,12 @@ sc_trace_file_base::set_time_unit( double v, sc_time_unit tu )
     }
 }
 
+void
+sc_trace_file_base::link_last_trace( const sc_signal_channel&, const void* )
+{
+    // changes of all traced objects are checked in each cycle by default
+}
+
 bool
 sc_trace_file_base::add_trace_check( const std::string & name ) const
 {
@@ -60,6 +60,9 @@
 
 namespace sc_core {
 
+class sc_signal_channel;
+class sc_trace_buffer;
+
 // shared implementation of trace files
 class SC_API sc_trace_file_base
   : public sc_trace_file
@@ -82,6 +85,14 @@ public:
     // set a user-define timescale unit for the trace file
     virtual void set_time_unit( double v, sc_time_unit tu);
 
+    // the object traced last is (a part of) the value at the given address,
+    // stored by the signal channel (see sc_trace_link_channel)
+    virtual void link_last_trace( const sc_signal_channel&, const void* );
+
+    // write the pending output of the trace files, which are not closed,
+    // of the given simulation context (or of all contexts, if 0)
+    static void flush_open_files( sc_simcontext* simc );
+
 protected:
     sc_trace_file_base( const char* name, const char* extension );
 
@@ -91,6 +102,8 @@ protected:
     bool initialize();
     // ensure that file has been opened (needed for early write_comment())
     void open_fp();
+    // ensure that the buffered output to the file has been created
+    void open_buffer();
     // perform format specific initialization
     virtual void do_initialize() = 0;
 
@@ -107,6 +120,9 @@ protected:
     // get current kernel time in trace time units
     void timestamp_in_trace_units(unit_type &high, unit_type &low) const;
 
+    // Write all pending output to the file.
+    virtual void flush();
+
     // Flush results and close file.
     virtual ~sc_trace_file_base();
 
@@ -121,6 +137,7 @@ private:
 
 protected:
     FILE* fp;                          // pointer to the trace file
+    sc_trace_buffer* out;              // buffered output to fp (if used)
 
     unit_type   trace_unit_fs;         // tracefile timescale unit in femtoseconds
     unit_type   kernel_unit_fs;        // kernel timescale unit in femtoseconds
@@ -133,6 +150,8 @@ private:
 
     static bool tracing_initialized_;  // shared setup of tracing implementation
 
+    static void flush_at_exit();       // flush the trace files not deleted
+
 private: // disabled
     sc_trace_file_base( const sc_trace_file_base& ) /* = delete */;
     sc_trace_file_base& operator=( const sc_trace_file_base& ) /* = delete */;
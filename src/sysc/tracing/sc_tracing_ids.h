@@ -66,7 +66,11 @@ SC_DEFINE_MESSAGE( SC_ID_TRACING_REVERSED_TIME_,        714,
  "tracing cycle with duplicate or reversed time detected" )
 SC_DEFINE_MESSAGE( SC_ID_TRACING_CLOSE_EMPTY_FILE_,     715,
  "trace file closed before any cycles were traced, file not written" )
-/* unused IDs 716-719 */
+SC_DEFINE_MESSAGE( SC_ID_TRACING_CWF_TIME_RESOLUTION_,  716,
+  "current kernel time is not representable in CWF time units" )
+SC_DEFINE_MESSAGE( SC_ID_TRACING_CWF_DELTA_CYCLE_,      717,
+ "CWF tracing of delta cycles at the same time unit skipped" )
+/* unused IDs 718-719 */
 SC_DEFINE_MESSAGE( SC_ID_TRACING_ALREADY_INITIALIZED_,  720,
                    "sc_trace_file already initialized" )
 
@@ -59,6 +59,8 @@
 #include "sysc/kernel/sc_simcontext.h"
 #include "sysc/kernel/sc_ver.h"
 #include "sysc/kernel/sc_event.h"
+#include "sysc/communication/sc_signal.h"
+#include "sysc/tracing/sc_trace_buffer.h"
 #include "sysc/datatypes/bit/sc_bit.h"
 #include "sysc/datatypes/bit/sc_logic.h"
 #include "sysc/datatypes/bit/sc_lv_base.h"
@@ -71,6 +73,7 @@
 #include "sysc/utils/sc_report.h" // sc_assert
 #include "sysc/utils/sc_string_view.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <map>
 #include <sstream>
@@ -95,9 +98,12 @@ const char* vcd_types[] = { "wire", "real", "event", "time" };
 //  CLASS : vcd_trace
 //
 //  Base class for VCD traces.
+//
+//  Traces of signal values are attached to the signal channel and only
+//  checked for changes, after the channel has reported a value change.
 // ----------------------------------------------------------------------------
 
-class vcd_trace
+class vcd_trace : public sc_signal_trace_hook
 {
 public:
 
@@ -105,7 +111,7 @@ public:
 
     // Needs to be pure virtual as has to be defined by the particular
     // type being traced
-    virtual void write(FILE* f) = 0;
+    virtual void write(sc_trace_buffer& f) = 0;
 
     virtual void set_width();
 
@@ -115,17 +121,31 @@ public:
     virtual bool changed() = 0;
 
     // Make this virtual as some derived classes may overwrite
-    virtual void print_variable_declaration_line(FILE* f, const char* scoped_name);
+    virtual void print_variable_declaration_line(sc_trace_buffer& f, const char* scoped_name);
+
+    // write the value line of the given bits (MSB first)
+    void write_data(sc_trace_buffer& f, const char* rawdata);
 
-    void compose_data_line(char* rawdata, char* compdata);
-    std::string compose_line(const std::string& data);
+    // write the value line of the lower bit_width bits, or 'x' on overflow
+    void write_bits(sc_trace_buffer& f, sc_dt::uint64 value, bool overflow);
+
+    // write the value line of a real value
+    void write_real(sc_trace_buffer& f, double value);
 
     virtual ~vcd_trace();
 
+    // mark this trace for the next cycle
+    void value_changed();
+
     const std::string name;
     const std::string vcd_name;
     vcd_trace_file::vcd_enum vcd_var_type;
     int bit_width;
+
+    const void* source;                     // address of the traced object
+    int index;                              // position in the trace file
+    bool marked;                            // in changed_list?
+    std::vector<vcd_trace*>* changed_list;  // changed traces of the file
 };
 
 
@@ -134,47 +154,80 @@ vcd_trace::vcd_trace(const std::string& name_, const std::string& vcd_name_)
   , vcd_name(vcd_name_)
   , vcd_var_type(vcd_trace_file::VCD_WIRE)
   , bit_width(0)
+  , source(0)
+  , index(0)
+  , marked(false)
+  , changed_list(0)
 {
     /* Intentionally blank */
 }
 
 void
-vcd_trace::compose_data_line(char* rawdata, char* compdata)
+vcd_trace::value_changed()
 {
-    sc_assert(rawdata != compdata);
+    if( !marked ) {
+        marked = true;
+        changed_list->push_back(this);
+    }
+}
 
+static bool
+vcd_trace_less(const vcd_trace* t1, const vcd_trace* t2)
+{
+    return t1->index < t2->index;
+}
+
+void
+vcd_trace::write_data(sc_trace_buffer& f, const char* rawdata)
+{
     if(bit_width == 0)
+        return;
+
+    if(bit_width == 1)
     {
-        compdata[0] = '\0';
+        f.put(rawdata[0]);
     }
     else
     {
-        if(bit_width == 1)
-        {
-            compdata[0] = rawdata[0];
-            strcpy(&(compdata[1]), vcd_name.c_str());
+        f.put('b');
+        f.write(strip_leading_bits(rawdata));
+        f.put(' ');
+    }
+    f.write(vcd_name);
+}
+
+void
+vcd_trace::write_bits(sc_trace_buffer& f, sc_dt::uint64 value, bool overflow)
+{
+    char rawdata[1000];
+    int bitindex;
+
+    if (overflow) {
+        for (bitindex = 0; bitindex < bit_width; bitindex++) {
+            rawdata[bitindex] = 'x';
         }
-        else
-        {
-            const char* effective_begin = strip_leading_bits(rawdata);
-            std::sprintf(compdata, "b%s %s", effective_begin, vcd_name.c_str());
+    }
+    else {
+        for (bitindex = 0; bitindex < bit_width; bitindex++) {
+            int bit = bit_width - 1 - bitindex;
+            rawdata[bitindex] = (bit < 64) ? "01"[(value >> bit) & 1] : '0';
         }
     }
+    rawdata[bitindex] = '\0';
+    write_data(f, rawdata);
 }
 
-// same as above but not that ugly
-std::string
-vcd_trace::compose_line(const std::string& data)
+void
+vcd_trace::write_real(sc_trace_buffer& f, double value)
 {
-  if(bit_width == 0)
-    return "";
-  if(bit_width == 1)
-    return data + vcd_name;
-  return std::string("b")+strip_leading_bits(data.c_str())+" "+vcd_name;
+    char buf[64];
+    std::sprintf(buf, "r%.16g ", value);
+    f.write(buf);
+    f.write(vcd_name);
 }
 
 void
-vcd_trace::print_variable_declaration_line(FILE* f, const char* scoped_name)
+vcd_trace::print_variable_declaration_line(sc_trace_buffer& f, const char* scoped_name)
 {
     char buf[2000];
 
@@ -204,7 +257,7 @@ vcd_trace::print_variable_declaration_line(FILE* f, const char* scoped_name)
                      bit_width-1);
     }
 
-    std::fputs(buf, f);
+    f.write(buf);
 }
 
 void
@@ -269,9 +322,9 @@ class vcd_T_trace : public vcd_trace
         vcd_var_type = type_;
     }
 
-    void write( FILE* f )
+    void write( sc_trace_buffer& f )
     {
-        std::fprintf( f, "%s", compose_line( object.to_string() ).c_str() );
+        write_data( f, object.to_string().c_str() );
         old_value = object;
     }
 
@@ -313,7 +366,7 @@ public:
     vcd_sc_event_trace(const sc_dt::uint64& trigger_stamp_,
                        const std::string& name_,
                        const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -338,10 +391,11 @@ vcd_sc_event_trace::changed()
 }
 
 void
-vcd_sc_event_trace::write(FILE* f)
+vcd_sc_event_trace::write(sc_trace_buffer& f)
 {
     if(!changed()) return;
-    std::fprintf(f,"1%s", vcd_name.c_str());
+    f.put('1');
+    f.write(vcd_name);
     old_trigger_stamp = trigger_stamp;
 }
 
@@ -352,7 +406,7 @@ public:
     vcd_bool_trace(const bool& object_,
 		   const std::string& name_,
 		   const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -375,12 +429,12 @@ vcd_bool_trace::changed()
 }
 
 void
-vcd_bool_trace::write(FILE* f)
+vcd_bool_trace::write(sc_trace_buffer& f)
 {
-    if (object == true) std::fputc('1', f);
-    else std::fputc('0', f);
+    if (object == true) f.put('1');
+    else f.put('0');
 
-    std::fprintf(f,"%s", vcd_name.c_str());
+    f.write(vcd_name);
 
     old_value = object;
 }
@@ -391,7 +445,7 @@ class vcd_sc_bit_trace : public vcd_trace {
 public:
     vcd_sc_bit_trace(const sc_dt::sc_bit& , const std::string& ,
     	const std::string& );
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -414,12 +468,12 @@ vcd_sc_bit_trace::changed()
 }
 
 void
-vcd_sc_bit_trace::write(FILE* f)
+vcd_sc_bit_trace::write(sc_trace_buffer& f)
 {
-    if (object == true) std::fputc('1', f);
-    else std::fputc('0', f);
+    if (object == true) f.put('1');
+    else f.put('0');
 
-    std::fprintf(f,"%s", vcd_name.c_str());
+    f.write(vcd_name);
 
     old_value = object;
 }
@@ -431,7 +485,7 @@ public:
     vcd_sc_logic_trace(const sc_dt::sc_logic& object_,
 		       const std::string& name_,
 		       const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -457,13 +511,13 @@ vcd_sc_logic_trace::changed()
 
 
 void
-vcd_sc_logic_trace::write(FILE* f)
+vcd_sc_logic_trace::write(sc_trace_buffer& f)
 {
     char out_char;
     out_char = map_sc_logic_state_to_vcd_state(object.to_char());
-    std::fputc(out_char, f);
+    f.put(out_char);
 
-    std::fprintf(f,"%s", vcd_name.c_str());
+    f.write(vcd_name);
 
     old_value = object;
 }
@@ -476,7 +530,7 @@ public:
     vcd_sc_unsigned_trace(const sc_dt::sc_unsigned& object_,
 			  const std::string& name_,
 			  const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
     void set_width();
 
@@ -502,15 +556,14 @@ vcd_sc_unsigned_trace::changed()
 }
 
 void
-vcd_sc_unsigned_trace::write(FILE* f)
+vcd_sc_unsigned_trace::write(sc_trace_buffer& f)
 {
-    static std::vector<char> compdata(1024), rawdata(1024);
+    static std::vector<char> rawdata(1024);
     typedef std::vector<char>::size_type size_t;
 
-    if ( compdata.size() <= static_cast<size_t>(object.length()) ) { // include trailing \0
+    if ( rawdata.size() <= static_cast<size_t>(object.length()) ) { // include trailing \0
         size_t sz = ( static_cast<size_t>(object.length()) + 4096 ) & (~static_cast<size_t>(4096-1));
-        std::vector<char>( sz ).swap( compdata ); // resize without copying values
-        std::vector<char>( sz ).swap( rawdata );
+        std::vector<char>( sz ).swap( rawdata ); // resize without copying values
     }
     char *rawdata_ptr  = &rawdata[0];
 
@@ -518,9 +571,7 @@ vcd_sc_unsigned_trace::write(FILE* f)
         *rawdata_ptr++ = "01"[object[bitindex].to_bool()];
     }
     *rawdata_ptr = '\0';
-    compose_data_line(&rawdata[0], &compdata[0]);
-
-    std::fputs(&compdata[0], f);
+    write_data(f, &rawdata[0]);
     old_value = object;
 }
 
@@ -538,7 +589,7 @@ public:
     vcd_sc_signed_trace(const sc_dt::sc_signed& object_,
 			const std::string& name_,
 			const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
     void set_width();
 
@@ -563,15 +614,14 @@ vcd_sc_signed_trace::changed()
 }
 
 void
-vcd_sc_signed_trace::write(FILE* f)
+vcd_sc_signed_trace::write(sc_trace_buffer& f)
 {
-    static std::vector<char> compdata(1024), rawdata(1024);
+    static std::vector<char> rawdata(1024);
     typedef std::vector<char>::size_type size_t;
 
-    if ( compdata.size() <= static_cast<size_t>(object.length()) ) { // include trailing \0
+    if ( rawdata.size() <= static_cast<size_t>(object.length()) ) { // include trailing \0
         size_t sz = ( static_cast<size_t>(object.length()) + 4096 ) & (~static_cast<size_t>(4096-1));
-        std::vector<char>( sz ).swap( compdata ); // resize without copying values
-        std::vector<char>( sz ).swap( rawdata );
+        std::vector<char>( sz ).swap( rawdata ); // resize without copying values
     }
     char *rawdata_ptr  = &rawdata[0];
 
@@ -579,9 +629,7 @@ vcd_sc_signed_trace::write(FILE* f)
         *rawdata_ptr++ = "01"[object[bitindex].to_bool()];
     }
     *rawdata_ptr = '\0';
-    compose_data_line(&rawdata[0], &compdata[0]);
-
-    std::fputs(&compdata[0], f);
+    write_data(f, &rawdata[0]);
     old_value = object;
 }
 
@@ -598,7 +646,7 @@ public:
     vcd_sc_uint_base_trace(const sc_dt::sc_uint_base& object_,
 			   const std::string& name_,
 			   const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
     void set_width();
 
@@ -625,19 +673,9 @@ vcd_sc_uint_base_trace::changed()
 }
 
 void
-vcd_sc_uint_base_trace::write(FILE* f)
+vcd_sc_uint_base_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
-
-    int bitindex;
-    for (bitindex = object.length()-1; bitindex >= 0; --bitindex) {
-        *rawdata_ptr++ = "01"[object[bitindex].to_bool()];
-    }
-    *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
-
-    std::fputs(compdata, f);
+    write_bits(f, object.value(), false);
     old_value = object;
 }
 
@@ -655,7 +693,7 @@ public:
     vcd_sc_int_base_trace(const sc_dt::sc_int_base& object_,
 			  const std::string& name_,
 			  const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
     void set_width();
 
@@ -680,19 +718,9 @@ vcd_sc_int_base_trace::changed()
 }
 
 void
-vcd_sc_int_base_trace::write(FILE* f)
+vcd_sc_int_base_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000], *rawdata_ptr = rawdata;
-    char compdata[1000];
-
-    int bitindex;
-    for (bitindex = object.length()-1; bitindex >= 0; --bitindex) {
-        *rawdata_ptr++ = "01"[object[bitindex].to_bool()];
-    }
-    *rawdata_ptr = '\0';
-    compose_data_line(rawdata, compdata);
-
-    std::fputs(compdata, f);
+    write_bits(f, object.value(), false);
     old_value = object;
 }
 
@@ -712,7 +740,7 @@ public:
     vcd_sc_fxval_trace( const sc_dt::sc_fxval& object_,
 			const std::string& name_,
 			const std::string& vcd_name_ );
-    void write( FILE* f );
+    void write( sc_trace_buffer& f );
     bool changed();
 
 protected:
@@ -739,9 +767,9 @@ vcd_sc_fxval_trace::changed()
 }
 
 void
-vcd_sc_fxval_trace::write( FILE* f )
+vcd_sc_fxval_trace::write( sc_trace_buffer& f )
 {
-    std::fprintf( f, "r%.16g %s", object.to_double(), vcd_name.c_str() );
+    write_real(f, object.to_double());
     old_value = object;
 }
 
@@ -754,7 +782,7 @@ public:
     vcd_sc_fxval_fast_trace( const sc_dt::sc_fxval_fast& object_,
 			     const std::string& name_,
 			     const std::string& vcd_name_ );
-    void write( FILE* f );
+    void write( sc_trace_buffer& f );
     bool changed();
 
 protected:
@@ -782,9 +810,9 @@ vcd_sc_fxval_fast_trace::changed()
 }
 
 void
-vcd_sc_fxval_fast_trace::write( FILE* f )
+vcd_sc_fxval_fast_trace::write( sc_trace_buffer& f )
 {
-    std::fprintf( f, "r%.16g %s", object.to_double(), vcd_name.c_str() );
+    write_real(f, object.to_double());
     old_value = object;
 }
 
@@ -797,7 +825,7 @@ public:
     vcd_sc_fxnum_trace( const sc_dt::sc_fxnum& object_,
 			const std::string& name_,
 			const std::string& vcd_name_ );
-    void write( FILE* f );
+    void write( sc_trace_buffer& f );
     bool changed();
     void set_width();
 
@@ -828,15 +856,14 @@ vcd_sc_fxnum_trace::changed()
 }
 
 void
-vcd_sc_fxnum_trace::write( FILE* f )
+vcd_sc_fxnum_trace::write( sc_trace_buffer& f )
 {
-    static std::vector<char> compdata(1024), rawdata(1024);
+    static std::vector<char> rawdata(1024);
     typedef std::vector<char>::size_type size_t;
 
-    if ( compdata.size() <= static_cast<size_t>(object.wl()) ) { // include trailing \0
+    if ( rawdata.size() <= static_cast<size_t>(object.wl()) ) { // include trailing \0
         size_t sz = ( static_cast<size_t>(object.wl()) + 4096 ) & (~static_cast<size_t>(4096-1));
-        std::vector<char>( sz ).swap( compdata ); // resize without copying values
-        std::vector<char>( sz ).swap( rawdata );
+        std::vector<char>( sz ).swap( rawdata ); // resize without copying values
     }
     char *rawdata_ptr  = &rawdata[0];
 
@@ -845,9 +872,7 @@ vcd_sc_fxnum_trace::write( FILE* f )
         *rawdata_ptr ++ = "01"[object[bitindex]];
     }
     *rawdata_ptr = '\0';
-    compose_data_line( &rawdata[0], &compdata[0] );
-
-    std::fputs( &compdata[0], f );
+    write_data( f, &rawdata[0] );
     old_value = object;
 }
 
@@ -866,7 +891,7 @@ public:
     vcd_sc_fxnum_fast_trace( const sc_dt::sc_fxnum_fast& object_,
 			     const std::string& name_,
 			     const std::string& vcd_name_ );
-    void write( FILE* f );
+    void write( sc_trace_buffer& f );
     bool changed();
     void set_width();
 
@@ -898,15 +923,14 @@ vcd_sc_fxnum_fast_trace::changed()
 }
 
 void
-vcd_sc_fxnum_fast_trace::write( FILE* f )
+vcd_sc_fxnum_fast_trace::write( sc_trace_buffer& f )
 {
-    static std::vector<char> compdata(1024), rawdata(1024);
+    static std::vector<char> rawdata(1024);
     typedef std::vector<char>::size_type size_t;
 
-    if ( compdata.size() <= static_cast<size_t>(object.wl()) ) { // include trailing \0
+    if ( rawdata.size() <= static_cast<size_t>(object.wl()) ) { // include trailing \0
         size_t sz = ( static_cast<size_t>(object.wl()) + 4096 ) & (~static_cast<size_t>(4096-1));
-        std::vector<char>( sz ).swap( compdata ); // resize without copying values
-        std::vector<char>( sz ).swap( rawdata );
+        std::vector<char>( sz ).swap( rawdata ); // resize without copying values
     }
     char *rawdata_ptr  = &rawdata[0];
 
@@ -915,9 +939,7 @@ vcd_sc_fxnum_fast_trace::write( FILE* f )
         *rawdata_ptr ++ = "01"[object[bitindex]];
     }
     *rawdata_ptr = '\0';
-    compose_data_line( &rawdata[0], &compdata[0] );
-
-    std::fputs( &compdata[0], f );
+    write_data( f, &rawdata[0] );
     old_value = object;
 }
 
@@ -936,7 +958,7 @@ public:
 			   const std::string& name_,
 			   const std::string& vcd_name_,
 			   int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -967,28 +989,10 @@ vcd_unsigned_int_trace::changed()
 
 
 void
-vcd_unsigned_int_trace::write(FILE* f)
+vcd_unsigned_int_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if ((object & mask) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++){
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, (object & mask) != object);
     old_value = object;
 }
 
@@ -1000,7 +1004,7 @@ public:
 			     const std::string& name_,
 			     const std::string& vcd_name_,
 			     int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1030,28 +1034,10 @@ vcd_unsigned_short_trace::changed()
 
 
 void
-vcd_unsigned_short_trace::write(FILE* f)
+vcd_unsigned_short_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if ((object & mask) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++){
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, (object & mask) != object);
     old_value = object;
 }
 
@@ -1063,7 +1049,7 @@ public:
 			    const std::string& name_,
 			    const std::string& vcd_name_,
 			    int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1091,28 +1077,10 @@ bool vcd_unsigned_char_trace::changed()
 }
 
 
-void vcd_unsigned_char_trace::write(FILE* f)
+void vcd_unsigned_char_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if ((object & mask) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++){
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, (object & mask) != object);
     old_value = object;
 }
 
@@ -1124,7 +1092,7 @@ public:
 			    const std::string& name_,
 			    const std::string& vcd_name_,
 			    int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1154,28 +1122,10 @@ bool vcd_unsigned_long_trace::changed()
 }
 
 
-void vcd_unsigned_long_trace::write(FILE* f)
+void vcd_unsigned_long_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if ((object & mask) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++){
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned long bit_mask = 1ul << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, (object & mask) != object);
     old_value = object;
 }
 
@@ -1187,7 +1137,7 @@ public:
 			 const std::string& name_,
 			 const std::string& vcd_name_,
 			 int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1214,28 +1164,10 @@ bool vcd_signed_int_trace::changed()
 }
 
 
-void vcd_signed_int_trace::write(FILE* f)
+void vcd_signed_int_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if (((object << rem_bits) >> rem_bits) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, ((object << rem_bits) >> rem_bits) != object);
     old_value = object;
 }
 
@@ -1247,7 +1179,7 @@ public:
 			   const std::string& name_,
 			   const std::string& vcd_name_,
 			   int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1274,28 +1206,10 @@ bool vcd_signed_short_trace::changed()
 }
 
 
-void vcd_signed_short_trace::write(FILE* f)
+void vcd_signed_short_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if (((object << rem_bits) >> rem_bits) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, ((object << rem_bits) >> rem_bits) != object);
     old_value = object;
 }
 
@@ -1307,7 +1221,7 @@ public:
 			  const std::string& name_,
 			  const std::string& vcd_name_,
 			  int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1333,28 +1247,10 @@ bool vcd_signed_char_trace::changed()
 }
 
 
-void vcd_signed_char_trace::write(FILE* f)
+void vcd_signed_char_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if (((object << rem_bits) >> rem_bits) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned bit_mask = 1 << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, ((object << rem_bits) >> rem_bits) != object);
     old_value = object;
 }
 
@@ -1366,7 +1262,7 @@ public:
 			  const std::string& name_,
 			  const std::string& vcd_name_,
 			  int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1393,31 +1289,10 @@ bool vcd_int64_trace::changed()
 }
 
 
-void vcd_int64_trace::write(FILE* f)
+void vcd_int64_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if (((object << rem_bits) >> rem_bits) != object)
-    {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else
-    {
-        sc_dt::uint64 bit_mask = 1;
-        bit_mask = bit_mask << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, ((object << rem_bits) >> rem_bits) != object);
     old_value = object;
 }
 
@@ -1430,7 +1305,7 @@ public:
 		     const std::string& name_,
 		     const std::string& vcd_name_,
 		     int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1458,31 +1333,10 @@ bool vcd_uint64_trace::changed()
 }
 
 
-void vcd_uint64_trace::write(FILE* f)
+void vcd_uint64_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if ((object & mask) != object)
-    {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else
-    {
-        sc_dt::uint64 bit_mask = 1;
-        bit_mask = bit_mask << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, (object & mask) != object);
     old_value = object;
 }
 
@@ -1525,7 +1379,7 @@ public:
 			  const std::string& name_,
 			  const std::string& vcd_name_,
 			  int width_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1552,28 +1406,10 @@ bool vcd_signed_long_trace::changed()
 }
 
 
-void vcd_signed_long_trace::write(FILE* f)
+void vcd_signed_long_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if (((object << rem_bits) >> rem_bits) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    }
-    else {
-        unsigned long bit_mask = 1ul << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, ((object << rem_bits) >> rem_bits) != object);
     old_value = object;
 }
 
@@ -1585,7 +1421,7 @@ public:
     vcd_float_trace(const float& object_,
 		    const std::string& name_,
 		    const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1608,9 +1444,9 @@ bool vcd_float_trace::changed()
     return object != old_value;
 }
 
-void vcd_float_trace::write(FILE* f)
+void vcd_float_trace::write(sc_trace_buffer& f)
 {
-    std::fprintf(f, "r%.16g %s", object, vcd_name.c_str());
+    write_real(f, object);
     old_value = object;
 }
 
@@ -1621,7 +1457,7 @@ public:
     vcd_double_trace(const double& object_,
 		     const std::string& name_,
 		     const std::string& vcd_name_);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1643,9 +1479,9 @@ bool vcd_double_trace::changed()
     return object != old_value;
 }
 
-void vcd_double_trace::write(FILE* f)
+void vcd_double_trace::write(sc_trace_buffer& f)
 {
-    std::fprintf(f, "r%.16g %s", object, vcd_name.c_str());
+    write_real(f, object);
     old_value = object;
 }
 
@@ -1658,7 +1494,7 @@ public:
 		   const std::string& name_,
 		   const std::string& vcd_name_,
 		   const char** enum_literals);
-    void write(FILE* f);
+    void write(sc_trace_buffer& f);
     bool changed();
 
 protected:
@@ -1701,27 +1537,10 @@ bool vcd_enum_trace::changed()
     return object != old_value;
 }
 
-void vcd_enum_trace::write(FILE* f)
+void vcd_enum_trace::write(sc_trace_buffer& f)
 {
-    char rawdata[1000];
-    char compdata[1000];
-    int bitindex;
-
     // Check for overflow
-    if ((object & mask) != object) {
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = 'x';
-        }
-    } else {
-        unsigned long bit_mask = 1ul << (bit_width-1);
-        for (bitindex = 0; bitindex < bit_width; bitindex++) {
-            rawdata[bitindex] = (object & bit_mask)? '1' : '0';
-            bit_mask = bit_mask >> 1;
-        }
-    }
-    rawdata[bitindex] = '\0';
-    compose_data_line(rawdata, compdata);
-    std::fputs(compdata, f);
+    write_bits(f, object, (object & mask) != object);
     old_value = object;
 }
 
@@ -1732,7 +1551,7 @@ void vcd_enum_trace::write(FILE* f)
 struct vcd_scope {
 
     void add_trace(vcd_trace *trace, bool with_scopes);
-    void print(FILE *fp, const char *scope_name = "SystemC");
+    void print(sc_trace_buffer& out, const char *scope_name = "SystemC");
 
     ~vcd_scope();
 private:
@@ -1776,18 +1595,20 @@ void vcd_scope::add_trace_rec(std::stringstream &ss, const std::string &cur_name
     }
 }
 
-void vcd_scope::print(FILE *fp, const char *scope_name) {
-    fprintf(fp,"$scope module %s $end\n", scope_name);
+void vcd_scope::print(sc_trace_buffer& out, const char *scope_name) {
+    out.write("$scope module ");
+    out.write(scope_name);
+    out.write(" $end\n");
 
     for (std::vector<std::pair<std::string,vcd_trace*> >::iterator it = m_traces.begin(); it != m_traces.end(); ++it) {
         it->second->set_width();
-        it->second->print_variable_declaration_line(fp, it->first.c_str());
+        it->second->print_variable_declaration_line(out, it->first.c_str());
     }
 
     for (std::map<std::string, vcd_scope*>::iterator it = m_scopes.begin(); it != m_scopes.end(); ++it)
-        it->second->print(fp,it->first.c_str());
+        it->second->print(out,it->first.c_str());
 
-    fprintf(fp,"$upscope $end\n");
+    out.write("$upscope $end\n");
 }
 
 #ifdef SC_DISABLE_VCD_SCOPES
@@ -1796,7 +1617,7 @@ void vcd_scope::print(FILE *fp, const char *scope_name) {
 #  define VCD_SCOPES_DEFAULT_ true
 #endif
 
-void vcd_print_scopes(FILE *fp, std::vector<vcd_trace*>& traces) {
+void vcd_print_scopes(sc_trace_buffer& out, std::vector<vcd_trace*>& traces) {
 
     vcd_scope top_scope;
 
@@ -1810,7 +1631,7 @@ void vcd_print_scopes(FILE *fp, std::vector<vcd_trace*>& traces) {
     for (std::vector<vcd_trace*>::iterator it = traces.begin(); it != traces.end(); ++it)
         top_scope.add_trace(*it, with_scopes);
 
-    top_scope.print(fp);
+    top_scope.print(out);
 }
 
 
@@ -1823,6 +1644,9 @@ vcd_trace_file::vcd_trace_file(const char *name)
   , vcd_name_index(0)
   , previous_time_units_low(0)
   , previous_time_units_high(0)
+  , polled_traces()
+  , changed_traces()
+  , cycle_traces()
   , traces()
 {}
 
@@ -1830,18 +1654,38 @@ vcd_trace_file::vcd_trace_file(const char *name)
 void
 vcd_trace_file::do_initialize()
 {
+    if(!out) open_buffer();
+
     //date:
-    std::fprintf(fp, "$date\n     %s\n$end\n\n", localtime_string().c_str() );
+    out->write("$date\n     ");
+    out->write(localtime_string());
+    out->write("\n$end\n\n");
 
     //version:
-    std::fprintf(fp, "$version\n %s\n$end\n\n", sc_version());
+    out->write("$version\n ");
+    out->write(sc_version());
+    out->write("\n$end\n\n");
 
     //timescale:
-    std::fprintf(fp,"$timescale\n     %s\n$end\n\n", fs_unit_to_str(trace_unit_fs).c_str());
+    out->write("$timescale\n     ");
+    out->write(fs_unit_to_str(trace_unit_fs));
+    out->write("\n$end\n\n");
 
-    vcd_print_scopes(fp, traces);
+    vcd_print_scopes(*out, traces);
+
+    // traces not attached to a signal channel are checked in each cycle
+    const char*    change_driven_p = std::getenv("SC_VCD_CHANGE_DRIVEN");
+    sc_string_view change_driven_s = (change_driven_p) ? change_driven_p : "";
+    bool change_driven = (change_driven_s != "DISABLE");
+
+    for (int i = 0; i < (int)traces.size(); i++) {
+        vcd_trace* t = traces[i];
+        t->index = i;
+        if (!change_driven) t->detach();
+        if (!t->attached()) polled_traces.push_back(t);
+    }
 
-    std::fputs("$enddefinitions  $end\n\n", fp);
+    out->write("$enddefinitions  $end\n\n");
 
     timestamp_in_trace_units(previous_time_units_high, previous_time_units_low);
 
@@ -1857,12 +1701,33 @@ vcd_trace_file::do_initialize()
 
     write_comment(ss.str());
 
-    std::fputs("$dumpvars\n",fp);
+    out->write("$dumpvars\n");
     for (int i = 0; i < (int)traces.size(); i++) {
-        traces[i]->write(fp);
-        std::fputc('\n', fp);
+        traces[i]->write(*out);
+        out->put('\n');
     }
-    std::fputs("$end\n\n", fp);
+    out->write("$end\n\n");
+
+    // all values are up to date
+    for (int i = 0; i < (int)changed_traces.size(); i++)
+        changed_traces[i]->marked = false;
+    changed_traces.clear();
+}
+
+void
+vcd_trace_file::push_trace(vcd_trace* t, const void* source)
+{
+    t->source = source;
+    t->changed_list = &changed_traces;
+    traces.push_back(t);
+}
+
+void
+vcd_trace_file::link_last_trace(const sc_signal_channel& ch, const void* value)
+{
+    // only link the trace, if it refers to the value stored in the channel
+    if (!traces.empty() && traces.back()->source == value && !is_initialized())
+        traces.back()->attach(ch);
 }
 
 #if SC_TRACING_PHASE_CALLBACKS_
@@ -1879,9 +1744,10 @@ void                                                                          \
 vcd_trace_file::trace(const tp& object_, const std::string& name_)            \
 {                                                                             \
     if( add_trace_check(name_) )                                              \
-        traces.push_back( new vcd_ ## tp ## _trace( extract_ref(object_),     \
-                                                    name_,                    \
-                                                    obtain_name() ) );        \
+        push_trace( new vcd_ ## tp ## _trace( extract_ref(object_),           \
+                                              name_,                          \
+                                              obtain_name() ),                \
+                    &object_ );                                               \
 }
 
 DEFN_TRACE_METHOD(sc_event)
@@ -1897,9 +1763,10 @@ void                                                                          \
 vcd_trace_file::trace(const sc_dt::tp& object_, const std::string& name_)     \
 {                                                                             \
     if( add_trace_check(name_) )                                              \
-        traces.push_back( new vcd_ ## tp ## _trace( object_,                  \
-                                                    name_,                    \
-                                                    obtain_name() ) );        \
+        push_trace( new vcd_ ## tp ## _trace( object_,                        \
+                                              name_,                          \
+                                              obtain_name() ),                \
+                    &object_ );                                               \
 }
 
 DEFN_TRACE_METHOD(sc_bit)
@@ -1925,10 +1792,11 @@ vcd_trace_file::trace( const tp&          object_,                            \
                        int                width_ )                            \
 {                                                                             \
     if( add_trace_check(name_) )                                              \
-        traces.push_back( new vcd_signed_ ## tp ## _trace( object_,           \
-                                                           name_,             \
-                                                           obtain_name(),     \
-                                                           width_ ) );        \
+        push_trace( new vcd_signed_ ## tp ## _trace( object_,                 \
+                                                     name_,                   \
+                                                     obtain_name(),           \
+                                                     width_ ),                \
+                    &object_ );                                               \
 }
 
 #define DEFN_TRACE_METHOD_UNSIGNED(tp)                                        \
@@ -1938,10 +1806,11 @@ vcd_trace_file::trace( const unsigned tp& object_,                            \
                        int                width_ )                            \
 {                                                                             \
     if( add_trace_check(name_) )                                              \
-        traces.push_back( new vcd_unsigned_ ## tp ## _trace( object_,         \
-                                                             name_,           \
-                                                             obtain_name(),   \
-                                                             width_ ) );      \
+        push_trace( new vcd_unsigned_ ## tp ## _trace( object_,               \
+                                                       name_,                 \
+                                                       obtain_name(),         \
+                                                       width_ ),              \
+                    &object_ );                                               \
 }
 
 DEFN_TRACE_METHOD_SIGNED(char)
@@ -1964,10 +1833,11 @@ vcd_trace_file::trace( const sc_dt::tp&   object_,                            \
                        int                width_ )                            \
 {                                                                             \
     if( add_trace_check(name_) )                                              \
-        traces.push_back( new vcd_ ## tp ## _trace( object_,                  \
-                                                    name_,                    \
-                                                    obtain_name(),            \
-                                                    width_ ) );               \
+        push_trace( new vcd_ ## tp ## _trace( object_,                        \
+                                              name_,                          \
+                                              obtain_name(),                  \
+                                              width_ ),                       \
+                    &object_ );                                               \
 }
 
 DEFN_TRACE_METHOD_LONG_LONG(int64)
@@ -1981,21 +1851,22 @@ vcd_trace_file::trace( const unsigned&    object_,
                        const char**       enum_literals_ )
 {
     if( add_trace_check(name_) )
-        traces.push_back( new vcd_enum_trace( object_,
-                                              name_,
-                                              obtain_name(),
-                                              enum_literals_ ) );
+        push_trace( new vcd_enum_trace( object_,
+                                        name_,
+                                        obtain_name(),
+                                        enum_literals_ ),
+                    &object_ );
 }
 
 
 void
 vcd_trace_file::write_comment(const std::string& comment)
 {
-    if(!fp) open_fp();
+    if(!out) open_buffer();
     //no newline in comments allowed, as some viewers may crash
-    std::fputs("$comment\n", fp);
-    std::fputs(comment.c_str(), fp);
-    std::fputs("\n$end\n\n", fp);
+    out->write("$comment\n");
+    out->write(comment);
+    out->write("\n$end\n\n");
 }
 
 void
@@ -2054,11 +1925,25 @@ vcd_trace_file::cycle(bool this_is_a_delta_cycle)
         }
     }
 
+    // Collect the traces to check in order of declaration: the polled ones
+    // and those attached to signals, which have been updated.
+    std::vector<vcd_trace*>* check_traces = &polled_traces;
+    if (!changed_traces.empty()) {
+        std::sort(changed_traces.begin(), changed_traces.end(), vcd_trace_less);
+        cycle_traces.resize(polled_traces.size() + changed_traces.size());
+        std::merge(polled_traces.begin(), polled_traces.end(),
+                   changed_traces.begin(), changed_traces.end(),
+                   cycle_traces.begin(), vcd_trace_less);
+        for (int i = 0; i < (int)changed_traces.size(); i++)
+            changed_traces[i]->marked = false;
+        changed_traces.clear();
+        check_traces = &cycle_traces;
+    }
+
     // Now do the actual printing
     bool time_printed = false;
-    vcd_trace* const* const l_traces = &traces[0];
-    for (int i = 0; i < (int)traces.size(); i++) {
-        vcd_trace* t = l_traces[i];
+    for (int i = 0; i < (int)check_traces->size(); i++) {
+        vcd_trace* t = (*check_traces)[i];
         if(t->changed()) {
             if(!time_printed){
                 print_time_stamp(now_units_high, now_units_low);
@@ -2067,12 +1952,12 @@ vcd_trace_file::cycle(bool this_is_a_delta_cycle)
             }
 
             // Write the variable
-            t->write(fp);
-            std::fputc('\n', fp);
+            t->write(*out);
+            out->put('\n');
         }
     }
     // Put another newline after all values are printed
-    if(time_printed) std::fputc('\n', fp);
+    if(time_printed) out->put('\n');
 }
 
 bool vcd_trace_file::get_time_stamp(sc_trace_file_base::unit_type &now_units_high,
@@ -2088,15 +1973,11 @@ bool vcd_trace_file::get_time_stamp(sc_trace_file_base::unit_type &now_units_hig
 void vcd_trace_file::print_time_stamp(sc_trace_file_base::unit_type now_units_high,
                                       sc_trace_file_base::unit_type now_units_low) const
 {
-
-    std::stringstream ss;
+    out->put('#');
+    out->write_dec(now_units_high);
     if(has_low_units())
-        ss << "#" << now_units_high << std::setfill('0') << std::setw(low_units_len()) << now_units_low;
-    else
-        ss << "#" << now_units_high;
-
-    fputs(ss.str().c_str(), fp);
-    fputc('\n', fp);
+        out->write_dec(now_units_low, low_units_len());
+    out->put('\n');
 }
 
 
@@ -180,8 +180,9 @@ protected:
     	vcd_enum type=VCD_WIRE)
     {
         if( add_trace_check(name) )
-            traces.push_back(new vcd_T_trace<T>( object, name
-                                               , obtain_name(),type) );
+            push_trace( new vcd_T_trace<T>( object, name
+                                          , obtain_name(), type ),
+                        &object );
     }
 
    // Trace sc_dt::sc_bv_base (sc_dt::sc_bv)
@@ -204,6 +205,10 @@ protected:
     // Write trace info for cycle.
      void cycle(bool delta_cycle);
 
+    // Check the last trace only after updates of the given channel
+    virtual void link_last_trace( const sc_signal_channel& ch,
+                                  const void* value );
+
 private:
 
     template<typename T> const T& extract_ref(const T& object) const
@@ -221,11 +226,18 @@ private:
     void print_time_stamp(unit_type now_units_high, unit_type now_units_low) const;
     bool get_time_stamp(unit_type &now_units_high, unit_type &now_units_low) const;
 
+    // Add a trace of the object at the given address
+    void push_trace(vcd_trace* t, const void* source);
+
     unsigned vcd_name_index;           // Number of variables traced
 
     unit_type previous_time_units_low;
     unit_type previous_time_units_high;
 
+    std::vector<vcd_trace*> polled_traces;  // traces checked in each cycle
+    std::vector<vcd_trace*> changed_traces; // traces of updated signals
+    std::vector<vcd_trace*> cycle_traces;   // traces checked in this cycle
+
 public:
 
     // Array to store the variables traced
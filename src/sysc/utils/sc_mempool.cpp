@@ -43,15 +43,22 @@
 //  set the environment variable SYSTEMC_MEMPOOL_DONT_USE to 1.
 
 
-static const char* dont_use_envstring = "SYSTEMC_MEMPOOL_DONT_USE";
-static bool use_default_new = false;
+//  With parallel simulation support, each host thread has its own
+//  memory pool, so that concurrent simulation contexts (sc_island)
+//  never share a free list.  A cell released by another host thread
+//  than the one that allocated it joins the free list of the
+//  releasing thread.
 
 
 #include <cstdio>
 #include <cstdlib>
 #include "sysc/kernel/sc_cmnhdr.h"
+#include "sysc/kernel/sc_worker_pool.h" // SC_HOST_THREAD_LOCAL_
 #include "sysc/utils/sc_mempool.h"
 
+static const char* dont_use_envstring = "SYSTEMC_MEMPOOL_DONT_USE";
+static SC_HOST_THREAD_LOCAL_ bool use_default_new = false;
+
 using std::printf;
 
 namespace sc_core {
@@ -244,7 +251,7 @@ sc_mempool_int::~sc_mempool_int()
     delete[] allocators;
 }
 
-static sc_mempool_int* the_mempool = 0;
+static SC_HOST_THREAD_LOCAL_ sc_mempool_int* the_mempool = 0;
 
 void*
 sc_mempool_int::do_allocate(std::size_t sz)
@@ -271,23 +278,31 @@ sc_mempool_int::display_statistics()
 
 /****************************************************************************/
 
-void*
-sc_mempool::allocate(std::size_t sz)
+// Creates the memory pool of the calling host thread on its first use.
+// Returns false if the memory pool is disabled.
+
+static bool
+init_mempool()
 {
     if (use_default_new)
-        return ::operator new(sz);
+        return false;
 
     if (the_mempool == 0) {
         use_default_new = compute_use_default_new();
         if (use_default_new)
-            return ::operator new(sz);
+            return false;
 
         // Note that the_mempool is never freed.  This is going to cause
         // memory leaks when the program exits.
         the_mempool = new sc_mempool_int( 1984, sizeof(cell_sizes)/sizeof(cell_sizes[0]) - 1, 8 );
     }
+    return true;
+}
 
-    if (sz > (unsigned) the_mempool->max_size)
+void*
+sc_mempool::allocate(std::size_t sz)
+{
+    if (! init_mempool() || sz > (unsigned) the_mempool->max_size)
         return ::operator new(sz);
 
     return the_mempool->do_allocate(sz);
@@ -298,7 +313,7 @@ sc_mempool::release(void* p, std::size_t sz)
 {
     if (p) {
         
-        if (use_default_new || sz > (unsigned) the_mempool->max_size) {
+        if (! init_mempool() || sz > (unsigned) the_mempool->max_size) {
             ::operator delete(p);
             return;
         }
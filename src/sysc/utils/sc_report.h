@@ -208,6 +208,24 @@ typedef std::exception sc_exception;
             ::sc_core::SC_INFO, msg_type, msg, verbosity, \
                                __FILE__ , __LINE__ )
 
+// As SC_REPORT_INFO_VERB, but a suppressed report costs a single comparison
+// (msg is not evaluated then) and the message type is looked up only once
+// per call site.  The call site remembers the message type by its address:
+// it is looked up again, when msg_type points elsewhere, but a string that
+// is changed in place must not be passed.  String literals and the message
+// type constants are fine.
+
+#define SC_REPORT_INFO_VERB_CACHED( msg_type, msg, verbosity )               \
+    do {                                                                     \
+        if( ::sc_core::sc_report_handler::is_verbosity_enabled( verbosity ) ) \
+        {                                                                    \
+            static ::sc_core::sc_msg_cache sc_msg_cache_ = { 0, 0, 0 };      \
+            ::sc_core::sc_report_handler::report(                            \
+                ::sc_core::SC_INFO, sc_msg_cache_, msg_type, msg, verbosity, \
+                __FILE__ , __LINE__ );                                       \
+        }                                                                    \
+    } while( false )
+
 #define SC_REPORT_WARNING( msg_type, msg ) \
     ::sc_core::sc_report_handler::report(  \
             ::sc_core::SC_WARNING, msg_type, msg, __FILE__, __LINE__ )
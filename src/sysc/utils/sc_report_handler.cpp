@@ -34,7 +34,10 @@
 
 #include "sysc/kernel/sc_process.h"
 #include "sysc/kernel/sc_simcontext_int.h"
+#include "sysc/kernel/sc_worker_pool.h"
+#include "sysc/communication/sc_host_mutex.h"
 #include "sysc/utils/sc_stop_here.h"
+#include "sysc/utils/sc_hash.h"
 #include "sysc/utils/sc_report_handler.h"
 #include "sysc/utils/sc_report.h"
 
@@ -44,6 +47,47 @@ namespace sc_core {
 
 int sc_report_handler::verbosity_level = SC_MEDIUM;
 
+// Index of the message definitions by message type.  It is built on the
+// first lookup, since message tables are registered during static
+// initialization, and dropped by release().  Lookups do not reorder the
+// buckets, so concurrent lookups are safe.
+
+static sc_strhash<sc_msg_def*>* msg_index = 0;
+
+// Incremented whenever a cached message definition may have become stale.
+
+static unsigned msg_epoch = 1;
+
+// Reports of host threads running different simulation contexts (see
+// sc_island) are processed one at a time.  A report issued by a handler
+// does not lock again.
+
+#if defined(SC_ENABLE_PARALLEL_SIMULATION)
+static sc_host_mutex report_mutex;
+static SC_HOST_THREAD_LOCAL_ int report_depth = 0;
+#endif
+
+struct report_lock
+{
+#if defined(SC_ENABLE_PARALLEL_SIMULATION)
+    report_lock()  { if( report_depth++ == 0 ) report_mutex.lock(); }
+    ~report_lock() { if( --report_depth == 0 ) report_mutex.unlock(); }
+#else
+    report_lock()  {}
+#endif
+};
+
+static void msg_index_insert( sc_msg_def* md, bool replace )
+{
+    char* key = const_cast<char*>( md->msg_type );
+    if ( !key )
+        return;
+    if ( replace )
+        msg_index->insert( key, md );
+    else
+        msg_index->insert_if_not_exists( key, md );
+}
+
 // not documented, but available
 const std::string sc_report_compose_message(const sc_report& rep)
 {
@@ -263,13 +307,19 @@ sc_msg_def * sc_report_handler::mdlookup(const char * msg_type_)
     if( !msg_type_ ) // if msg_type is NULL, report unknown error
         msg_type_ = SC_ID_UNKNOWN_ERROR_;
 
-    for ( msg_def_items * item = messages; item; item = item->next )
+    if ( !msg_index )
     {
-	for ( int i = 0; i < item->count; ++i )
-	    if ( !strcmp(msg_type_, item->md[i].msg_type) )
-		return item->md + i;
+	// the first definition of a message type wins, as in a linear search
+	msg_index = new sc_strhash<sc_msg_def*>( 0, 256,
+	    PHASH_DEFAULT_MAX_DENSITY, PHASH_DEFAULT_GROW_FACTOR, false );
+	for ( msg_def_items * item = messages; item; item = item->next )
+	    for ( int i = 0; i < item->count; ++i )
+		msg_index_insert( item->md + i, false );
     }
-    return 0;
+
+    sc_msg_def * md = 0;
+    msg_index->lookup( msg_type_, &md );
+    return md;
 }
 
 // The calculation of actions to be executed
@@ -331,8 +381,6 @@ void sc_report_handler::report( sc_severity severity_,
 				const char* file_, 
 				int line_ )
 {
-    sc_msg_def * md = mdlookup(msg_type_);
-
     // If the severity of the report is SC_INFO and the specified verbosity 
     // level is greater than the maximum verbosity level of the simulator then 
     // return without any action.
@@ -341,6 +389,8 @@ void sc_report_handler::report( sc_severity severity_,
 
     // Process the report:
 
+    report_lock lock;
+    sc_msg_def * md = mdlookup(msg_type_);
     if ( !md )
 	md = add_msg_type(msg_type_);
 
@@ -359,8 +409,6 @@ void sc_report_handler::report(sc_severity severity_,
 			       const char * file_,
 			       int line_)
 {
-    sc_msg_def * md = mdlookup(msg_type_);
-
     // If the severity of the report is SC_INFO and the maximum verbosity
     // level is less than SC_MEDIUM return without any action.
 
@@ -368,7 +416,8 @@ void sc_report_handler::report(sc_severity severity_,
 
     // Process the report:
 
-
+    report_lock lock;
+    sc_msg_def * md = mdlookup(msg_type_);
     if ( !md )
 	md = add_msg_type(msg_type_);
 
@@ -381,6 +430,36 @@ void sc_report_handler::report(sc_severity severity_,
     handler(rep, actions);
 }
 
+void sc_report_handler::report( sc_severity severity_,
+                                sc_msg_cache& msg_cache_,
+                                const char* msg_type_,
+                                const char* msg_,
+                                int verbosity_,
+                                const char* file_,
+                                int line_ )
+{
+    if ( (severity_ == SC_INFO) && (verbosity_ > verbosity_level) ) return;
+
+    report_lock lock;
+    if ( msg_cache_.epoch != msg_epoch || msg_cache_.msg_type != msg_type_ )
+    {
+	msg_cache_.md = mdlookup(msg_type_);
+	if ( !msg_cache_.md )
+	    msg_cache_.md = add_msg_type(msg_type_);
+	msg_cache_.msg_type = msg_type_;
+	msg_cache_.epoch = msg_epoch;
+    }
+    sc_msg_def * md = msg_cache_.md;
+
+    sc_actions actions = execute(md, severity_);
+    sc_report rep(severity_, md, msg_, file_, line_, verbosity_);
+
+    if ( actions & SC_CACHE_REPORT )
+	cache_report(rep);
+
+    handler(rep, actions);
+}
+
 // The following method is never called by the simulator.
 
 void sc_report_handler::initialize()
@@ -432,6 +511,10 @@ void sc_report_handler::release()
     last_global_report = 0;
     sc_report_close_default_log();
 
+    delete msg_index;
+    msg_index = 0;
+    ++msg_epoch;
+
     msg_def_items * items = messages, * newitems = &msg_terminator;
     messages = &msg_terminator;
 
@@ -505,6 +588,14 @@ void sc_report_handler::add_static_msg_types(msg_def_items * items)
     items->allocated = false;
     items->next = messages;
     messages = items;
+
+    // the new definitions hide any earlier ones of the same message type
+    if ( msg_index )
+    {
+	for ( int i = items->count; i-- > 0; )
+	    msg_index_insert( items->md + i, true );
+	++msg_epoch;
+    }
 }
 
 sc_actions sc_report_handler::set_actions(sc_severity severity_,
@@ -53,6 +53,21 @@ struct SC_API sc_msg_def
     int          id; // backward compatibility with 2.0+
 };
 
+// ----------------------------------------------------------------------------
+//  STRUCT : sc_msg_cache
+//
+//  Message definition of a report call site, looked up on the first report
+//  only (see SC_REPORT_INFO_VERB_CACHED).  It is looked up again, if the
+//  call site reports a message type at a different address.
+// ----------------------------------------------------------------------------
+
+struct sc_msg_cache
+{
+    const char*  msg_type; // address of the message type looked up
+    sc_msg_def*  md;
+    unsigned     epoch; // 0 - not looked up yet
+};
+
 typedef void (* sc_report_handler_proc)(const sc_report&, const sc_actions &);
 class sc_report;
 extern SC_API bool sc_report_close_default_log();
@@ -72,6 +87,14 @@ public:
 			const char* file, 
 			int line );
 
+    static void report( sc_severity,
+                        sc_msg_cache& msg_cache,
+                        const char* msg_type,
+                        const char* msg,
+                        int verbosity,
+                        const char* file,
+                        int line );
+
     static sc_actions set_actions(sc_severity,
 				  sc_actions = SC_UNSPECIFIED);
 
@@ -98,6 +121,10 @@ public:
     static int get_verbosity_level();
     static int set_verbosity_level( int level );
 
+    // true if an SC_INFO report of the given verbosity is not filtered out
+    static bool is_verbosity_enabled( int verbosity )
+        { return verbosity <= verbosity_level; }
+
 
     static void initialize(); // just reset counters
     static void release(); // initialize() needed for reports after it
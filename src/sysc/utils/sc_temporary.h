@@ -80,6 +80,21 @@ class SC_API sc_byte_heap {
     {
         char*   result_p;
         bytes_n = (bytes_n + 7) & ((std::size_t)(-8));
+#if defined(SC_ENABLE_PARALLEL_SIMULATION) && defined(__GNUC__)
+        // the heap is shared by concurrent simulation contexts (sc_island)
+        char* curr_p;
+        char* next_p;
+        do {
+            curr_p = m_next_p;
+            result_p = curr_p;
+            next_p = curr_p + bytes_n;
+            if ( next_p >= m_end_p )
+            {
+                result_p = m_bgn_p;
+                next_p = m_bgn_p + bytes_n;
+            }
+        } while ( !__sync_bool_compare_and_swap( &m_next_p, curr_p, next_p ) );
+#else
         result_p = m_next_p;
         m_next_p += bytes_n;
         if ( m_next_p >= m_end_p )
@@ -87,6 +102,7 @@ class SC_API sc_byte_heap {
             result_p = m_bgn_p;
             m_next_p = m_bgn_p + bytes_n;
         }
+#endif
         return result_p; 
     }
 
@@ -190,8 +206,13 @@ template<class T> T* sc_vpool<T>::allocate()
 {
 	T* result_p;	// Entry to return.
 
+#if defined(SC_ENABLE_PARALLEL_SIMULATION) && defined(__GNUC__)
+	// the pool is shared by concurrent simulation contexts (sc_island)
+	result_p = &m_pool_p[__sync_fetch_and_add( &m_pool_i, 1 ) & m_wrap];
+#else
 	result_p = &m_pool_p[m_pool_i];
 	m_pool_i = (m_pool_i + 1) & m_wrap;
+#endif
 	return result_p;
 }
 
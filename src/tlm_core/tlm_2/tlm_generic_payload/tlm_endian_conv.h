@@ -23,7 +23,10 @@
 
 #include "tlm_core/tlm_2/tlm_generic_payload/tlm_gp.h"
 
-#include <cstring> // std::memset
+#include <cstring> // std::memset, std::memcpy
+#if defined(_MSC_VER)
+#include <cstdlib> // _byteswap_uint64
+#endif
 
 namespace tlm {
 
@@ -69,10 +72,18 @@ All the functions have the same signature except for different names.
 The principle is that a function to_hostendian_convtype() is called when the
 initiator-endian transaction is created, and the matching function
 from_hostendian_convtype() is called when the transaction is completed, for
-example before read data can be used.  In some cases the from_ function is
-redundant but an empty function is provided anyway.  It is strongly
-recommended that the from_ function is called, in case it ceases to be
-redundant in future versions of this code.
+example before read data can be used.  The from_ function must always be
+called, for writes as well as for reads, even where it is empty (3).
+
+Transactions without byte enables and streaming, whose address is aligned to
+the bus width and whose length is a whole number of bus words, are converted
+in place by the functions (0), (1) and (2):  the data words within each bus
+word are reordered eight bytes at a time, and the from_ function reorders
+them back, also for writes, restoring the initiator's data.  Between the two
+calls the initiator's data buffer holds the reordered data, so it must be
+writable and must not be read or used by another transaction meanwhile.
+Otherwise the data and byte enables are copied to buffers kept in the context
+extension, which are reused by later conversions of the same transaction.
 
 No context needs to be managed outside the two functions, except that they
 must be called with the same template parameter and the same bus width.
@@ -90,8 +101,8 @@ Functions offered:
 only limitations are that data and bus widths should be powers of 2, and that
 the data length should be an integer number of streaming widths and that the
 streaming width should be an integer number of data words.
-These functions always allocate new data and byte enable buffers and copy
-data one byte at a time.
+Unless converted in place, the data and byte enables are copied one byte at
+a time.
   tlm_to_hostendian_generic(tlm_generic_payload *txn, int sizeof_databus)
   tlm_from_hostendian_generic(tlm_generic_payload *txn, int sizeof_databus)
 
@@ -104,11 +115,11 @@ than the data word (every data word is wholly enabled or wholly disabled)
 enable length must be equal to the data length).
 - streaming width is not supported
 - data word wider than bus word is not supported
-A new data buffer and a new byte enable buffer are always allocated.  Byte
-enables are assumed to be needed even if not required for the original
-(unconverted) transaction.  Data is copied to the new buffer on request
-(for writes) or on response (for reads).  Copies are done word-by-word
-where possible.
+Unless converted in place, a new data buffer and a new byte enable buffer
+are always used.  Byte enables are then assumed to be needed even if not
+required for the original (unconverted) transaction.  Data is copied to the
+new buffer on request (for writes) or on response (for reads).  Copies are
+done word-by-word where possible.
   tlm_to_hostendian_word(tlm_generic_payload *txn, int sizeof_databus)
   tlm_from_hostendian_word(tlm_generic_payload *txn, int sizeof_databus)
 
@@ -282,6 +293,96 @@ template<class D> D tlm_bool<D>::TLM_FALSE
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// In-place conversion: Utilities
+// the order of the data words within each bus word is reversed, eight bytes
+// at a time
+inline sc_dt::uint64 tlm_bswap64(sc_dt::uint64 x) {
+#if defined(__clang__) || \
+    (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 3)))
+  return __builtin_bswap64(x);
+#elif defined(_MSC_VER)
+  return _byteswap_uint64(x);
+#else
+  x = ((x >> 8) & 0x00ff00ff00ff00ffULL) | ((x & 0x00ff00ff00ff00ffULL) << 8);
+  x = ((x >> 16) & 0x0000ffff0000ffffULL) | ((x & 0x0000ffff0000ffffULL) << 16);
+  return (x >> 32) | (x << 32);
+#endif
+}
+
+// swaps the two halves of every 2*s bytes of x
+inline sc_dt::uint64 tlm_swap_halves(sc_dt::uint64 x, unsigned int s) {
+  if(s == 4) return (x >> 32) | (x << 32);
+  sc_dt::uint64 m = (s == 1) ? 0x00ff00ff00ff00ffULL : 0x0000ffff0000ffffULL;
+  return ((x >> (8 * s)) & m) | ((x & m) << (8 * s));
+}
+
+// reverses the order of the words of word_size bytes within every
+// lane_size bytes of x
+inline sc_dt::uint64 tlm_reverse_words(sc_dt::uint64 x,
+  unsigned int word_size, unsigned int lane_size) {
+  if(word_size == 1 && lane_size == 8) return tlm_bswap64(x);
+  for(unsigned int s = word_size; s < lane_size; s *= 2)
+    x = tlm_swap_halves(x, s);
+  return x;
+}
+
+// length must be a multiple of the bus width
+template<class D> inline void
+tlm_reverse_bus_words(uchar *data, unsigned int length,
+  unsigned int sizeof_databus) {
+  const unsigned int word = sizeof(D);
+  if(word >= sizeof_databus) return;
+
+  if(sizeof_databus <= 8) {
+    // one or more bus words in eight bytes
+    unsigned int i = 0;
+    for(; i + 8 <= length; i += 8) {
+      sc_dt::uint64 x;
+      std::memcpy(&x, data + i, 8);
+      x = tlm_reverse_words(x, word, sizeof_databus);
+      std::memcpy(data + i, &x, 8);
+    }
+    for(; i < length; i += sizeof_databus) {
+      sc_dt::uint64 x = 0;
+      std::memcpy(&x, data + i, sizeof_databus);
+      x = tlm_reverse_words(x, word, sizeof_databus);
+      std::memcpy(data + i, &x, sizeof_databus);
+    }
+  } else {
+    // swap the eight byte chunks at both ends of each bus word, reversing
+    // the data words within them
+    const unsigned int chunk_word = (word < 8) ? word : 8;
+    const unsigned int step = (word < 8) ? 8 : word;
+    for(uchar *bus = data; bus != data + length; bus += sizeof_databus) {
+      for(uchar *lo = bus, *hi = bus + sizeof_databus - step; lo < hi;
+          lo += step, hi -= step) {
+        for(unsigned int j = 0; j < step; j += 8) {
+          sc_dt::uint64 a, b;
+          std::memcpy(&a, lo + j, 8);
+          std::memcpy(&b, hi + j, 8);
+          a = tlm_reverse_words(a, chunk_word, 8);
+          b = tlm_reverse_words(b, chunk_word, 8);
+          std::memcpy(lo + j, &b, 8);
+          std::memcpy(hi + j, &a, 8);
+        }
+      }
+    }
+  }
+}
+
+// true, if the transaction can be converted in place:  no byte enables, no
+// streaming, and whole bus words
+inline bool tlm_whole_bus_words(tlm_generic_payload *txn,
+  unsigned int sizeof_databus, unsigned int sizeof_dataword) {
+  unsigned int len = txn->get_data_length();
+  return txn->get_byte_enable_ptr() == 0 && sizeof_dataword <= sizeof_databus
+    && (txn->get_address() & (sizeof_databus - 1)) == 0
+    && len % sizeof_databus == 0 && txn->get_streaming_width() >= len;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // function set (0): Utilities
 inline void copy_db0(uchar *src1, uchar *src2, uchar *dest1, uchar *dest2) {
@@ -339,6 +440,12 @@ inline void loop_generic0(int new_len, int new_stream_width,
 // function set (0): Response
 template<class DATAWORD> inline void
 tlm_from_hostendian_generic(tlm_generic_payload *txn, unsigned int sizeof_databus) {
+  if(txn->get_byte_enable_ptr() == 0) {
+    // converted in place
+    tlm_reverse_bus_words<DATAWORD>(txn->get_data_ptr(),
+      txn->get_data_length(), sizeof_databus);
+    return;
+  }
   if(txn->is_read()) {
     tlm_endian_context *tc = txn->template get_extension<tlm_endian_context>();
     loop_generic0<DATAWORD, &copy_dbyb0>(txn->get_data_length(),
@@ -357,6 +464,13 @@ tlm_to_hostendian_generic(tlm_generic_payload *txn, unsigned int sizeof_databus)
   tc->from_f = &(tlm_from_hostendian_generic<DATAWORD>);
   tc->sizeof_databus = sizeof_databus;
 
+  if(tlm_whole_bus_words(txn, sizeof_databus, sizeof(DATAWORD))) {
+    if(txn->is_write())
+      tlm_reverse_bus_words<DATAWORD>(txn->get_data_ptr(),
+        txn->get_data_length(), sizeof_databus);
+    return;
+  }
+
   // calculate new size:  nr stream words multiplied by big enough stream width
   int s_width = txn->get_streaming_width();
   int length = txn->get_data_length();
@@ -529,6 +643,12 @@ inline int loop_word1(
 // function set (1): Response
 template<class DATAWORD> inline void
 tlm_from_hostendian_word(tlm_generic_payload *txn, unsigned int sizeof_databus) {
+  if(txn->get_byte_enable_ptr() == 0) {
+    // converted in place
+    tlm_reverse_bus_words<DATAWORD>(txn->get_data_ptr(),
+      txn->get_data_length(), sizeof_databus);
+    return;
+  }
   if(txn->is_read()) {
     tlm_endian_context *tc = txn->template get_extension<tlm_endian_context>();
     sc_dt::uint64 b_mask = sizeof_databus - 1;
@@ -564,6 +684,13 @@ tlm_to_hostendian_word(tlm_generic_payload *txn, unsigned int sizeof_databus) {
   tc->from_f = &(tlm_from_hostendian_word<DATAWORD>);
   tc->sizeof_databus = sizeof_databus;
 
+  if(tlm_whole_bus_words(txn, sizeof_databus, sizeof(DATAWORD))) {
+    if(txn->is_write())
+      tlm_reverse_bus_words<DATAWORD>(txn->get_data_ptr(),
+        txn->get_data_length(), sizeof_databus);
+    return;
+  }
+
   sc_dt::uint64 b_mask = sizeof_databus - 1;
   int d_mask = sizeof(DATAWORD) - 1;
   sc_dt::uint64 a_aligned = txn->get_address() & ~b_mask;
@@ -672,13 +799,9 @@ tlm_from_hostendian_aligned(tlm_generic_payload *txn, unsigned int sizeof_databu
   tlm_endian_context *tc = txn->template get_extension<tlm_endian_context>();
 
   if(txn->get_byte_enable_ptr() == 0) {
-    // no byte enables
-    if(txn->is_read()) {
-      // RD without byte enables.  Copy data to original buffer
-      loop_aligned2<DATAWORD, &copy_d2<DATAWORD> >(
-        (DATAWORD *)(txn->get_data_ptr()),
-        0, (DATAWORD *)(tc->data_ptr), 0, words, words_per_bus);
-    }
+    // no byte enables.  Converted in place
+    tlm_reverse_bus_words<DATAWORD>(txn->get_data_ptr(),
+      txn->get_data_length(), sizeof_databus);
   } else {
     // byte enables present
     if(txn->is_read()) {
@@ -707,24 +830,16 @@ tlm_to_hostendian_aligned(tlm_generic_payload *txn, unsigned int sizeof_databus)
   DATAWORD *original_be = (DATAWORD *)(txn->get_byte_enable_ptr());
   DATAWORD *original_data = (DATAWORD *)(txn->get_data_ptr());
 
-  // always allocate a new data buffer
-  tc->establish_dbuf(txn->get_data_length());
-  txn->set_data_ptr(tc->new_dbuf);
-
   if(original_be == 0) {
-    // no byte enables
-    if(txn->is_write()) {
-      // WR no byte enables.  Copy data
-      loop_aligned2<DATAWORD, &copy_d2<DATAWORD> >(original_data, 0,
-        (DATAWORD *)(txn->get_data_ptr()), 0,
-        words, words_per_bus);
-    } else {
-      // RD no byte enables.  Save original data pointer
-      tc->data_ptr = (uchar *)original_data;
-    }
+    // no byte enables.  Convert in place, RD data is converted on response
+    if(txn->is_write())
+      tlm_reverse_bus_words<DATAWORD>(txn->get_data_ptr(),
+        txn->get_data_length(), sizeof_databus);
   } else {
     // byte enables present
-    // allocate a new buffer for them
+    // allocate new buffers for the data and for them
+    tc->establish_dbuf(txn->get_data_length());
+    txn->set_data_ptr(tc->new_dbuf);
     tc->establish_bebuf(txn->get_data_length());
     txn->set_byte_enable_ptr(tc->new_bebuf);
     txn->set_byte_enable_length(txn->get_data_length());
@@ -0,0 +1,182 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+#include "tlm_utils/adaptive_quantumkeeper.h"
+
+#include "sysc/kernel/sc_kernel_profiler.h" // wall time
+#include "sysc/utils/sc_report.h"
+#include <iostream>
+#include <sstream>
+
+namespace tlm_utils {
+
+static const char* const adaptive_quantumkeeper_report_type =
+  "/OSCI_TLM-2/adaptive_quantumkeeper";
+
+adaptive_quantumkeeper::adaptive_quantumkeeper(const char* name)
+  : tlm_quantumkeeper()
+  , m_name(name)
+  , m_min_quantum(sc_core::SC_ZERO_TIME)
+  , m_max_quantum(sc_core::SC_ZERO_TIME)
+  , m_range_set(false)
+  , m_quantum(sc_core::SC_ZERO_TIME)
+  , m_started(false)
+  , m_in_sync(false)
+  , m_sync_quantum_used(false)
+  , m_invalidated(false)
+  , m_syncs(0)
+  , m_early_syncs(0)
+  , m_dmi_invalidations(0)
+  , m_total_ahead(sc_core::SC_ZERO_TIME)
+  , m_max_ahead(sc_core::SC_ZERO_TIME)
+  , m_last_ticks(0)
+  , m_total_ticks(0)
+{}
+
+void
+adaptive_quantumkeeper::set_quantum_range(const sc_core::sc_time& min,
+                                          const sc_core::sc_time& max)
+{
+  if (min > max) {
+    std::stringstream s;
+    s << m_name << ": minimum quantum " << min
+      << " exceeds maximum quantum " << max << ", range ignored";
+    SC_REPORT_ERROR(adaptive_quantumkeeper_report_type, s.str().c_str());
+    return;
+  }
+  m_min_quantum = min;
+  m_max_quantum = max;
+  m_range_set = true;
+}
+
+sc_core::sc_time
+adaptive_quantumkeeper::get_min_quantum() const
+{
+  return m_range_set ? m_min_quantum : get_global_quantum() / 16;
+}
+
+sc_core::sc_time
+adaptive_quantumkeeper::get_max_quantum() const
+{
+  return m_range_set ? m_max_quantum : get_global_quantum();
+}
+
+void
+adaptive_quantumkeeper::dmi_invalidated()
+{
+  ++m_dmi_invalidations;
+  m_invalidated = true;
+}
+
+// Whether the quantum was used up is decided before waiting, as the local
+// time is still pending then.
+
+void
+adaptive_quantumkeeper::sync()
+{
+  m_sync_quantum_used = need_sync();
+  m_in_sync = true;
+  sc_core::wait(m_local_time);
+  reset();
+}
+
+void
+adaptive_quantumkeeper::reset()
+{
+  if (m_started) {
+    // called by the initiator after waiting for its local time
+    bool used = m_in_sync ? m_sync_quantum_used
+                          : sc_core::sc_time_stamp() >= m_next_sync_point;
+    synchronized(used, m_local_time);
+  } else {
+    m_started = true;
+    m_last_ticks = sc_core::sc_kernel_profiler::now();
+  }
+  m_in_sync = false;
+  tlm_quantumkeeper::reset();
+}
+
+void
+adaptive_quantumkeeper::synchronized(bool quantum_used,
+                                     const sc_core::sc_time& ahead)
+{
+  ++m_syncs;
+  if (!quantum_used)
+    ++m_early_syncs;
+  m_total_ahead += ahead;
+  if (ahead > m_max_ahead)
+    m_max_ahead = ahead;
+
+  sc_dt::uint64 ticks = sc_core::sc_kernel_profiler::now();
+  m_total_ticks += ticks - m_last_ticks;
+  m_last_ticks = ticks;
+
+  if (quantum_used && !m_invalidated)
+    m_quantum = m_quantum * 2;
+  else
+    m_quantum = m_quantum / 2;
+  m_invalidated = false;
+}
+
+// Within its range, the local quantum is kept as adapted, sync points are
+// multiples of it.
+
+sc_core::sc_time
+adaptive_quantumkeeper::compute_local_quantum()
+{
+  sc_core::sc_time min = get_min_quantum();
+  sc_core::sc_time max = get_max_quantum();
+  if (m_quantum == sc_core::SC_ZERO_TIME || m_quantum > max)
+    m_quantum = max;
+  else if (m_quantum < min)
+    m_quantum = min;
+
+  if (m_quantum == sc_core::SC_ZERO_TIME)
+    return sc_core::SC_ZERO_TIME;
+  return m_quantum - (sc_core::sc_time_stamp() % m_quantum);
+}
+
+sc_core::sc_time
+adaptive_quantumkeeper::average_time_ahead() const
+{
+  if (m_syncs == 0)
+    return sc_core::SC_ZERO_TIME;
+  return m_total_ahead / static_cast<double>(m_syncs);
+}
+
+double
+adaptive_quantumkeeper::average_wall_time() const
+{
+  if (m_syncs == 0)
+    return 0.0;
+  return static_cast<double>(m_total_ticks) / 1e9
+    / static_cast<double>(m_syncs);
+}
+
+void
+adaptive_quantumkeeper::print_statistics(std::ostream& os) const
+{
+  os << m_name << ": " << m_syncs << " sync(s), " << m_early_syncs
+     << " early, " << m_dmi_invalidations << " DMI invalidation(s), quantum "
+     << m_quantum << ", time ahead " << average_time_ahead()
+     << " average, " << m_max_ahead << " max, "
+     << average_wall_time() * 1e6 << " us between syncs" << std::endl;
+}
+
+} // namespace tlm_utils
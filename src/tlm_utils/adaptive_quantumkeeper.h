@@ -0,0 +1,119 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+#ifndef TLM_UTILS_ADAPTIVE_QUANTUMKEEPER_H_INCLUDED_
+#define TLM_UTILS_ADAPTIVE_QUANTUMKEEPER_H_INCLUDED_
+
+#include "sysc/kernel/sc_simcontext.h" // sc_time_stamp
+#include "sysc/kernel/sc_wait.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include <iosfwd>
+#include <string>
+
+namespace tlm_utils {
+
+//
+// adaptive_quantumkeeper class
+//
+// A quantum keeper which adapts the local quantum of its initiator to how
+// often the initiator interacts with the rest of the system, and keeps
+// statistics of its synchronizations. It can replace a tlm_quantumkeeper
+// without changing the calls made by the initiator.
+//
+// A synchronization before the local quantum is used up, i.e. a call of
+// sync() while need_sync() is false or a call of reset() by the initiator
+// before the next sync point, halves the local quantum, as does a DMI
+// invalidation reported with dmi_invalidated(). A synchronization at the
+// end of the local quantum doubles it. The local quantum stays within a
+// range, by default from 1/16 of the global quantum up to the global
+// quantum, and the sync points are multiples of the local quantum. An
+// initiator may run further ahead than the global quantum if the range
+// is set accordingly.
+//
+// A keeper belongs to a single initiator: its state and statistics are not
+// shared and no locks are taken, also when initiators are simulated in
+// parallel.
+//
+class SC_API adaptive_quantumkeeper : public tlm_quantumkeeper
+{
+public:
+  explicit adaptive_quantumkeeper(const char* name = "quantum keeper");
+
+  //
+  // Range of the local quantum, replacing the default range derived from
+  // the global quantum
+  //
+  void set_quantum_range(const sc_core::sc_time& min,
+                         const sc_core::sc_time& max);
+  sc_core::sc_time get_min_quantum() const;
+  sc_core::sc_time get_max_quantum() const;
+
+  // the current local quantum
+  const sc_core::sc_time& get_quantum() const { return m_quantum; }
+
+  //
+  // To be called by the initiator when one of its DMI pointers has been
+  // invalidated
+  //
+  void dmi_invalidated();
+
+  virtual void sync();
+  virtual void reset();
+
+  //
+  // Statistics
+  //
+  sc_dt::uint64 syncs() const { return m_syncs; }
+  sc_dt::uint64 early_syncs() const { return m_early_syncs; }
+  sc_dt::uint64 dmi_invalidations() const { return m_dmi_invalidations; }
+  sc_core::sc_time average_time_ahead() const;  // local time at a sync
+  const sc_core::sc_time& max_time_ahead() const { return m_max_ahead; }
+  double average_wall_time() const;             // seconds between syncs
+
+  void print_statistics(std::ostream& os) const;
+
+protected:
+  virtual sc_core::sc_time compute_local_quantum();
+
+private:
+  // counts a synchronization and adapts the local quantum
+  void synchronized(bool quantum_used, const sc_core::sc_time& ahead);
+
+private:
+  std::string      m_name;
+  sc_core::sc_time m_min_quantum;      // if m_range_set
+  sc_core::sc_time m_max_quantum;
+  bool             m_range_set;
+  sc_core::sc_time m_quantum;          // (or zero before the first reset)
+  bool             m_started;          // reset at least once
+  bool             m_in_sync;          // reset called by sync
+  bool             m_sync_quantum_used;
+  bool             m_invalidated;      // DMI since the last sync
+  sc_dt::uint64    m_syncs;
+  sc_dt::uint64    m_early_syncs;
+  sc_dt::uint64    m_dmi_invalidations;
+  sc_core::sc_time m_total_ahead;
+  sc_core::sc_time m_max_ahead;
+  sc_dt::uint64    m_last_ticks;       // wall time of the last sync in ns
+  sc_dt::uint64    m_total_ticks;
+};
+
+} // namespace tlm_utils
+
+#endif // TLM_UTILS_ADAPTIVE_QUANTUMKEEPER_H_INCLUDED_
@@ -0,0 +1,222 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+#include "tlm_utils/payload_pool.h"
+
+#include "sysc/utils/sc_report.h"
+#include <iostream>
+#include <sstream>
+
+// Payloads may be freed by other host threads also without parallel
+// simulation (e.g. by a co-simulation thread), so the storage is
+// thread-local in any case.
+#if SC_CPLUSPLUS >= 201103L
+# define TLM_UTILS_THREAD_LOCAL_ thread_local
+#elif defined(_MSC_VER)
+# define TLM_UTILS_THREAD_LOCAL_ __declspec(thread)
+#else
+# define TLM_UTILS_THREAD_LOCAL_ __thread
+#endif
+
+namespace tlm_utils {
+
+/* anonymous */ namespace {
+// its address identifies the host thread
+TLM_UTILS_THREAD_LOCAL_ char thread_tag;
+TLM_UTILS_THREAD_LOCAL_ payload_pool* thread_pool = 0;
+} // anonymous namespace
+
+//
+// a payload together with its buffers
+//
+class payload_pool::pooled_payload : public tlm::tlm_generic_payload
+{
+public:
+  explicit pooled_payload(payload_pool* pool)
+    : tlm::tlm_generic_payload(pool)
+    , m_data(0), m_data_capacity(0), m_be(0), m_be_capacity(0)
+  {}
+
+  ~pooled_payload()
+  {
+    delete [] m_data;
+    delete [] m_be;
+  }
+
+  void attach_buffers(unsigned int data_length,
+                      unsigned int byte_enable_length)
+  {
+    if (data_length > m_data_capacity) {
+      delete [] m_data;
+      m_data = new unsigned char[data_length];
+      m_data_capacity = data_length;
+    }
+    set_data_ptr(m_data);
+    set_data_length(data_length);
+    set_streaming_width(data_length);
+
+    if (byte_enable_length) {
+      if (byte_enable_length > m_be_capacity) {
+        delete [] m_be;
+        m_be = new unsigned char[byte_enable_length];
+        m_be_capacity = byte_enable_length;
+      }
+      set_byte_enable_ptr(m_be);
+      set_byte_enable_length(byte_enable_length);
+    }
+  }
+
+  // restore the values set by the constructor, keep the extensions
+  // except for the auto extensions
+  void clear()
+  {
+    reset();
+    set_address(0);
+    set_command(tlm::TLM_IGNORE_COMMAND);
+    set_data_ptr(0);
+    set_data_length(0);
+    set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+    set_dmi_allowed(false);
+    set_byte_enable_ptr(0);
+    set_byte_enable_length(0);
+    set_streaming_width(0);
+  }
+
+private:
+  unsigned char* m_data;
+  unsigned int   m_data_capacity;
+  unsigned char* m_be;
+  unsigned int   m_be_capacity;
+};
+
+payload_pool::payload_pool(std::size_t max_cached)
+  : m_free()
+  , m_remote()
+  , m_remote_mutex()
+  , m_thread(&thread_tag)
+  , m_max_cached(max_cached)
+  , m_live(0)
+  , m_hits(0)
+  , m_misses(0)
+  , m_remote_frees(0)
+{}
+
+payload_pool::~payload_pool()
+{
+  for (std::size_t i = 0; i < m_remote.size(); ++i)
+    m_free.push_back(m_remote[i]);
+  m_remote.clear();
+
+  if (m_live != m_free.size()) {
+    std::stringstream s;
+    s << m_live - m_free.size()
+      << " payload(s) still in use when deleting the pool";
+    SC_REPORT_WARNING("/OSCI_TLM-2/payload_pool", s.str().c_str());
+  }
+  for (std::size_t i = 0; i < m_free.size(); ++i)
+    destroy(m_free[i]);
+}
+
+payload_pool&
+payload_pool::instance()
+{
+  if (!thread_pool)
+    thread_pool = new payload_pool();
+  return *thread_pool;
+}
+
+tlm::tlm_generic_payload*
+payload_pool::allocate()
+{
+  return get();
+}
+
+tlm::tlm_generic_payload*
+payload_pool::allocate(unsigned int data_length,
+                       unsigned int byte_enable_length)
+{
+  pooled_payload* trans = get();
+  trans->attach_buffers(data_length, byte_enable_length);
+  return trans;
+}
+
+void
+payload_pool::free(tlm::tlm_generic_payload* trans)
+{
+  // only payloads allocated from this pool have it as their manager
+  pooled_payload* p = static_cast<pooled_payload*>(trans);
+  if (m_thread == &thread_tag) {
+    recycle(p);
+  } else {
+    sc_core::sc_scoped_lock lock(m_remote_mutex);
+    m_remote.push_back(p);
+  }
+}
+
+payload_pool::pooled_payload*
+payload_pool::get()
+{
+  if (m_free.empty()) {
+    // take over the payloads freed by other host threads, if any
+    sc_core::sc_scoped_lock lock(m_remote_mutex);
+    m_remote_frees += m_remote.size();
+    for (std::size_t i = 0; i < m_remote.size(); ++i)
+      recycle(m_remote[i]);
+    m_remote.clear();
+  }
+
+  if (m_free.empty()) {
+    ++m_misses;
+    ++m_live;
+    return new pooled_payload(this);
+  }
+
+  ++m_hits;
+  pooled_payload* trans = m_free.back();
+  m_free.pop_back();
+  return trans;
+}
+
+void
+payload_pool::recycle(pooled_payload* trans)
+{
+  if (m_free.size() < m_max_cached) {
+    trans->clear();
+    m_free.push_back(trans);
+  } else {
+    destroy(trans);
+  }
+}
+
+void
+payload_pool::destroy(pooled_payload* trans)
+{
+  --m_live;
+  delete trans;
+}
+
+void
+payload_pool::print_statistics(std::ostream& os) const
+{
+  os << "payload pool: " << m_hits << " hit(s), " << m_misses
+     << " miss(es), " << m_remote_frees << " remote free(s), "
+     << cached() << " cached, " << in_use() << " in use" << std::endl;
+}
+
+} // namespace tlm_utils
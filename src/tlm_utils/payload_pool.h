@@ -0,0 +1,114 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+#ifndef TLM_UTILS_PAYLOAD_POOL_H_INCLUDED_
+#define TLM_UTILS_PAYLOAD_POOL_H_INCLUDED_
+
+#include "tlm_core/tlm_2/tlm_generic_payload/tlm_gp.h"
+#include "sysc/communication/sc_host_mutex.h"
+
+#include <iosfwd>
+#include <vector>
+
+namespace tlm_utils {
+
+//
+// payload_pool class
+//
+// A memory manager recycling generic payloads. A payload allocated from the
+// pool has the pool as its memory manager and is returned to the pool when
+// its reference count drops to zero. Payloads are recycled together with
+// their data and byte enable buffers, which only grow, and with their
+// extensions: extensions set with set_auto_extension() are freed on return
+// to the pool, all others stay attached and can be reused by the next
+// user of the payload.
+//
+// A pool belongs to the host thread which created it. Payloads freed by
+// another host thread are handed back to the owner under a mutex, and are
+// taken over by the owner on its next allocation which misses the cache.
+// instance() returns the pool of the calling host thread.
+//
+class SC_API payload_pool : public tlm::tlm_mm_interface
+{
+public:
+  //
+  // At most max_cached free payloads are kept, others are deleted
+  //
+  explicit payload_pool(std::size_t max_cached = 4096);
+  ~payload_pool();
+
+  //
+  // The pool of the calling host thread, created on first use and never
+  // deleted
+  //
+  static payload_pool& instance();
+
+  //
+  // Allocate a payload with a reference count of zero, which the caller
+  // is expected to acquire(). The payload is reset to its default values,
+  // without data. The second version attaches a data buffer of the given
+  // length and, if byte_enable_length is not zero, a byte enable buffer.
+  // The contents of the buffers are undefined.
+  //
+  tlm::tlm_generic_payload* allocate();
+  tlm::tlm_generic_payload* allocate(unsigned int data_length,
+                                     unsigned int byte_enable_length = 0);
+
+  //
+  // Called by tlm_generic_payload::release()
+  //
+  virtual void free(tlm::tlm_generic_payload* trans);
+
+  //
+  // Statistics
+  //
+  sc_dt::uint64 hits() const { return m_hits; }                 // from cache
+  sc_dt::uint64 misses() const { return m_misses; }             // created
+  sc_dt::uint64 remote_frees() const { return m_remote_frees; } // other thread
+  std::size_t cached() const { return m_free.size(); }
+  std::size_t in_use() const { return m_live - m_free.size(); }
+
+  void print_statistics(std::ostream& os) const;
+
+private:
+  class pooled_payload;
+
+  pooled_payload* get();
+  void recycle(pooled_payload* trans);
+  void destroy(pooled_payload* trans);
+
+private:
+  std::vector<pooled_payload*> m_free;       // free payloads, most recent last
+  std::vector<pooled_payload*> m_remote;     // freed by other host threads
+  sc_core::sc_host_mutex       m_remote_mutex;
+  const void*                  m_thread;     // identifies the owner
+  std::size_t                  m_max_cached;
+  std::size_t                  m_live;       // payloads owned by the pool
+  sc_dt::uint64                m_hits;
+  sc_dt::uint64                m_misses;
+  sc_dt::uint64                m_remote_frees;
+
+private:
+  // disabled
+  payload_pool(const payload_pool&);
+  payload_pool& operator=(const payload_pool&);
+};
+
+} // namespace tlm_utils
+
+#endif // TLM_UTILS_PAYLOAD_POOL_H_INCLUDED_
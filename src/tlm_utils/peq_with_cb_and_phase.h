@@ -31,6 +31,7 @@
 #include <vector>
 #include <systemc>
 #include <tlm>
+#include "tlm_utils/time_ordered_heap.h"
 
 namespace tlm_utils {
 
@@ -271,16 +272,15 @@ private:
 
     //timed notifications
     const sc_core::sc_time now=sc_core::sc_time_stamp();
-    sc_core::sc_time top=m_ppq.top_time();
 
-    while(m_ppq.get_size() && top==now) { // push all active ones into target
-      PAYLOAD& tmp=m_ppq.top();
-      (m_owner->*m_cb)(*tmp.first, tmp.second); //tmp.first->release();}
+    // the entry is removed before the callback, which may insert into the heap
+    while(m_ppq.get_size() && m_ppq.top_time()==now) { // push all active ones into target
+      PAYLOAD tmp=m_ppq.top();
       m_ppq.delete_top();
-      top=m_ppq.top_time();
+      (m_owner->*m_cb)(*tmp.first, tmp.second); //tmp.first->release();}
     }
     if ( m_ppq.get_size()) {
-      m_e.notify( top - now) ;
+      m_e.notify( m_ppq.top_time() - now) ;
     }
 
   }
@@ -288,7 +288,7 @@ private:
   OWNER* m_owner;
   cb     m_cb;
 
-  time_ordered_list<PAYLOAD> m_ppq;
+  time_ordered_heap<PAYLOAD> m_ppq;
   delta_list m_uneven_delta;
   delta_list m_even_delta;
   delta_list m_immediate_yield;
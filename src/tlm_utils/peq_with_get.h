@@ -27,6 +27,7 @@
 #include <systemc>
 //#include <tlm>
 #include <map>
+#include "tlm_utils/time_ordered_heap.h"
 
 namespace tlm_utils {
 
@@ -44,31 +45,31 @@ public:
 
   void notify(transaction_type& trans, const sc_core::sc_time& t)
   {
-    m_scheduled_events.insert(pair_type(t + sc_core::sc_time_stamp(), &trans));
+    m_scheduled_events.insert(&trans, t + sc_core::sc_time_stamp());
     m_event.notify(t);
   }
 
   void notify(transaction_type& trans)
   {
-    m_scheduled_events.insert(pair_type(sc_core::sc_time_stamp(), &trans));
+    m_scheduled_events.insert(&trans, sc_core::sc_time_stamp());
     m_event.notify(); // immediate notification
   }
 
   // needs to be called until it returns 0
   transaction_type* get_next_transaction()
   {
-    if (m_scheduled_events.empty()) {
+    if (!m_scheduled_events.get_size()) {
       return 0;
     }
 
     sc_core::sc_time now = sc_core::sc_time_stamp();
-    if (m_scheduled_events.begin()->first <= now) {
-      transaction_type* trans = m_scheduled_events.begin()->second;
-      m_scheduled_events.erase(m_scheduled_events.begin());
+    if (m_scheduled_events.top_time() <= now) {
+      transaction_type* trans = m_scheduled_events.top();
+      m_scheduled_events.delete_top();
       return trans;
     }
 
-    m_event.notify(m_scheduled_events.begin()->first - now);
+    m_event.notify(m_scheduled_events.top_time() - now);
 
     return 0;
   }
@@ -80,12 +81,12 @@ public:
 
   // Cancel all events from the event queue
   void cancel_all() {
-    m_scheduled_events.clear();
+    m_scheduled_events.reset();
     m_event.cancel();
   }
 
 private:
-  std::multimap<const sc_core::sc_time, transaction_type*> m_scheduled_events;
+  time_ordered_heap<transaction_type*> m_scheduled_events;
   sc_core::sc_event m_event;
 };
 
@@ -0,0 +1,346 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+
+#include "tlm_utils/sparse_memory.h"
+
+#include "sysc/utils/sc_report.h"
+#include <cstring>
+#include <sstream>
+
+#if !defined(_WIN32) && !defined(WIN32)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+# define TLM_UTILS_SPARSE_MEMORY_MMAP_
+# if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#   define MAP_ANONYMOUS MAP_ANON
+# endif
+# if !defined(MAP_NORESERVE)
+#   define MAP_NORESERVE 0
+# endif
+#endif
+
+namespace tlm_utils {
+
+static const char* const sparse_memory_report_type = "/OSCI_TLM-2/sparse_memory";
+
+sparse_memory::sparse_memory(const sc_core::sc_module_name& name,
+                             sc_dt::uint64 size,
+                             const char* file,
+                             unsigned int page_size)
+  : sc_core::sc_module(name)
+  , socket("socket")
+  , m_size(size)
+  , m_page_size(page_size)
+  , m_page_bits(0)
+  , m_page_table()
+  , m_touched(0)
+  , m_base(0)
+  , m_fd(-1)
+  , m_file()
+  , m_read_latency(sc_core::SC_ZERO_TIME)
+  , m_write_latency(sc_core::SC_ZERO_TIME)
+{
+  if (m_page_size == 0 || (m_page_size & (m_page_size - 1)) != 0) {
+    std::stringstream s;
+    s << this->name() << ": page size " << m_page_size
+      << " is not a power of two, using 65536";
+    SC_REPORT_ERROR(sparse_memory_report_type, s.str().c_str());
+    m_page_size = 64 * 1024;
+  }
+  while ((1u << m_page_bits) < m_page_size)
+    ++m_page_bits;
+
+  sc_dt::uint64 pages = (m_size + m_page_size - 1) >> m_page_bits;
+  m_page_table.resize(
+    static_cast<std::size_t>((pages + chunk_pages - 1) / chunk_pages));
+
+  map(file);
+
+  socket.register_b_transport(this, &sparse_memory::b_transport);
+  socket.register_transport_dbg(this, &sparse_memory::transport_dbg);
+  socket.register_get_direct_mem_ptr(this, &sparse_memory::get_direct_mem_ptr);
+}
+
+sparse_memory::~sparse_memory()
+{
+  for (std::size_t i = 0; i < m_page_table.size(); ++i) {
+    unsigned char** chunk = m_page_table[i];
+    if (chunk && !m_base) {
+      for (unsigned int j = 0; j < chunk_pages; ++j)
+        delete [] chunk[j];
+    }
+    delete [] chunk;
+  }
+  unmap();
+}
+
+// The mapping is reserved without swap space, so that only the pages
+// written to are allocated by the host.
+
+void
+sparse_memory::map(const char* file)
+{
+#if defined(TLM_UTILS_SPARSE_MEMORY_MMAP_)
+  if (m_size == 0 || m_size != static_cast<std::size_t>(m_size))
+    return;
+  std::size_t size = static_cast<std::size_t>(m_size);
+
+  void* base = MAP_FAILED;
+  if (file) {
+    m_file = file;
+    m_fd = ::open(file, O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if (m_fd >= 0 && ::fstat(m_fd, &st) == 0
+        && (static_cast<sc_dt::uint64>(st.st_size) >= m_size
+            || ::ftruncate(m_fd, static_cast<off_t>(m_size)) == 0)) {
+      base = ::mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    }
+    if (base == MAP_FAILED) {
+      std::stringstream s;
+      s << name() << ": cannot map file '" << file << "'";
+      SC_REPORT_ERROR(sparse_memory_report_type, s.str().c_str());
+      if (m_fd >= 0)
+        ::close(m_fd);
+      m_fd = -1;
+      return;
+    }
+  } else {
+    base = ::mmap(0, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED)
+      return; // allocate the pages on the heap
+  }
+  m_base = static_cast<unsigned char*>(base);
+#else
+  if (file) {
+    std::stringstream s;
+    s << name() << ": file backed memory not supported, ignoring '"
+      << file << "'";
+    SC_REPORT_WARNING(sparse_memory_report_type, s.str().c_str());
+  }
+#endif
+}
+
+void
+sparse_memory::unmap()
+{
+#if defined(TLM_UTILS_SPARSE_MEMORY_MMAP_)
+  if (m_base)
+    ::munmap(m_base, static_cast<std::size_t>(m_size));
+  if (m_fd >= 0)
+    ::close(m_fd);
+  m_base = 0;
+  m_fd = -1;
+#endif
+}
+
+void
+sparse_memory::flush()
+{
+#if defined(TLM_UTILS_SPARSE_MEMORY_MMAP_)
+  if (m_fd >= 0
+      && ::msync(m_base, static_cast<std::size_t>(m_size), MS_SYNC) != 0) {
+    std::stringstream s;
+    s << name() << ": cannot write to file '" << m_file << "'";
+    SC_REPORT_ERROR(sparse_memory_report_type, s.str().c_str());
+  }
+#endif
+}
+
+unsigned char*
+sparse_memory::find_page(sc_dt::uint64 addr) const
+{
+  sc_dt::uint64 page = addr >> m_page_bits;
+  unsigned char** chunk =
+    m_page_table[static_cast<std::size_t>(page / chunk_pages)];
+  return chunk ? chunk[page % chunk_pages] : 0;
+}
+
+unsigned char*
+sparse_memory::touch_page(sc_dt::uint64 addr)
+{
+  sc_dt::uint64 page = addr >> m_page_bits;
+  unsigned char**& chunk =
+    m_page_table[static_cast<std::size_t>(page / chunk_pages)];
+  if (!chunk)
+    chunk = new unsigned char*[chunk_pages]();
+
+  unsigned char*& p = chunk[page % chunk_pages];
+  if (!p) {
+    if (m_base)
+      p = m_base + (page << m_page_bits);
+    else
+      p = new unsigned char[m_page_size](); // zero-initialized
+    ++m_touched;
+  }
+  return p;
+}
+
+unsigned int
+sparse_memory::read(sc_dt::uint64 addr, unsigned char* data,
+                    unsigned int len) const
+{
+  if (addr >= m_size)
+    return 0;
+  if (len > m_size - addr)
+    len = static_cast<unsigned int>(m_size - addr);
+
+  if (m_base) { // untouched pages read as mapped
+    std::memcpy(data, m_base + addr, len);
+    return len;
+  }
+
+  unsigned int done = 0;
+  while (done < len) {
+    unsigned int offset = static_cast<unsigned int>(addr & (m_page_size - 1));
+    unsigned int n = m_page_size - offset;
+    if (n > len - done)
+      n = len - done;
+    const unsigned char* page = find_page(addr);
+    if (page)
+      std::memcpy(data + done, page + offset, n);
+    else
+      std::memset(data + done, 0, n);
+    addr += n;
+    done += n;
+  }
+  return len;
+}
+
+unsigned int
+sparse_memory::write(sc_dt::uint64 addr, const unsigned char* data,
+                     unsigned int len)
+{
+  if (addr >= m_size)
+    return 0;
+  if (len > m_size - addr)
+    len = static_cast<unsigned int>(m_size - addr);
+
+  unsigned int done = 0;
+  while (done < len) {
+    unsigned int offset = static_cast<unsigned int>(addr & (m_page_size - 1));
+    unsigned int n = m_page_size - offset;
+    if (n > len - done)
+      n = len - done;
+    std::memcpy(touch_page(addr) + offset, data + done, n);
+    addr += n;
+    done += n;
+  }
+  return len;
+}
+
+bool
+sparse_memory::access(tlm::tlm_generic_payload& trans)
+{
+  tlm::tlm_command cmd = trans.get_command();
+  sc_dt::uint64 addr = trans.get_address();
+  unsigned char* data = trans.get_data_ptr();
+  unsigned int len = trans.get_data_length();
+  unsigned char* be = trans.get_byte_enable_ptr();
+  unsigned int be_len = trans.get_byte_enable_length();
+  unsigned int width = trans.get_streaming_width();
+  if (width == 0 || width > len)
+    width = len;
+
+  if (addr >= m_size || width > m_size - addr) {
+    trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+    return false;
+  }
+  if (be && be_len == 0) {
+    trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+    return false;
+  }
+
+  if (cmd == tlm::TLM_IGNORE_COMMAND) {
+    // nothing to do
+  } else if (!be && width == len) {
+    if (cmd == tlm::TLM_READ_COMMAND)
+      read(addr, data, len);
+    else
+      write(addr, data, len);
+  } else {
+    for (unsigned int i = 0; i < len; ++i) {
+      if (be && be[i % be_len] != TLM_BYTE_ENABLED)
+        continue;
+      if (cmd == tlm::TLM_READ_COMMAND)
+        read(addr + i % width, data + i, 1);
+      else
+        write(addr + i % width, data + i, 1);
+    }
+  }
+  trans.set_response_status(tlm::TLM_OK_RESPONSE);
+  return true;
+}
+
+void
+sparse_memory::b_transport(tlm::tlm_generic_payload& trans,
+                           sc_core::sc_time& delay)
+{
+  if (access(trans)) {
+    delay += trans.is_read() ? m_read_latency : m_write_latency;
+    trans.set_dmi_allowed(true);
+  }
+}
+
+unsigned int
+sparse_memory::transport_dbg(tlm::tlm_generic_payload& trans)
+{
+  sc_dt::uint64 addr = trans.get_address();
+  unsigned char* data = trans.get_data_ptr();
+  unsigned int len = trans.get_data_length();
+
+  switch (trans.get_command()) {
+  case tlm::TLM_READ_COMMAND:
+    return read(addr, data, len);
+  case tlm::TLM_WRITE_COMMAND:
+    return write(addr, data, len);
+  default:
+    return 0;
+  }
+}
+
+// DMI is granted for the page containing the address, which is touched
+
+bool
+sparse_memory::get_direct_mem_ptr(tlm::tlm_generic_payload& trans,
+                                  tlm::tlm_dmi& dmi)
+{
+  sc_dt::uint64 addr = trans.get_address();
+  if (addr >= m_size) {
+    dmi.set_start_address(m_size);
+    return false;
+  }
+
+  sc_dt::uint64 start = addr & ~static_cast<sc_dt::uint64>(m_page_size - 1);
+  sc_dt::uint64 end = start + m_page_size - 1;
+  if (end >= m_size)
+    end = m_size - 1;
+
+  dmi.set_dmi_ptr(touch_page(addr));
+  dmi.set_start_address(start);
+  dmi.set_end_address(end);
+  dmi.set_read_latency(m_read_latency);
+  dmi.set_write_latency(m_write_latency);
+  dmi.allow_read_write();
+  return true;
+}
+
+} // namespace tlm_utils
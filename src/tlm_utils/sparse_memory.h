@@ -0,0 +1,131 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+#ifndef TLM_UTILS_SPARSE_MEMORY_H_INCLUDED_
+#define TLM_UTILS_SPARSE_MEMORY_H_INCLUDED_
+
+#include "tlm_utils/simple_target_socket.h"
+
+#include <string>
+#include <vector>
+
+namespace tlm_utils {
+
+//
+// sparse_memory class
+//
+// A memory target whose storage is allocated page by page, when a page is
+// first written or granted for direct memory access. Reading a page which
+// has not been written returns zeros. Startup time and memory use thus
+// depend on the memory touched, not on the size of the memory, which can
+// exceed the memory of the host.
+//
+// On POSIX hosts, the storage is a single mapping of the whole memory,
+// reserved without allocating it. If a file name is given, the file is
+// mapped instead: the memory starts with the contents of the file, and
+// writes to the memory are written to the file, which may serve as a
+// snapshot. Elsewhere, or if the mapping fails, the pages are allocated
+// one at a time on the heap.
+//
+// DMI is granted for the page containing the requested address. Byte
+// enables and streaming widths are supported. Addresses are relative to
+// the start of the memory.
+//
+class SC_API sparse_memory : public sc_core::sc_module
+{
+public:
+  simple_target_socket<sparse_memory> socket;
+
+  //
+  // size and page_size in bytes, page_size must be a power of two
+  //
+  sparse_memory(const sc_core::sc_module_name& name,
+                sc_dt::uint64 size,
+                const char* file = 0,
+                unsigned int page_size = 64 * 1024);
+  ~sparse_memory();
+
+  virtual const char* kind() const { return "tlm_utils::sparse_memory"; }
+
+  sc_dt::uint64 size() const { return m_size; }
+  unsigned int page_size() const { return m_page_size; }
+
+  // true, if the storage is a single mapping of the memory
+  bool is_mapped() const { return m_base != 0; }
+
+  // the number of pages written or granted for DMI
+  sc_dt::uint64 touched_pages() const { return m_touched; }
+
+  //
+  // Latencies of a transaction and of accesses through DMI
+  //
+  void set_read_latency(const sc_core::sc_time& t) { m_read_latency = t; }
+  void set_write_latency(const sc_core::sc_time& t) { m_write_latency = t; }
+  const sc_core::sc_time& get_read_latency() const { return m_read_latency; }
+  const sc_core::sc_time& get_write_latency() const { return m_write_latency; }
+
+  //
+  // Write the contents of a file backed memory to the file
+  //
+  void flush();
+
+  //
+  // Access the memory without a transaction, return the number of bytes
+  // accessed
+  //
+  unsigned int read(sc_dt::uint64 addr, unsigned char* data,
+                    unsigned int len) const;
+  unsigned int write(sc_dt::uint64 addr, const unsigned char* data,
+                     unsigned int len);
+
+private:
+  void b_transport(tlm::tlm_generic_payload& trans, sc_core::sc_time& delay);
+  unsigned int transport_dbg(tlm::tlm_generic_payload& trans);
+  bool get_direct_mem_ptr(tlm::tlm_generic_payload& trans,
+                          tlm::tlm_dmi& dmi);
+
+  // access the memory as given by the transaction, return false on errors
+  bool access(tlm::tlm_generic_payload& trans);
+
+  // the page at the address, or 0 if not touched
+  unsigned char* find_page(sc_dt::uint64 addr) const;
+  // the page at the address, touched if needed
+  unsigned char* touch_page(sc_dt::uint64 addr);
+
+  void map(const char* file);
+  void unmap();
+
+private:
+  // pages per entry of the page table
+  static const unsigned int chunk_pages = 1024;
+
+  sc_dt::uint64                 m_size;
+  unsigned int                  m_page_size;
+  unsigned int                  m_page_bits;
+  std::vector<unsigned char**>  m_page_table; // chunks of pages (or 0).
+  sc_dt::uint64                 m_touched;
+  unsigned char*                m_base;       // the mapping (or 0).
+  int                           m_fd;         // the mapped file (or -1).
+  std::string                   m_file;
+  sc_core::sc_time              m_read_latency;
+  sc_core::sc_time              m_write_latency;
+};
+
+} // namespace tlm_utils
+
+#endif // TLM_UTILS_SPARSE_MEMORY_H_INCLUDED_
@@ -0,0 +1,133 @@
+/*****************************************************************************
+
+  Licensed to Accellera Systems Initiative Inc. (Accellera) under one or
+  more contributor license agreements.  See the NOTICE file distributed
+  with this work for additional information regarding copyright ownership.
+  Accellera licenses this file to you under the Apache License, Version 2.0
+  (the "License"); you may not use this file except in compliance with the
+  License.  You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or
+  implied.  See the License for the specific language governing
+  permissions and limitations under the License.
+
+ *****************************************************************************/
+#ifndef TLM_UTILS_TIME_ORDERED_HEAP_H_INCLUDED_
+#define TLM_UTILS_TIME_ORDERED_HEAP_H_INCLUDED_
+
+#include <systemc>
+#include <vector>
+
+namespace tlm_utils {
+
+//
+// time_ordered_heap class
+//
+// A priority queue of payloads, ordered by time. Payloads with equal times
+// are kept in the order of insertion. Unlike a list, inserting and deleting
+// a payload take logarithmic time, and the entries are stored by value in a
+// single array, which is reused once it has grown to the largest number of
+// pending payloads. The heap has four children per node, so that the
+// children compared when deleting the top are close to each other in memory.
+//
+template <typename PAYLOAD>
+class time_ordered_heap
+{
+  struct element
+  {
+    sc_core::sc_time t;
+    sc_dt::uint64    seq;  // order of insertion, for equal times
+    PAYLOAD          p;
+
+    element(const PAYLOAD& p, const sc_core::sc_time& t, sc_dt::uint64 seq)
+      : t(t), seq(seq), p(p) {}
+
+    bool operator<(const element& e) const
+      { return t < e.t || (t == e.t && seq < e.seq); }
+  };
+
+  static const std::size_t arity = 4;
+
+public:
+  time_ordered_heap() : m_heap(), m_seq(0) {}
+
+  // remove all entries, keep the storage
+  void reset()
+  {
+    m_heap.clear();
+    m_seq = 0;
+  }
+
+  void insert(const PAYLOAD& p, const sc_core::sc_time& t)
+  {
+    element e(p, t, m_seq++);
+    std::size_t i = m_heap.size();
+    m_heap.push_back(e);
+    while (i > 0) {
+      std::size_t parent = (i - 1) / arity;
+      if (!(e < m_heap[parent]))
+        break;
+      m_heap[i] = m_heap[parent];
+      i = parent;
+    }
+    m_heap[i] = e;
+  }
+
+  void delete_top()
+  {
+    if (m_heap.empty())
+      return;
+    const element e = m_heap.back();
+    m_heap.pop_back();
+
+    const std::size_t n = m_heap.size();
+    if (n == 0)
+      return;
+
+    std::size_t i = 0;
+    for (;;) {
+      std::size_t first = i * arity + 1;
+      if (first >= n)
+        break;
+      std::size_t last = (n - first > arity) ? first + arity : n;
+      std::size_t least = first;
+      for (std::size_t c = first + 1; c < last; ++c) {
+        if (m_heap[c] < m_heap[least])
+          least = c;
+      }
+      if (!(m_heap[least] < e))
+        break;
+      m_heap[i] = m_heap[least];
+      i = least;
+    }
+    m_heap[i] = e;
+  }
+
+  unsigned int get_size() const
+  {
+    return static_cast<unsigned int>(m_heap.size());
+  }
+
+  // the earliest entry, the heap must not be empty
+  PAYLOAD& top()
+  {
+    return m_heap.front().p;
+  }
+
+  const sc_core::sc_time& top_time() const
+  {
+    return m_heap.front().t;
+  }
+
+private:
+  std::vector<element> m_heap;
+  sc_dt::uint64        m_seq;
+};
+
+} // namespace tlm_utils
+
+#endif // TLM_UTILS_TIME_ORDERED_HEAP_H_INCLUDED_